@@ -5,7 +5,7 @@
 
 #include <bout/physicsmodel.hxx>
 
-#include <bout/expr.hxx>
+#include <bout/field_expr.hxx>
 
 #include <chrono>
 
@@ -70,7 +70,7 @@ protected:
              });
 
       // Template expressions
-      TIMEIT(elapsed3, result3 = eval3D(add(mul(2, a), mul(b, c))););
+      TIMEIT(elapsed3, result3 = 2. * bout::expr::lazy(a) + bout::expr::lazy(b) * c;);
 
       // Range iterator
       result4.allocate();
@@ -5,7 +5,7 @@
 
 #include <bout/physicsmodel.hxx>
 
-#include <bout/expr.hxx>
+#include <bout/field_expr.hxx>
 
 #include <chrono>
 #include <iomanip>
@@ -73,7 +73,7 @@ protected:
 
       // Template expressions
       result3.allocate();
-      TIMEIT("Templates", result3 = eval3D(add(mul(2, a), mul(b, c))););
+      TIMEIT("Templates", result3 = 2. * bout::expr::lazy(a) + bout::expr::lazy(b) * c;);
 
       // Range iterator
       result4.allocate();
@@ -89,18 +89,19 @@ int main(int argc, char **argv) {
 
 #endif
 
+  const auto noy = Mesh::getRegionID("RGN_NOY");
   {
     auto deriv = DerivativeStore<Field3D>::getInstance().getStandardDerivative("C2",DIRECTION::Y, STAGGER::None);
     ITERATOR_TEST_BLOCK(
 			"DerivativeStore without fetching",
-			deriv(a, result, "RGN_NOY");
+			deriv(a, result, noy);
 			);
   };
   
   ITERATOR_TEST_BLOCK(
 		      "DerivativeStore with fetch",
 		      auto deriv = DerivativeStore<Field3D>::getInstance().getStandardDerivative("C2",DIRECTION::Y, STAGGER::None);    
-		      deriv(a, result, "RGN_NOY");
+		      deriv(a, result, noy);
 		      );
 
   ITERATOR_TEST_BLOCK(
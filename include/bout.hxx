@@ -162,6 +162,14 @@ void setRunStartInfo(Options& options);
 /// options
 void setRunFinishInfo(Options& options);
 
+/// Configure the Array memory store from the `memory` section of
+/// \p options
+void setupArrayStore(Options& options);
+
+/// Write the memory use of the BoutReal, dcomplex and float Array stores
+/// to output_info, for each block size and each thread
+void printArrayStoreStatistics();
+
 /// Write \p options to \p settings_file in directory \p data_dir
 void writeSettingsFile(Options& options, const std::string& data_dir,
                        const std::string& settings_file);
@@ -26,9 +26,15 @@
 #define __ARRAY_H__
 
 #include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <map>
 #include <vector>
 #include <memory>
+#include <new>
+#include <type_traits>
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -36,6 +42,7 @@
 
 #include <bout/assert.hxx>
 #include <bout/openmpwrap.hxx>
+#include <bout/region.hxx>
 
 namespace {
 template <typename T>
@@ -44,14 +51,74 @@ template <typename T>
 using const_iterator = const T*;
 }
 
+/*!
+ * Call \p func(start, end) for each block of MAXREGIONBLOCKSIZE
+ * elements in [0, \p len), split between threads in the same way as
+ * BOUT_FOR splits a contiguous region, with the same OpenMP
+ * schedule. Inside a parallel region all the blocks belong to the
+ * calling thread, so are done serially
+ */
+template <typename F>
+void forFirstTouchBlocks(int len, F func) {
+  const int nblocks = (len + MAXREGIONBLOCKSIZE - 1) / MAXREGIONBLOCKSIZE;
+#ifdef _OPENMP
+  if (!omp_in_parallel()) {
+    BOUT_OMP(parallel for schedule(OPENMP_SCHEDULE))
+    for (int i = 0; i < nblocks; ++i) {
+      func(i * MAXREGIONBLOCKSIZE, std::min(len, (i + 1) * MAXREGIONBLOCKSIZE));
+    }
+    return;
+  }
+#endif
+  for (int i = 0; i < nblocks; ++i) {
+    func(i * MAXREGIONBLOCKSIZE, std::min(len, (i + 1) * MAXREGIONBLOCKSIZE));
+  }
+}
+
 /*!
  * ArrayData holds the actual data
  * Handles the allocation and deletion of data
+ *
+ * The data starts on an #alignment byte boundary, so that loops over
+ * it can use aligned vector loads and don't straddle cache lines
  */
 template <typename T>
 struct ArrayData {
-  ArrayData(int size) : len(size) { data = new T[len]; }
-  ~ArrayData() { delete[] data; }
+  /// Alignment in bytes of the start of the data: a cache line on
+  /// most current CPUs, and the width of AVX-512 registers
+  static constexpr std::size_t alignment = 64;
+  static_assert(alignment % alignof(T) == 0, "ArrayData alignment too small for T");
+
+  /// If \p first_touch is true, the elements are value-initialised
+  /// in parallel (see forFirstTouchBlocks), so that on NUMA systems
+  /// each page is placed near the thread which will use it. This
+  /// includes types such as std::complex whose constructors write to
+  /// the memory, which would otherwise place all the pages serially
+  ArrayData(int size, bool first_touch = false) : len(size) {
+    // Over-allocate, so the start can be moved to an aligned address
+    storage = static_cast<char*>(::operator new(len * sizeof(T) + alignment));
+    const auto address = reinterpret_cast<std::uintptr_t>(storage);
+    data = reinterpret_cast<T*>(storage + alignment - address % alignment);
+    if (first_touch) {
+      T* const start = data;
+      forFirstTouchBlocks(len, [start](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+          new (start + i) T{};
+        }
+      });
+    } else {
+      for (int i = 0; i < len; ++i) {
+        new (data + i) T;
+      }
+    }
+  }
+  ~ArrayData() {
+    for (int i = 0; i < len; ++i) {
+      data[i].~T();
+    }
+    ::operator delete(storage);
+  }
+  ArrayData(const ArrayData&) = delete;
   iterator<T> begin() const { return data; }
   iterator<T> end() const { return data + len; }
   int size() const { return len; }
@@ -60,6 +127,7 @@ struct ArrayData {
 private:
   int len; ///< Size of the array
   T* data; ///< Array of data  
+  char* storage; ///< Allocated memory, containing data
 };
 
 /*!
@@ -96,6 +164,18 @@ public:
   using data_type = T;
   using backing_type = Backing;
   using size_type = int;
+
+  /*!
+   * Usage statistics for the blocks of one size in one thread's store
+   */
+  struct StoreStats {
+    std::size_t cached{0}; ///< Blocks currently held in the store
+    std::size_t hits{0};   ///< Requests satisfied by a block from the store
+    std::size_t misses{0}; ///< Requests which allocated a new block
+    std::size_t freed{0};  ///< Blocks deleted rather than put into the store
+  };
+  /// Statistics for each block size in one thread's store
+  using StoreStatsMap = std::map<size_type, StoreStats>;
     
   /*!
    * Create an empty array
@@ -174,6 +254,19 @@ public:
     return value;
   }
   
+  /*!
+   * Controls whether new memory blocks are "first touched" in
+   * parallel when they are allocated. On NUMA systems the operating
+   * system places each page of memory close to the thread which
+   * first writes to it, so this puts the data near the threads which
+   * will later loop over it with BOUT_FOR. Blocks taken from the store
+   * keep their existing placement.
+   *
+   * Off by default. Has no effect without OpenMP
+   */
+  static bool firstTouch() noexcept { return firstTouchFlag(); }
+  static void setFirstTouch(bool first_touch) noexcept { firstTouchFlag() = first_touch; }
+
   /*!
    * Release data. After this the Array is empty and any data access
    * will be invalid
@@ -195,6 +288,72 @@ public:
     useStore(false);
   }
 
+  /*!
+   * Statistics for each thread's store, indexed by thread number.
+   * The number of blocks of a given size still in use is the sum
+   * over threads of (misses - freed - cached).
+   *
+   * Should not be called inside a parallel region
+   */
+  static std::vector<StoreStatsMap> storeStatistics() {
+    std::vector<StoreStatsMap> result;
+    for (const auto& thread_store : arena()) {
+      StoreStatsMap thread_stats;
+      for (const auto& entry : thread_store) {
+        auto stats = entry.second.stats;
+        stats.cached = entry.second.blocks.size();
+        thread_stats[entry.first] = stats;
+      }
+      result.push_back(std::move(thread_stats));
+    }
+    return result;
+  }
+
+  /// Bytes in all blocks currently allocated, whether in use or in the store
+  static std::size_t allocatedBytes() noexcept { return counters().allocated; }
+  /// The highest value allocatedBytes() has reached
+  static std::size_t peakAllocatedBytes() noexcept { return counters().peak; }
+  /// Bytes in blocks held in the store, waiting to be reused
+  static std::size_t cachedBytes() noexcept { return counters().cached; }
+  /// Blocks deleted while the store was disabled, for example after
+  /// cleanup(). These are not in storeStatistics
+  static std::size_t unstoredFrees() noexcept { return counters().unstored_frees; }
+
+  /*!
+   * Limit the memory held in the store to \p max_bytes. Once the
+   * limit is reached, released blocks are deleted rather than
+   * stored. This does not remove blocks already in the store, for
+   * which see trimStore. Unlimited by default
+   */
+  static void setStoreLimit(std::size_t max_bytes) noexcept {
+    counters().limit = max_bytes;
+  }
+  static std::size_t storeLimit() noexcept { return counters().limit; }
+
+  /*!
+   * Delete blocks from the store, largest first, until at most
+   * \p max_bytes remain. Returns the number of bytes freed.
+   *
+   * Should not be called inside a parallel region
+   */
+  static std::size_t trimStore(std::size_t max_bytes = 0) {
+    std::size_t freed_bytes = 0;
+    for (auto& thread_store : arena()) {
+      for (auto it = thread_store.rbegin(); it != thread_store.rend(); ++it) {
+        auto& entry = it->second;
+        while (!entry.blocks.empty() && counters().cached > max_bytes) {
+          entry.blocks.pop_back();
+          ++entry.stats.freed;
+          const std::size_t bytes = blockBytes(it->first);
+          counters().cached -= bytes;
+          counters().allocated -= bytes;
+          freed_bytes += bytes;
+        }
+      }
+    }
+    return freed_bytes;
+  }
+
   /*!
    * Returns true if the Array is empty
    */
@@ -294,9 +453,43 @@ private:
    */
   dataPtrType ptr;
 
-  using storeType = std::map<size_type, std::vector<dataPtrType>>;
+  /// The blocks of one size held in a thread's store
+  struct StoreEntry {
+    std::vector<dataPtrType> blocks;
+    StoreStats stats;
+  };
+
+  using storeType = std::map<size_type, StoreEntry>;
   using arenaType = std::vector<storeType>;
 
+  /// Memory use, shared between all threads
+  struct StoreCounters {
+    std::atomic<std::size_t> allocated{0};
+    std::atomic<std::size_t> peak{0};
+    std::atomic<std::size_t> cached{0};
+    std::atomic<std::size_t> limit{std::numeric_limits<std::size_t>::max()};
+    std::atomic<std::size_t> unstored_frees{0};
+  };
+
+  static StoreCounters& counters() noexcept {
+    static StoreCounters value;
+    return value;
+  }
+
+  static std::size_t blockBytes(size_type len) noexcept {
+    return static_cast<std::size_t>(len) * sizeof(T);
+  }
+
+  /// One store per thread
+  static arenaType& arena() {
+#ifdef _OPENMP
+    static arenaType value(omp_get_max_threads());
+#else
+    static arenaType value(1);
+#endif
+    return value;
+  }
+
   /*!
    * This maps from array size (size_type) to vectors of pointers to dataBlock objects
    *
@@ -309,12 +502,8 @@ private:
    * @param[in] cleanup   If set to true, deletes all dataBlock and clears the store
    */
   static storeType& store(bool cleanup=false) {
-#ifdef _OPENMP    
-    static arenaType arena(omp_get_max_threads());
-#else
-    static arenaType arena(1);
-#endif
-    
+    auto& arena = Array::arena();
+
     if (!cleanup) {
 #ifdef _OPENMP 
       return arena[omp_get_thread_num()];
@@ -329,14 +518,16 @@ private:
     {
       for (auto &stores : arena) {
         for (auto &p : stores) {
-          auto &v = p.second;
+          auto &v = p.second.blocks;
           for (dataPtrType a : v) {
             a.reset();
           }
+          counters().allocated -= v.size() * blockBytes(p.first);
           v.clear();
         }
         stores.clear();
       }
+      counters().cached = 0;
       // Here we ensure there is exactly one empty map still
       // left in the arena as we have to return one such item
       arena.resize(1);
@@ -358,22 +549,74 @@ private:
 
     dataPtrType p;
 
-    auto& st = store()[len];
+    auto& entry = store()[len];
+    auto& st = entry.blocks;
     
     if (!st.empty()) {
       p = st.back();
       st.pop_back();
+      ++entry.stats.hits;
+      counters().cached -= blockBytes(len);
     } else {
       // Ensure that when we release the data block later we'll have
       // enough space to put it in the store so that `release` can be
       // noexcept
       st.reserve(1);
-      p = std::make_shared<dataBlock>(len);
+      p = newBlock(len, std::is_same<Backing, ArrayData<T>>{});
+      ++entry.stats.misses;
+      addAllocated(blockBytes(len));
     }
 
     return p;
   }
 
+  /// Record a new allocation, updating the high-water mark
+  static void addAllocated(std::size_t bytes) noexcept {
+    auto& c = counters();
+    const std::size_t now = c.allocated += bytes;
+    std::size_t peak = c.peak;
+    while (now > peak && !c.peak.compare_exchange_weak(peak, now)) {
+    }
+  }
+
+  /// Add \p bytes to the cached bytes, unless that would go over the
+  /// store limit. Returns true if they were added. A single
+  /// compare-exchange, so that concurrent releases can't between them
+  /// go over the limit
+  static bool reserveCached(std::size_t bytes) noexcept {
+    auto& c = counters();
+    const std::size_t limit = c.limit;
+    std::size_t cached = c.cached;
+    do {
+      if (bytes > limit || cached > limit - bytes) {
+        return false;
+      }
+    } while (!c.cached.compare_exchange_weak(cached, cached + bytes));
+    return true;
+  }
+
+  static bool& firstTouchFlag() noexcept {
+    static bool value = false;
+    return value;
+  }
+
+  /// Allocate a new ArrayData, which places its pages itself
+  static dataPtrType newBlock(size_type len, std::true_type) {
+    return std::make_shared<dataBlock>(len, firstTouch());
+  }
+  /// Allocate a new block of another backing type, then write to
+  /// every element in parallel if first touch is on
+  static dataPtrType newBlock(size_type len, std::false_type) {
+    auto p = std::make_shared<dataBlock>(len);
+    if (firstTouch()) {
+      auto data = std::begin(*p);
+      forFirstTouchBlocks(len, [data](int begin, int end) {
+        std::fill(data + begin, data + end, T{});
+      });
+    }
+    return p;
+  }
+
   /*!
    * Release an dataBlock object, reducing its reference count by one.
    * If no more references, then put back into the store.
@@ -392,10 +635,22 @@ private:
 
     // Reduce reference count, and if zero return to store
     if (d.use_count() == 1) {
+      const std::size_t bytes = blockBytes(d->size());
       if (useStore()) {
-        // Put back into store
-        store()[d->size()].push_back(std::move(d));
-        // Could return here but seems to slow things down a lot
+        auto& entry = store()[d->size()];
+        if (reserveCached(bytes)) {
+          // Put back into store
+          entry.blocks.push_back(std::move(d));
+          // Could return here but seems to slow things down a lot
+        } else {
+          // Over the limit: deleted below
+          ++entry.stats.freed;
+          counters().allocated -= bytes;
+        }
+      } else {
+        // The store may have been cleaned up, so don't touch it
+        ++counters().unstored_frees;
+        counters().allocated -= bytes;
       }
     }
 
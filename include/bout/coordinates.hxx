@@ -260,6 +260,21 @@ private:
   /// Handles calculation of yup and ydown
   std::unique_ptr<ParallelTransform> transform{nullptr};
 
+  /// Tridiagonal coefficients used by the FFT Delp2, indexed by [y][x][kz].
+  /// Calculated on first use, and reset by geometry()
+  Tensor<dcomplex> delp2_a, delp2_b, delp2_c;
+
+  /// Fill delp2_a, delp2_b and delp2_c if they are not already set
+  void calcDelp2Coefficients();
+
+  /// Are the default first and second derivatives in X and Z of a
+  /// Field3D all second order central differences?
+  static bool defaultDerivativesAreC2();
+
+  /// Can the non-FFT Delp2 be done in a single pass? Looked up in the
+  /// derivative store once, and again by geometry()
+  bool delp2_single_pass{defaultDerivativesAreC2()};
+
   /// Set the parallel (y) transform from the options file.
   /// Used in the constructor to create the transform object.
   void setParallelTransform(Options* options);
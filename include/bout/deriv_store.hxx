@@ -29,11 +29,13 @@
 #ifndef __DERIV_STORE_HXX__
 #define __DERIV_STORE_HXX__
 
+#include <array>
 #include <functional>
 #include <map>
 #include <set>
 #include <unordered_map>
 
+#include <bout/region.hxx>
 #include <bout/scorepwrapper.hxx>
 
 #include <bout_types.hxx>
@@ -50,9 +52,9 @@
 /// upwind and flux).
 template <typename FieldType>
 struct DerivativeStore {
-  using standardFunc = std::function<void(const FieldType&, FieldType&, const std::string&)>;
+  using standardFunc = std::function<void(const FieldType&, FieldType&, RegionID)>;
   using flowFunc =
-      std::function<void(const FieldType&, const FieldType&, FieldType&, const std::string&)>;
+      std::function<void(const FieldType&, const FieldType&, FieldType&, RegionID)>;
   using upwindFunc = flowFunc;
   using fluxFunc = flowFunc;
 
@@ -174,6 +176,7 @@ struct DerivativeStore {
     registeredMethods[getKey(direction, stagger, toString(derivType))].insert(
         methodName);
 
+    resolveDefault(direction, stagger, derivType);
   };
 
   /// Register a function with upwindFunc/fluxFunc interface. Which map is used
@@ -211,6 +214,8 @@ struct DerivativeStore {
     // Register this method name in lookup of known methods
     registeredMethods[getKey(direction, stagger, toString(derivType))].insert(
         methodName);
+
+    resolveDefault(direction, stagger, derivType);
   };
 
   /// Templated versions of the above registration routines.
@@ -234,9 +239,21 @@ struct DerivativeStore {
   /// have different return types. As such we choose to use a
   /// different name for each of the method-classes so everything is
   /// consistently treated
-  standardFunc getStandardDerivative(std::string name, DIRECTION direction,
-                                     STAGGER stagger = STAGGER::None,
-                                     DERIV derivType = DERIV::Standard) const {
+  ///
+  /// The returned references stay valid until the store is cleared.
+  /// The default method for each direction, stagger and type is
+  /// resolved in advance, so asking for "DEFAULT" is an array lookup
+  const standardFunc& getStandardDerivative(const std::string& name,
+                                            DIRECTION direction,
+                                            STAGGER stagger = STAGGER::None,
+                                            DERIV derivType = DERIV::Standard) const {
+    if (name == defaultMethodName()) {
+      const auto index = getDefaultIndex(direction, stagger, derivType);
+      const auto* resolved = defaultStandard[index];
+      if (resolved != nullptr) {
+        return *resolved;
+      }
+    }
 
     AUTO_TRACE();
     const auto realName = nameLookup(
@@ -267,21 +284,31 @@ struct DerivativeStore {
         toString(derivType).c_str());
   };
 
-  standardFunc getStandard2ndDerivative(std::string name, DIRECTION direction,
-                                        STAGGER stagger = STAGGER::None) const {
+  const standardFunc& getStandard2ndDerivative(const std::string& name,
+                                               DIRECTION direction,
+                                               STAGGER stagger = STAGGER::None) const {
     AUTO_TRACE();
     return getStandardDerivative(name, direction, stagger, DERIV::StandardSecond);
   };
 
-  standardFunc getStandard4thDerivative(std::string name, DIRECTION direction,
-                                        STAGGER stagger = STAGGER::None) const {
+  const standardFunc& getStandard4thDerivative(const std::string& name,
+                                               DIRECTION direction,
+                                               STAGGER stagger = STAGGER::None) const {
     AUTO_TRACE();
     return getStandardDerivative(name, direction, stagger, DERIV::StandardFourth);
   };
 
-  flowFunc getFlowDerivative(std::string name, DIRECTION direction,
-                             STAGGER stagger = STAGGER::None,
-                             DERIV derivType = DERIV::Upwind) const {
+  const flowFunc& getFlowDerivative(const std::string& name, DIRECTION direction,
+                                    STAGGER stagger = STAGGER::None,
+                                    DERIV derivType = DERIV::Upwind) const {
+    if (name == defaultMethodName()) {
+      const auto index = getDefaultIndex(direction, stagger, derivType);
+      const auto* resolved = defaultFlow[index];
+      if (resolved != nullptr) {
+        return *resolved;
+      }
+    }
+
     AUTO_TRACE();
     const auto realName = nameLookup(
         name, defaultMethods.at(getKey(direction, stagger, toString(derivType))));
@@ -309,14 +336,14 @@ struct DerivativeStore {
         toString(derivType).c_str());
   }
 
-  upwindFunc getUpwindDerivative(std::string name, DIRECTION direction,
-                                 STAGGER stagger = STAGGER::None) const {
+  const upwindFunc& getUpwindDerivative(const std::string& name, DIRECTION direction,
+                                        STAGGER stagger = STAGGER::None) const {
     AUTO_TRACE();
     return getFlowDerivative(name, direction, stagger, DERIV::Upwind);
   };
 
-  fluxFunc getFluxDerivative(std::string name, DIRECTION direction,
-                             STAGGER stagger = STAGGER::None) const {
+  const fluxFunc& getFluxDerivative(const std::string& name, DIRECTION direction,
+                                    STAGGER stagger = STAGGER::None) const {
     AUTO_TRACE();
     return getFlowDerivative(name, direction, stagger, DERIV::Flux);
   };
@@ -403,6 +430,14 @@ struct DerivativeStore {
                        << toString(theDirection) << " is " << theDefault << "\n";
       }
     }
+
+    resolveDefaults();
+  }
+
+  /// Name of the default method for this derivative
+  std::string getDefaultMethod(DERIV deriv, DIRECTION direction,
+                               STAGGER stagger = STAGGER::None) const {
+    return defaultMethods.at(getKey(direction, stagger, toString(deriv)));
   }
 
   /// Provide a method to override/force a specific default method
@@ -410,6 +445,7 @@ struct DerivativeStore {
                           STAGGER stagger = STAGGER::None) {
     const auto key = getKey(direction, stagger, toString(deriv));
     defaultMethods[key] = uppercase(methodName);
+    resolveDefault(direction, stagger, deriv);
   }
 
   /// Empty all member storage
@@ -421,6 +457,8 @@ struct DerivativeStore {
     upwind.clear();
     flux.clear();
     registeredMethods.clear();
+    defaultStandard.fill(nullptr);
+    defaultFlow.fill(nullptr);
   }
 
   /// Reset to initial state
@@ -455,6 +493,85 @@ private:
   /// it might be useful to relax this assumption!
   storageType<std::size_t, std::string> defaultMethods;
 
+  /// The number of each of the enums used to index the resolved defaults
+  static constexpr std::size_t numDirections = 5;
+  static constexpr std::size_t numStaggers = 3;
+  static constexpr std::size_t numDerivTypes = 5;
+  static constexpr std::size_t numDefaults = numDirections * numStaggers * numDerivTypes;
+
+  /// The function to use for each DEFAULT derivative, indexed by
+  /// getDefaultIndex. These point into the maps above (whose elements
+  /// don't move when other elements are inserted), or are nullptr if
+  /// the default method hasn't been registered. They are updated
+  /// whenever a method is registered or a default method changes
+  std::array<const standardFunc*, numDefaults> defaultStandard{};
+  std::array<const flowFunc*, numDefaults> defaultFlow{};
+
+  static std::size_t getDefaultIndex(DIRECTION direction, STAGGER stagger,
+                                     DERIV derivType) {
+    return (static_cast<std::size_t>(derivType) * numStaggers
+            + static_cast<std::size_t>(stagger))
+               * numDirections
+           + static_cast<std::size_t>(direction);
+  }
+
+  static const std::string& defaultMethodName() {
+    static const std::string name = toString(DIFF_DEFAULT);
+    return name;
+  }
+
+  /// Find the function currently registered as the default method
+  /// for this direction, stagger and type of derivative
+  void resolveDefault(DIRECTION direction, STAGGER stagger, DERIV derivType) {
+    const auto index = getDefaultIndex(direction, stagger, derivType);
+    const auto method =
+        defaultMethods.find(getKey(direction, stagger, toString(derivType)));
+    if (method == defaultMethods.end()) {
+      defaultStandard[index] = nullptr;
+      defaultFlow[index] = nullptr;
+      return;
+    }
+    const auto key = getKey(direction, stagger, method->second);
+
+    switch (derivType) {
+    case (DERIV::Standard):
+      defaultStandard[index] = findOrNull(standard, key);
+      break;
+    case (DERIV::StandardSecond):
+      defaultStandard[index] = findOrNull(standardSecond, key);
+      break;
+    case (DERIV::StandardFourth):
+      defaultStandard[index] = findOrNull(standardFourth, key);
+      break;
+    case (DERIV::Upwind):
+      defaultFlow[index] = findOrNull(upwind, key);
+      break;
+    case (DERIV::Flux):
+      defaultFlow[index] = findOrNull(flux, key);
+      break;
+    }
+  }
+
+  /// Update all the resolved default methods
+  void resolveDefaults() {
+    for (auto direction : {DIRECTION::X, DIRECTION::Y, DIRECTION::Z, DIRECTION::YAligned,
+                           DIRECTION::YOrthogonal}) {
+      for (auto stagger : {STAGGER::None, STAGGER::C2L, STAGGER::L2C}) {
+        for (auto derivType : {DERIV::Standard, DERIV::StandardSecond,
+                               DERIV::StandardFourth, DERIV::Upwind, DERIV::Flux}) {
+          resolveDefault(direction, stagger, derivType);
+        }
+      }
+    }
+  }
+
+  template <typename Func>
+  static const Func* findOrNull(const storageType<std::size_t, Func>& theMap,
+                                std::size_t key) {
+    const auto resultOfFind = theMap.find(key);
+    return resultOfFind != theMap.end() ? &resultOfFind->second : nullptr;
+  }
+
   void setDefaults() {
     std::map<DERIV, std::string> initialDefaultMethods = {{DERIV::Standard, "C2"},
                                                           {DERIV::StandardSecond, "C2"},
@@ -492,6 +609,8 @@ private:
             theDefault;
       }
     }
+
+    resolveDefaults();
   };
 
   std::string getMethodName(std::string name, DIRECTION direction,
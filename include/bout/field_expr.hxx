@@ -0,0 +1,329 @@
+/// Lazily evaluated arithmetic on Field3D, Field2D and BoutReal
+///
+/// The arithmetic operators in generated_fieldops.cxx each allocate
+/// a new field and make one pass over memory, so an expression like
+/// `a*b + c*d - e/f` creates five temporaries. The expression
+/// templates here instead build up a tree describing the whole
+/// right-hand side, which is only evaluated when it is assigned to
+/// (or converted into) a field, in a single `BOUT_FOR` loop.
+///
+/// Expressions are started by wrapping a field with `lazy`. Any
+/// arithmetic involving an expression is itself an expression, so
+/// wrapping one operand of each product is enough to fuse the whole
+/// statement:
+///
+///     using bout::expr::lazy;
+///     ddt(n) = lazy(a) * b + lazy(c) * d - lazy(e) / f;
+///
+/// Field3D, Field2D and BoutReal can be mixed: the result is a
+/// Field3D if any field in the expression is a Field3D, and Field2D
+/// values are broadcast in Z. Expressions can be passed directly to
+/// functions taking `const Field3D&` or `const Field2D&`; use
+/// `evaluate` (or `eval()`) where a template needs a concrete field.
+///
+/// Expressions hold pointers to the data of the fields they were
+/// built from, so they must be evaluated before those fields are
+/// modified or go out of scope. In particular, don't store an
+/// expression in an `auto` variable.
+///
+/// Single precision Field3DF fields can be used with `lazy`, and are
+/// converted to BoutReal as they are read. FieldPerp is not supported.
+///
+/// The binary operators are generated by src/field/gen_fieldops.py,
+/// and are in bout/generated_fieldexpr.hxx
+
+#ifndef __FIELD_EXPR_H__
+#define __FIELD_EXPR_H__
+
+#include <type_traits>
+
+#include "bout/mesh.hxx"
+#include "bout/region.hxx"
+#include "field2d.hxx"
+#include "field3d.hxx"
+#include "field3d_float.hxx"
+
+namespace bout {
+namespace expr {
+
+/// Base class of all expression nodes. `E` is the node type itself
+template <typename E>
+struct Expr {
+  const E& self() const { return static_cast<const E&>(*this); }
+};
+
+/// The operations at each node of the tree
+struct Add {
+  static BoutReal apply(BoutReal lhs, BoutReal rhs) { return lhs + rhs; }
+};
+struct Subtract {
+  static BoutReal apply(BoutReal lhs, BoutReal rhs) { return lhs - rhs; }
+};
+struct Multiply {
+  static BoutReal apply(BoutReal lhs, BoutReal rhs) { return lhs * rhs; }
+};
+struct Divide {
+  static BoutReal apply(BoutReal lhs, BoutReal rhs) { return lhs / rhs; }
+};
+struct Negate {
+  static BoutReal apply(BoutReal value) { return -value; }
+};
+
+template <typename E>
+typename E::result_type evaluate(const Expr<E>& expr);
+
+/// Field3D if any field in the expression is a Field3D, otherwise Field2D
+template <bool has3D>
+using ResultType = typename std::conditional<has3D, Field3D, Field2D>::type;
+
+/// A Field3D or Field2D in an expression
+///
+/// Nodes are evaluated with `node(i3, i2)`, where `i3` is the index
+/// into Field3D data and `i2` the index into Field2D data at the same
+/// point.
+template <typename F>
+class FieldLeaf : public Expr<FieldLeaf<F>> {
+public:
+  static_assert(std::is_same<F, Field3D>::value || std::is_same<F, Field2D>::value,
+                "Only Field3D and Field2D can be used in expressions");
+
+  static constexpr bool has3D = std::is_same<F, Field3D>::value;
+  static constexpr bool has2D = !has3D;
+  using result_type = F;
+
+  explicit FieldLeaf(const F& field) : field(field), data(rawData(field)) {}
+
+  BoutReal operator()(int i3, int i2) const { return data[has3D ? i3 : i2]; }
+
+  /// Return the first field of type F in the expression, or nullptr.
+  /// The argument is only used to select the type
+  const F* find(const F*) const { return &field; }
+  template <typename T>
+  const T* find(const T*) const {
+    return nullptr;
+  }
+
+  /// Check that the field is compatible with \p reference
+  template <typename T>
+  void check(const T& reference) const {
+    ASSERT1(areFieldsCompatible(reference, field));
+    checkData(field);
+  }
+
+  result_type eval() const { return evaluate(*this); }
+
+private:
+  static const BoutReal* rawData(const Field3D& f) { return &f(0, 0, 0); }
+  static const BoutReal* rawData(const Field2D& f) { return &f(0, 0); }
+
+  const F& field;
+  const BoutReal* data;
+};
+
+/// A single precision Field3DF in an expression, read as BoutReal
+class FloatFieldLeaf : public Expr<FloatFieldLeaf> {
+public:
+  static constexpr bool has3D = true;
+  static constexpr bool has2D = false;
+  using result_type = Field3D;
+
+  explicit FloatFieldLeaf(const Field3DF& field) : field(field), data(field.begin()) {}
+
+  BoutReal operator()(int i3, int) const { return data[i3]; }
+
+  const Field3DF* find(const Field3DF*) const { return &field; }
+  template <typename T>
+  const T* find(const T*) const {
+    return nullptr;
+  }
+
+  template <typename T>
+  void check(const T& reference) const {
+    ASSERT1(areFieldsCompatible(reference, field));
+    ASSERT1(field.isAllocated());
+  }
+
+  result_type eval() const { return evaluate(*this); }
+
+private:
+  const Field3DF& field;
+  const float* data;
+};
+
+/// A BoutReal in an expression
+class Scalar : public Expr<Scalar> {
+public:
+  static constexpr bool has3D = false;
+  static constexpr bool has2D = false;
+
+  explicit Scalar(BoutReal value) : value(value) {}
+
+  BoutReal operator()(int, int) const { return value; }
+
+  template <typename T>
+  const T* find(const T*) const {
+    return nullptr;
+  }
+  template <typename T>
+  void check(const T&) const {}
+
+private:
+  BoutReal value;
+};
+
+/// Apply `Op` to the results of two expressions
+template <typename L, typename R, typename Op>
+class BinaryExpr : public Expr<BinaryExpr<L, R, Op>> {
+public:
+  static constexpr bool has3D = L::has3D || R::has3D;
+  static constexpr bool has2D = L::has2D || R::has2D;
+  using result_type = ResultType<has3D>;
+
+  BinaryExpr(const L& lhs, const R& rhs) : lhs(lhs), rhs(rhs) {}
+
+  BoutReal operator()(int i3, int i2) const {
+    return Op::apply(lhs(i3, i2), rhs(i3, i2));
+  }
+
+  template <typename T>
+  const T* find(const T* tag) const {
+    const T* result = lhs.find(tag);
+    return result != nullptr ? result : rhs.find(tag);
+  }
+  template <typename T>
+  void check(const T& reference) const {
+    lhs.check(reference);
+    rhs.check(reference);
+  }
+
+  result_type eval() const { return evaluate(*this); }
+  operator result_type() const { return eval(); }
+
+private:
+  L lhs;
+  R rhs;
+};
+
+/// Apply `Op` to the result of an expression
+template <typename E, typename Op>
+class UnaryExpr : public Expr<UnaryExpr<E, Op>> {
+public:
+  static constexpr bool has3D = E::has3D;
+  static constexpr bool has2D = E::has2D;
+  using result_type = ResultType<has3D>;
+
+  explicit UnaryExpr(const E& expr) : expr(expr) {}
+
+  BoutReal operator()(int i3, int i2) const { return Op::apply(expr(i3, i2)); }
+
+  template <typename T>
+  const T* find(const T* tag) const {
+    return expr.find(tag);
+  }
+  template <typename T>
+  void check(const T& reference) const {
+    expr.check(reference);
+  }
+
+  result_type eval() const { return evaluate(*this); }
+  operator result_type() const { return eval(); }
+
+private:
+  E expr;
+};
+
+/// Start an expression from a field
+inline FieldLeaf<Field3D> lazy(const Field3D& f) { return FieldLeaf<Field3D>(f); }
+inline FieldLeaf<Field2D> lazy(const Field2D& f) { return FieldLeaf<Field2D>(f); }
+inline FloatFieldLeaf lazy(const Field3DF& f) { return FloatFieldLeaf(f); }
+
+template <typename E>
+UnaryExpr<E, Negate> operator-(const Expr<E>& expr) {
+  return UnaryExpr<E, Negate>(expr.self());
+}
+
+namespace detail {
+/// Handle for the region expressions are evaluated over
+inline RegionID regionAll() {
+  static const RegionID region_all = Mesh::getRegionID("RGN_ALL");
+  return region_all;
+}
+
+template <typename E>
+void evaluateInto(const E& expr, Field3D& result) {
+  BoutReal* out = &result(0, 0, 0);
+  if (E::has2D) {
+    // Loop over the 2D points, so that Field2D values are only
+    // loaded once for each Z column
+    Mesh* localmesh = result.getMesh();
+    const int nz = localmesh->LocalNz;
+    BOUT_FOR(index, localmesh->getRegion2D(regionAll())) {
+      const int base_ind = localmesh->ind2Dto3D(index).ind;
+      for (int jz = 0; jz < nz; ++jz) {
+        out[base_ind + jz] = expr(base_ind + jz, index.ind);
+      }
+    }
+  } else {
+    BOUT_FOR(index, result.getRegion(regionAll())) {
+      out[index.ind] = expr(index.ind, index.ind);
+    }
+  }
+}
+
+/// An empty field for the result of \p expr, with the metadata of
+/// its first field of the result type. Expressions whose only 3D
+/// fields are Field3DF take the metadata from the first of those
+template <typename E>
+Field2D emptyResult(const E& expr, const Field2D*) {
+  const Field2D* reference = expr.find(static_cast<const Field2D*>(nullptr));
+  ASSERT1(reference != nullptr);
+  expr.check(*reference);
+  return emptyFrom(*reference);
+}
+
+template <typename E>
+Field3D emptyResult(const E& expr, const Field3D*) {
+  const Field3D* reference = expr.find(static_cast<const Field3D*>(nullptr));
+  if (reference != nullptr) {
+    expr.check(*reference);
+    return emptyFrom(*reference);
+  }
+  const Field3DF* float_reference = expr.find(static_cast<const Field3DF*>(nullptr));
+  ASSERT1(float_reference != nullptr);
+  expr.check(*float_reference);
+  return Field3D{float_reference->getMesh(), float_reference->getLocation(),
+                 float_reference->getDirections()}
+      .allocate();
+}
+
+template <typename E>
+void evaluateInto(const E& expr, Field2D& result) {
+  BoutReal* out = &result(0, 0);
+  BOUT_FOR(index, result.getRegion(regionAll())) {
+    out[index.ind] = expr(index.ind, index.ind);
+  }
+}
+} // namespace detail
+
+/// Evaluate an expression into a new field, in a single loop
+///
+/// The metadata (mesh, location, directions) of the result is taken
+/// from the first field in the expression of the result type
+template <typename E>
+typename E::result_type evaluate(const Expr<E>& expr) {
+  using Result = typename E::result_type;
+  const E& e = expr.self();
+
+  Result result = detail::emptyResult(e, static_cast<const Result*>(nullptr));
+  detail::evaluateInto(e, result);
+
+  checkData(result);
+  return result;
+}
+
+} // namespace expr
+} // namespace bout
+
+#include "bout/generated_fieldexpr.hxx"
+
+#endif // __FIELD_EXPR_H__
@@ -0,0 +1,210 @@
+// This file is autogenerated - see gen_fieldops.py
+// Binary operators for the lazy expressions in bout/field_expr.hxx,
+// which includes this file
+
+#ifndef __GENERATED_FIELDEXPR_H__
+#define __GENERATED_FIELDEXPR_H__
+
+namespace bout {
+namespace expr {
+
+/// Lazy multiplication of expression and expression
+template <typename L, typename R>
+inline BinaryExpr<L, R, Multiply>
+operator*(const Expr<L>& lhs, const Expr<R>& rhs) {
+  return {lhs.self(), rhs.self()};
+}
+
+/// Lazy division of expression and expression
+template <typename L, typename R>
+inline BinaryExpr<L, R, Divide>
+operator/(const Expr<L>& lhs, const Expr<R>& rhs) {
+  return {lhs.self(), rhs.self()};
+}
+
+/// Lazy addition of expression and expression
+template <typename L, typename R>
+inline BinaryExpr<L, R, Add>
+operator+(const Expr<L>& lhs, const Expr<R>& rhs) {
+  return {lhs.self(), rhs.self()};
+}
+
+/// Lazy subtraction of expression and expression
+template <typename L, typename R>
+inline BinaryExpr<L, R, Subtract>
+operator-(const Expr<L>& lhs, const Expr<R>& rhs) {
+  return {lhs.self(), rhs.self()};
+}
+
+/// Lazy multiplication of expression and Field3D
+template <typename L>
+inline BinaryExpr<L, FieldLeaf<Field3D>, Multiply>
+operator*(const Expr<L>& lhs, const Field3D& rhs) {
+  return {lhs.self(), FieldLeaf<Field3D>(rhs)};
+}
+
+/// Lazy division of expression and Field3D
+template <typename L>
+inline BinaryExpr<L, FieldLeaf<Field3D>, Divide>
+operator/(const Expr<L>& lhs, const Field3D& rhs) {
+  return {lhs.self(), FieldLeaf<Field3D>(rhs)};
+}
+
+/// Lazy addition of expression and Field3D
+template <typename L>
+inline BinaryExpr<L, FieldLeaf<Field3D>, Add>
+operator+(const Expr<L>& lhs, const Field3D& rhs) {
+  return {lhs.self(), FieldLeaf<Field3D>(rhs)};
+}
+
+/// Lazy subtraction of expression and Field3D
+template <typename L>
+inline BinaryExpr<L, FieldLeaf<Field3D>, Subtract>
+operator-(const Expr<L>& lhs, const Field3D& rhs) {
+  return {lhs.self(), FieldLeaf<Field3D>(rhs)};
+}
+
+/// Lazy multiplication of expression and Field2D
+template <typename L>
+inline BinaryExpr<L, FieldLeaf<Field2D>, Multiply>
+operator*(const Expr<L>& lhs, const Field2D& rhs) {
+  return {lhs.self(), FieldLeaf<Field2D>(rhs)};
+}
+
+/// Lazy division of expression and Field2D
+template <typename L>
+inline BinaryExpr<L, FieldLeaf<Field2D>, Divide>
+operator/(const Expr<L>& lhs, const Field2D& rhs) {
+  return {lhs.self(), FieldLeaf<Field2D>(rhs)};
+}
+
+/// Lazy addition of expression and Field2D
+template <typename L>
+inline BinaryExpr<L, FieldLeaf<Field2D>, Add>
+operator+(const Expr<L>& lhs, const Field2D& rhs) {
+  return {lhs.self(), FieldLeaf<Field2D>(rhs)};
+}
+
+/// Lazy subtraction of expression and Field2D
+template <typename L>
+inline BinaryExpr<L, FieldLeaf<Field2D>, Subtract>
+operator-(const Expr<L>& lhs, const Field2D& rhs) {
+  return {lhs.self(), FieldLeaf<Field2D>(rhs)};
+}
+
+/// Lazy multiplication of expression and BoutReal
+template <typename L>
+inline BinaryExpr<L, Scalar, Multiply>
+operator*(const Expr<L>& lhs, const BoutReal rhs) {
+  return {lhs.self(), Scalar(rhs)};
+}
+
+/// Lazy division of expression and BoutReal
+template <typename L>
+inline BinaryExpr<L, Scalar, Multiply>
+operator/(const Expr<L>& lhs, const BoutReal rhs) {
+  return {lhs.self(), Scalar(1.0 / rhs)};
+}
+
+/// Lazy addition of expression and BoutReal
+template <typename L>
+inline BinaryExpr<L, Scalar, Add>
+operator+(const Expr<L>& lhs, const BoutReal rhs) {
+  return {lhs.self(), Scalar(rhs)};
+}
+
+/// Lazy subtraction of expression and BoutReal
+template <typename L>
+inline BinaryExpr<L, Scalar, Subtract>
+operator-(const Expr<L>& lhs, const BoutReal rhs) {
+  return {lhs.self(), Scalar(rhs)};
+}
+
+/// Lazy multiplication of Field3D and expression
+template <typename R>
+inline BinaryExpr<FieldLeaf<Field3D>, R, Multiply>
+operator*(const Field3D& lhs, const Expr<R>& rhs) {
+  return {FieldLeaf<Field3D>(lhs), rhs.self()};
+}
+
+/// Lazy division of Field3D and expression
+template <typename R>
+inline BinaryExpr<FieldLeaf<Field3D>, R, Divide>
+operator/(const Field3D& lhs, const Expr<R>& rhs) {
+  return {FieldLeaf<Field3D>(lhs), rhs.self()};
+}
+
+/// Lazy addition of Field3D and expression
+template <typename R>
+inline BinaryExpr<FieldLeaf<Field3D>, R, Add>
+operator+(const Field3D& lhs, const Expr<R>& rhs) {
+  return {FieldLeaf<Field3D>(lhs), rhs.self()};
+}
+
+/// Lazy subtraction of Field3D and expression
+template <typename R>
+inline BinaryExpr<FieldLeaf<Field3D>, R, Subtract>
+operator-(const Field3D& lhs, const Expr<R>& rhs) {
+  return {FieldLeaf<Field3D>(lhs), rhs.self()};
+}
+
+/// Lazy multiplication of Field2D and expression
+template <typename R>
+inline BinaryExpr<FieldLeaf<Field2D>, R, Multiply>
+operator*(const Field2D& lhs, const Expr<R>& rhs) {
+  return {FieldLeaf<Field2D>(lhs), rhs.self()};
+}
+
+/// Lazy division of Field2D and expression
+template <typename R>
+inline BinaryExpr<FieldLeaf<Field2D>, R, Divide>
+operator/(const Field2D& lhs, const Expr<R>& rhs) {
+  return {FieldLeaf<Field2D>(lhs), rhs.self()};
+}
+
+/// Lazy addition of Field2D and expression
+template <typename R>
+inline BinaryExpr<FieldLeaf<Field2D>, R, Add>
+operator+(const Field2D& lhs, const Expr<R>& rhs) {
+  return {FieldLeaf<Field2D>(lhs), rhs.self()};
+}
+
+/// Lazy subtraction of Field2D and expression
+template <typename R>
+inline BinaryExpr<FieldLeaf<Field2D>, R, Subtract>
+operator-(const Field2D& lhs, const Expr<R>& rhs) {
+  return {FieldLeaf<Field2D>(lhs), rhs.self()};
+}
+
+/// Lazy multiplication of BoutReal and expression
+template <typename R>
+inline BinaryExpr<Scalar, R, Multiply>
+operator*(const BoutReal lhs, const Expr<R>& rhs) {
+  return {Scalar(lhs), rhs.self()};
+}
+
+/// Lazy division of BoutReal and expression
+template <typename R>
+inline BinaryExpr<Scalar, R, Divide>
+operator/(const BoutReal lhs, const Expr<R>& rhs) {
+  return {Scalar(lhs), rhs.self()};
+}
+
+/// Lazy addition of BoutReal and expression
+template <typename R>
+inline BinaryExpr<Scalar, R, Add>
+operator+(const BoutReal lhs, const Expr<R>& rhs) {
+  return {Scalar(lhs), rhs.self()};
+}
+
+/// Lazy subtraction of BoutReal and expression
+template <typename R>
+inline BinaryExpr<Scalar, R, Subtract>
+operator-(const BoutReal lhs, const Expr<R>& rhs) {
+  return {Scalar(lhs), rhs.self()};
+}
+
+} // namespace expr
+} // namespace bout
+
+#endif // __GENERATED_FIELDEXPR_H__
@@ -29,8 +29,10 @@
 #ifndef __INDEX_DERIVS_HXX__
 #define __INDEX_DERIVS_HXX__
 
+#include <algorithm>
 #include <functional>
 #include <iostream>
+#include <type_traits>
 
 #include <bout/assert.hxx>
 #include <bout/constants.hxx>
@@ -73,34 +75,112 @@ inline std::ostream& operator<<(std::ostream& out, const metaData& meta) {
   return out;
 }
 
+/// Loop over \p region of a Field3D, calling `interior(i)` for the
+/// points at least \p nGuards away from both ends of their Z line, and
+/// `wrap(i)` for the rest. `i` is the index into the field data, so
+/// `interior` can find Z neighbours at `i +/- offset` without having to
+/// wrap around in Z, which keeps the inner loop free of modulo
+/// operations
+template <int nGuards, typename Interior, typename Wrap>
+void forPeriodicZ(const Region<Ind3D>& region, int nz, Interior interior, Wrap wrap) {
+  const auto& blocks = region.getBlocks();
+  BOUT_OMP(parallel for schedule(OPENMP_SCHEDULE))
+  for (auto block = blocks.cbegin(); block < blocks.cend(); ++block) {
+    const int end = block->second.ind;
+    int i = block->first.ind;
+    while (i < end) {
+      // Split the rest of this Z line into [i, lo), [lo, hi) and [hi, stop),
+      // where only the middle section is away from the ends of the line
+      const int line_start = i - i % nz;
+      const int stop = std::min(end, line_start + nz);
+      const int lo = std::min(stop, std::max(i, line_start + nGuards));
+      const int hi = std::max(lo, std::min(stop, line_start + nz - nGuards));
+      for (; i < lo; ++i) {
+        wrap(i);
+      }
+      for (; i < hi; ++i) {
+        interior(i);
+      }
+      for (; i < stop; ++i) {
+        wrap(i);
+      }
+    }
+  }
+}
+
 /// Here we define a helper class that provides a means to use a supplied
 /// stencil using functor to calculate a derivative over the entire field.
 /// Note we currently have a different interface for some of the derivative types
 /// to avoid needing different classes to represent the different operations
 /// The use of a functor here makes it possible to wrap up metaData into the
 /// type as well.
+///
+/// Z derivatives of Field3D use forPeriodicZ, so only the points next to
+/// the ends of each Z line pay for the wrap-around in the Z index
 template <typename FF>
 class DerivativeType {
 public:
   template <DIRECTION direction, STAGGER stagger, int nGuards, typename T>
-  void standard(const T& var, T& result, const std::string& region) const {
+  void standard(const T& var, T& result, RegionID region) const {
     AUTO_TRACE();
     ASSERT2(meta.derivType == DERIV::Standard || meta.derivType == DERIV::StandardSecond
             || meta.derivType == DERIV::StandardFourth)
     ASSERT2(var.getMesh()->getNguard(direction) >= nGuards);
 
-    BOUT_FOR(i, var.getRegion(region)) {
-      result[i] = apply(populateStencil<direction, stagger, nGuards>(var, i));
-    }
-    return;
+    standardLoop<direction, stagger, nGuards>(var, result, region,
+                                              isPeriodicZ<direction, T>{});
   }
 
   template <DIRECTION direction, STAGGER stagger, int nGuards, typename T>
-  void upwindOrFlux(const T& vel, const T& var, T& result, const std::string& region) const {
+  void upwindOrFlux(const T& vel, const T& var, T& result, RegionID region) const {
     AUTO_TRACE();
     ASSERT2(meta.derivType == DERIV::Upwind || meta.derivType == DERIV::Flux)
     ASSERT2(var.getMesh()->getNguard(direction) >= nGuards);
 
+    upwindOrFluxLoop<direction, stagger, nGuards>(vel, var, result, region,
+                                                  isPeriodicZ<direction, T>{});
+  }
+
+  BoutReal apply(const stencil& f) const { return func(f); }
+  BoutReal apply(BoutReal v, const stencil& f) const { return func(v, f); }
+  BoutReal apply(const stencil& v, const stencil& f) const { return func(v, f); }
+
+  const FF func{};
+  const metaData meta = func.meta;
+
+private:
+  /// Z derivatives of Field3D can use the periodic Z loop
+  template <DIRECTION direction, typename T>
+  using isPeriodicZ =
+      std::integral_constant<bool, direction == DIRECTION::Z
+                                      and std::is_same<T, Field3D>::value>;
+
+  template <DIRECTION direction, STAGGER stagger, int nGuards, typename T>
+  void standardLoop(const T& var, T& result, RegionID region, std::false_type) const {
+    BOUT_FOR(i, var.getRegion(region)) {
+      result[i] = apply(populateStencil<direction, stagger, nGuards>(var, i));
+    }
+  }
+
+  template <DIRECTION direction, STAGGER stagger, int nGuards, typename T>
+  void standardLoop(const T& var, T& result, RegionID region, std::true_type) const {
+    const int ny = var.getNy();
+    const int nz = var.getNz();
+    const BoutReal* in = &var(0, 0, 0);
+    BoutReal* out = &result(0, 0, 0);
+
+    forPeriodicZ<nGuards>(
+        var.getRegion(region), nz,
+        [&](int i) { out[i] = apply(populateStencilInteriorZ<stagger, nGuards>(in, i)); },
+        [&](int i) {
+          const Ind3D ind{i, ny, nz};
+          out[i] = apply(populateStencil<direction, stagger, nGuards>(var, ind));
+        });
+  }
+
+  template <DIRECTION direction, STAGGER stagger, int nGuards, typename T>
+  void upwindOrFluxLoop(const T& vel, const T& var, T& result, RegionID region,
+                        std::false_type) const {
     if (meta.derivType == DERIV::Flux || stagger != STAGGER::None) {
       BOUT_FOR(i, var.getRegion(region)) {
         result[i] = apply(populateStencil<direction, stagger, nGuards>(vel, i),
@@ -112,15 +192,42 @@ public:
             apply(vel[i], populateStencil<direction, STAGGER::None, nGuards>(var, i));
       }
     }
-    return;
   }
 
-  BoutReal apply(const stencil& f) const { return func(f); }
-  BoutReal apply(BoutReal v, const stencil& f) const { return func(v, f); }
-  BoutReal apply(const stencil& v, const stencil& f) const { return func(v, f); }
+  template <DIRECTION direction, STAGGER stagger, int nGuards, typename T>
+  void upwindOrFluxLoop(const T& vel, const T& var, T& result, RegionID region,
+                        std::true_type) const {
+    const int ny = var.getNy();
+    const int nz = var.getNz();
+    const BoutReal* v = &vel(0, 0, 0);
+    const BoutReal* in = &var(0, 0, 0);
+    BoutReal* out = &result(0, 0, 0);
 
-  const FF func{};
-  const metaData meta = func.meta;
+    if (meta.derivType == DERIV::Flux || stagger != STAGGER::None) {
+      forPeriodicZ<nGuards>(
+          var.getRegion(region), nz,
+          [&](int i) {
+            out[i] = apply(populateStencilInteriorZ<stagger, nGuards>(v, i),
+                           populateStencilInteriorZ<STAGGER::None, nGuards>(in, i));
+          },
+          [&](int i) {
+            const Ind3D ind{i, ny, nz};
+            out[i] = apply(populateStencil<direction, stagger, nGuards>(vel, ind),
+                           populateStencil<direction, STAGGER::None, nGuards>(var, ind));
+          });
+    } else {
+      forPeriodicZ<nGuards>(
+          var.getRegion(region), nz,
+          [&](int i) {
+            out[i] = apply(v[i], populateStencilInteriorZ<STAGGER::None, nGuards>(in, i));
+          },
+          [&](int i) {
+            const Ind3D ind{i, ny, nz};
+            out[i] =
+                apply(v[i], populateStencil<direction, STAGGER::None, nGuards>(var, ind));
+          });
+    }
+  }
 };
 
 /////////////////////////////////////////////////////////////////////////////////
@@ -30,6 +30,7 @@
 #define __INDEX_DERIVS_INTERFACE_HXX__
 
 #include <bout/deriv_store.hxx>
+#include <bout/region.hxx>
 #include <bout_types.hxx>
 #include <msg_stack.hxx>
 #include "bout/traits.hxx"
@@ -41,10 +42,16 @@ namespace bout {
 namespace derivatives {
 namespace index {
 
+/// Handle for the default region of the derivative operators
+inline RegionID regionNoBndry() {
+  static const RegionID region_nobndry = RegionID::fromName("RGN_NOBNDRY");
+  return region_nobndry;
+}
+
 /// The main kernel used for all upwind and flux derivatives
 template <typename T, DIRECTION direction, DERIV derivType>
 T flowDerivative(const T& vel, const T& f, CELL_LOC outloc, const std::string& method,
-                 const std::string& region) {
+                 RegionID region) {
   AUTO_TRACE();
 
   // Checks
@@ -88,7 +95,7 @@ T flowDerivative(const T& vel, const T& f, CELL_LOC outloc, const std::string& m
   }
 
   // Lookup the method
-  auto derivativeMethod = DerivativeStore<T>::getInstance().getFlowDerivative(
+  const auto& derivativeMethod = DerivativeStore<T>::getInstance().getFlowDerivative(
       method, direction, stagger, derivType);
 
   // Create the result field
@@ -109,7 +116,7 @@ T flowDerivative(const T& vel, const T& f, CELL_LOC outloc, const std::string& m
 /// The main kernel used for all standard derivatives
 template <typename T, DIRECTION direction, DERIV derivType>
 T standardDerivative(const T& f, CELL_LOC outloc, const std::string& method,
-                     const std::string& region) {
+                     RegionID region) {
   AUTO_TRACE();
 
   // Checks
@@ -150,7 +157,7 @@ T standardDerivative(const T& f, CELL_LOC outloc, const std::string& method,
   }
 
   // Lookup the method
-  auto derivativeMethod = DerivativeStore<T>::getInstance().getStandardDerivative(
+  const auto& derivativeMethod = DerivativeStore<T>::getInstance().getStandardDerivative(
       method, direction, stagger, derivType);
 
   // Create the result field
@@ -169,53 +176,82 @@ T standardDerivative(const T& f, CELL_LOC outloc, const std::string& method,
 }
 
 ////// STANDARD OPERATORS
+//
+// Each operator takes the region as a RegionID, defaulting to
+// RGN_NOBNDRY, so that the region name is not looked up on every
+// call. The overloads taking a region name are for convenience
 
 ////////////// X DERIVATIVE /////////////////
 template <typename T>
 T DDX(const T& f, CELL_LOC outloc = CELL_DEFAULT, const std::string& method = "DEFAULT",
-      const std::string& region = "RGN_NOBNDRY") {
+      RegionID region = regionNoBndry()) {
   AUTO_TRACE();
-  return standardDerivative<T, DIRECTION::X, DERIV::Standard>(f, outloc, method, region);
+  return standardDerivative<T, DIRECTION::X, DERIV::Standard>(f, outloc, method,
+                                                              region);
+}
+
+template <typename T>
+T DDX(const T& f, CELL_LOC outloc, const std::string& method,
+      const std::string& region) {
+  return DDX(f, outloc, method, RegionID::fromName(region));
 }
 
 template <typename T>
 T D2DX2(const T& f, CELL_LOC outloc = CELL_DEFAULT, const std::string& method = "DEFAULT",
-        const std::string& region = "RGN_NOBNDRY") {
+        RegionID region = regionNoBndry()) {
   AUTO_TRACE();
-  return standardDerivative<T, DIRECTION::X, DERIV::StandardSecond>(f, outloc, method,
-                                                                    region);
+  return standardDerivative<T, DIRECTION::X, DERIV::StandardSecond>(
+      f, outloc, method, region);
+}
+
+template <typename T>
+T D2DX2(const T& f, CELL_LOC outloc, const std::string& method,
+        const std::string& region) {
+  return D2DX2(f, outloc, method, RegionID::fromName(region));
 }
 
 template <typename T>
 T D4DX4(const T& f, CELL_LOC outloc = CELL_DEFAULT, const std::string& method = "DEFAULT",
-        const std::string& region = "RGN_NOBNDRY") {
+        RegionID region = regionNoBndry()) {
   AUTO_TRACE();
-  return standardDerivative<T, DIRECTION::X, DERIV::StandardFourth>(f, outloc, method,
-                                                                    region);
+  return standardDerivative<T, DIRECTION::X, DERIV::StandardFourth>(
+      f, outloc, method, region);
+}
+
+template <typename T>
+T D4DX4(const T& f, CELL_LOC outloc, const std::string& method,
+        const std::string& region) {
+  return D4DX4(f, outloc, method, RegionID::fromName(region));
 }
 
 ////////////// Y DERIVATIVE /////////////////
 
 template <typename T>
 T DDY(const T& f, CELL_LOC outloc = CELL_DEFAULT, const std::string& method = "DEFAULT",
-      const std::string& region = "RGN_NOBNDRY") {
+      RegionID region = regionNoBndry()) {
   AUTO_TRACE();
   if (f.hasParallelSlices()) {
     ASSERT1(f.getDirectionY() == YDirectionType::Standard);
-    return standardDerivative<T, DIRECTION::YOrthogonal, DERIV::Standard>(f, outloc,
-                                                                          method, region);
+    return standardDerivative<T, DIRECTION::YOrthogonal, DERIV::Standard>(
+        f, outloc, method, region);
   } else {
     const bool is_unaligned = (f.getDirectionY() == YDirectionType::Standard);
     const T f_aligned = is_unaligned ? toFieldAligned(f, "RGN_NOX") : f;
-    T result = standardDerivative<T, DIRECTION::Y, DERIV::Standard>(f_aligned, outloc,
-                                                                    method, region);
-    return is_unaligned ? fromFieldAligned(result, region) : result;
+    T result = standardDerivative<T, DIRECTION::Y, DERIV::Standard>(
+        f_aligned, outloc, method, region);
+    return is_unaligned ? fromFieldAligned(result, region.name()) : result;
   }
 }
 
+template <typename T>
+T DDY(const T& f, CELL_LOC outloc, const std::string& method,
+      const std::string& region) {
+  return DDY(f, outloc, method, RegionID::fromName(region));
+}
+
 template <typename T>
 T D2DY2(const T& f, CELL_LOC outloc = CELL_DEFAULT, const std::string& method = "DEFAULT",
-        const std::string& region = "RGN_NOBNDRY") {
+        RegionID region = regionNoBndry()) {
   AUTO_TRACE();
   if (f.hasParallelSlices()) {
     ASSERT1(f.getDirectionY() == YDirectionType::Standard);
@@ -226,13 +262,19 @@ T D2DY2(const T& f, CELL_LOC outloc = CELL_DEFAULT, const std::string& method =
     const T f_aligned = is_unaligned ? toFieldAligned(f, "RGN_NOX") : f;
     T result = standardDerivative<T, DIRECTION::Y, DERIV::StandardSecond>(
         f_aligned, outloc, method, region);
-    return is_unaligned ? fromFieldAligned(result, region) : result;
+    return is_unaligned ? fromFieldAligned(result, region.name()) : result;
   }
 }
 
+template <typename T>
+T D2DY2(const T& f, CELL_LOC outloc, const std::string& method,
+        const std::string& region) {
+  return D2DY2(f, outloc, method, RegionID::fromName(region));
+}
+
 template <typename T>
 T D4DY4(const T& f, CELL_LOC outloc = CELL_DEFAULT, const std::string& method = "DEFAULT",
-        const std::string& region = "RGN_NOBNDRY") {
+        RegionID region = regionNoBndry()) {
   AUTO_TRACE();
   if (f.hasParallelSlices()) {
     ASSERT1(f.getDirectionY() == YDirectionType::Standard);
@@ -243,32 +285,57 @@ T D4DY4(const T& f, CELL_LOC outloc = CELL_DEFAULT, const std::string& method =
     const T f_aligned = is_unaligned ? toFieldAligned(f, "RGN_NOX") : f;
     T result = standardDerivative<T, DIRECTION::Y, DERIV::StandardFourth>(
         f_aligned, outloc, method, region);
-    return is_unaligned ? fromFieldAligned(result, region) : result;
+    return is_unaligned ? fromFieldAligned(result, region.name()) : result;
   }
 }
 
+template <typename T>
+T D4DY4(const T& f, CELL_LOC outloc, const std::string& method,
+        const std::string& region) {
+  return D4DY4(f, outloc, method, RegionID::fromName(region));
+}
+
 ////////////// Z DERIVATIVE /////////////////
 template <typename T>
 T DDZ(const T& f, CELL_LOC outloc = CELL_DEFAULT, const std::string& method = "DEFAULT",
-      const std::string& region = "RGN_NOBNDRY") {
+      RegionID region = regionNoBndry()) {
   AUTO_TRACE();
-  return standardDerivative<T, DIRECTION::Z, DERIV::Standard>(f, outloc, method, region);
+  return standardDerivative<T, DIRECTION::Z, DERIV::Standard>(f, outloc, method,
+                                                              region);
+}
+
+template <typename T>
+T DDZ(const T& f, CELL_LOC outloc, const std::string& method,
+      const std::string& region) {
+  return DDZ(f, outloc, method, RegionID::fromName(region));
 }
 
 template <typename T>
 T D2DZ2(const T& f, CELL_LOC outloc = CELL_DEFAULT, const std::string& method = "DEFAULT",
-        const std::string& region = "RGN_NOBNDRY") {
+        RegionID region = regionNoBndry()) {
   AUTO_TRACE();
-  return standardDerivative<T, DIRECTION::Z, DERIV::StandardSecond>(f, outloc, method,
-                                                                    region);
+  return standardDerivative<T, DIRECTION::Z, DERIV::StandardSecond>(
+      f, outloc, method, region);
+}
+
+template <typename T>
+T D2DZ2(const T& f, CELL_LOC outloc, const std::string& method,
+        const std::string& region) {
+  return D2DZ2(f, outloc, method, RegionID::fromName(region));
 }
 
 template <typename T>
 T D4DZ4(const T& f, CELL_LOC outloc = CELL_DEFAULT, const std::string& method = "DEFAULT",
-        const std::string& region = "RGN_NOBNDRY") {
+        RegionID region = regionNoBndry()) {
   AUTO_TRACE();
-  return standardDerivative<T, DIRECTION::Z, DERIV::StandardFourth>(f, outloc, method,
-                                                                    region);
+  return standardDerivative<T, DIRECTION::Z, DERIV::StandardFourth>(
+      f, outloc, method, region);
+}
+
+template <typename T>
+T D4DZ4(const T& f, CELL_LOC outloc, const std::string& method,
+        const std::string& region) {
+  return D4DZ4(f, outloc, method, RegionID::fromName(region));
 }
 
 ////// ADVECTION AND FLUX OPERATORS
@@ -290,23 +357,37 @@ T D4DZ4(const T& f, CELL_LOC outloc = CELL_DEFAULT, const std::string& method =
 
 template <typename T>
 T VDDX(const T& vel, const T& f, CELL_LOC outloc = CELL_DEFAULT,
-       const std::string& method = "DEFAULT", const std::string& region = "RGN_NOBNDRY") {
+       const std::string& method = "DEFAULT", RegionID region = regionNoBndry()) {
   AUTO_TRACE();
-  return flowDerivative<T, DIRECTION::X, DERIV::Upwind>(vel, f, outloc, method, region);
+  return flowDerivative<T, DIRECTION::X, DERIV::Upwind>(vel, f, outloc, method,
+                                                        region);
+}
+
+template <typename T>
+T VDDX(const T& vel, const T& f, CELL_LOC outloc,
+       const std::string& method, const std::string& region) {
+  return VDDX(vel, f, outloc, method, RegionID::fromName(region));
 }
 
 template <typename T>
 T FDDX(const T& vel, const T& f, CELL_LOC outloc = CELL_DEFAULT,
-       const std::string& method = "DEFAULT", const std::string& region = "RGN_NOBNDRY") {
+       const std::string& method = "DEFAULT", RegionID region = regionNoBndry()) {
   AUTO_TRACE();
-  return flowDerivative<T, DIRECTION::X, DERIV::Flux>(vel, f, outloc, method, region);
+  return flowDerivative<T, DIRECTION::X, DERIV::Flux>(vel, f, outloc, method,
+                                                      region);
+}
+
+template <typename T>
+T FDDX(const T& vel, const T& f, CELL_LOC outloc,
+       const std::string& method, const std::string& region) {
+  return FDDX(vel, f, outloc, method, RegionID::fromName(region));
 }
 
 ////////////// Y DERIVATIVE /////////////////
 
 template <typename T>
 T VDDY(const T& vel, const T& f, CELL_LOC outloc = CELL_DEFAULT,
-       const std::string& method = "DEFAULT", const std::string& region = "RGN_NOBNDRY") {
+       const std::string& method = "DEFAULT", RegionID region = regionNoBndry()) {
   AUTO_TRACE();
 
   // Note the following chunk is copy+pasted from flowDerivative
@@ -342,8 +423,8 @@ T VDDY(const T& vel, const T& f, CELL_LOC outloc = CELL_DEFAULT,
   if (fHasParallelSlices && useVelParallelSlices) {
     ASSERT1(vel.getDirectionY() == YDirectionType::Standard);
     ASSERT1(f.getDirectionY() == YDirectionType::Standard);
-    return flowDerivative<T, DIRECTION::YOrthogonal, DERIV::Upwind>(vel, f, outloc,
-                                                                    method, region);
+    return flowDerivative<T, DIRECTION::YOrthogonal, DERIV::Upwind>(
+        vel, f, outloc, method, region);
   } else {
     ASSERT2(f.getDirectionY() == vel.getDirectionY());
     const bool are_unaligned = ((f.getDirectionY() == YDirectionType::Standard)
@@ -352,22 +433,29 @@ T VDDY(const T& vel, const T& f, CELL_LOC outloc = CELL_DEFAULT,
     const T f_aligned = are_unaligned ? toFieldAligned(f, "RGN_NOX") : f;
     const T vel_aligned = are_unaligned ? toFieldAligned(vel, "RGN_NOX") : vel;
     T result = flowDerivative<T, DIRECTION::Y, DERIV::Upwind>(vel_aligned, f_aligned,
-                                                              outloc, method, region);
-    return are_unaligned ? fromFieldAligned(result, region) : result;
+                                                              outloc, method,
+                                                              region);
+    return are_unaligned ? fromFieldAligned(result, region.name()) : result;
   }
 }
 
+template <typename T>
+T VDDY(const T& vel, const T& f, CELL_LOC outloc,
+       const std::string& method, const std::string& region) {
+  return VDDY(vel, f, outloc, method, RegionID::fromName(region));
+}
+
 template <typename T>
 T FDDY(const T& vel, const T& f, CELL_LOC outloc = CELL_DEFAULT,
-       const std::string& method = "DEFAULT", const std::string& region = "RGN_NOBNDRY") {
+       const std::string& method = "DEFAULT", RegionID region = regionNoBndry()) {
   AUTO_TRACE();
   const bool fHasParallelSlices = (f.hasParallelSlices());
   const bool velHasParallelSlices = (vel.hasParallelSlices());
   if (fHasParallelSlices && velHasParallelSlices) {
     ASSERT1(vel.getDirectionY() == YDirectionType::Standard);
     ASSERT1(f.getDirectionY() == YDirectionType::Standard);
-    return flowDerivative<T, DIRECTION::YOrthogonal, DERIV::Flux>(vel, f, outloc, method,
-                                                                  region);
+    return flowDerivative<T, DIRECTION::YOrthogonal, DERIV::Flux>(
+        vel, f, outloc, method, region);
   } else {
     ASSERT2(f.getDirectionY() == vel.getDirectionY());
     const bool are_unaligned = ((f.getDirectionY() == YDirectionType::Standard)
@@ -376,25 +464,46 @@ T FDDY(const T& vel, const T& f, CELL_LOC outloc = CELL_DEFAULT,
     const T f_aligned = are_unaligned ? toFieldAligned(f, "RGN_NOX") : f;
     const T vel_aligned = are_unaligned ? toFieldAligned(vel, "RGN_NOX") : vel;
     T result = flowDerivative<T, DIRECTION::Y, DERIV::Flux>(vel_aligned, f_aligned,
-                                                            outloc, method, region);
-    return are_unaligned ? fromFieldAligned(result, region) : result;
+                                                            outloc, method,
+                                                            region);
+    return are_unaligned ? fromFieldAligned(result, region.name()) : result;
   }
 }
 
+template <typename T>
+T FDDY(const T& vel, const T& f, CELL_LOC outloc,
+       const std::string& method, const std::string& region) {
+  return FDDY(vel, f, outloc, method, RegionID::fromName(region));
+}
+
 ////////////// Z DERIVATIVE /////////////////
 
 template <typename T>
 T VDDZ(const T& vel, const T& f, CELL_LOC outloc = CELL_DEFAULT,
-       const std::string& method = "DEFAULT", const std::string& region = "RGN_NOBNDRY") {
+       const std::string& method = "DEFAULT", RegionID region = regionNoBndry()) {
   AUTO_TRACE();
-  return flowDerivative<T, DIRECTION::Z, DERIV::Upwind>(vel, f, outloc, method, region);
+  return flowDerivative<T, DIRECTION::Z, DERIV::Upwind>(vel, f, outloc, method,
+                                                        region);
+}
+
+template <typename T>
+T VDDZ(const T& vel, const T& f, CELL_LOC outloc,
+       const std::string& method, const std::string& region) {
+  return VDDZ(vel, f, outloc, method, RegionID::fromName(region));
 }
 
 template <typename T>
 T FDDZ(const T& vel, const T& f, CELL_LOC outloc = CELL_DEFAULT,
-       const std::string& method = "DEFAULT", const std::string& region = "RGN_NOBNDRY") {
+       const std::string& method = "DEFAULT", RegionID region = regionNoBndry()) {
   AUTO_TRACE();
-  return flowDerivative<T, DIRECTION::Z, DERIV::Flux>(vel, f, outloc, method, region);
+  return flowDerivative<T, DIRECTION::Z, DERIV::Flux>(vel, f, outloc, method,
+                                                      region);
+}
+
+template <typename T>
+T FDDZ(const T& vel, const T& f, CELL_LOC outloc,
+       const std::string& method, const std::string& region) {
+  return FDDZ(vel, f, outloc, method, RegionID::fromName(region));
 }
 
 } // Namespace index
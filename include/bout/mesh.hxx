@@ -262,6 +262,41 @@ class Mesh {
    */
   void communicate(FieldPerp &f); 
 
+  /// A communication started by startCommunicate, which must be
+  /// passed to finishCommunicate before the guard cells are used
+  struct CommunicateHandle {
+    comm_handle handle{nullptr}; ///< Handle returned by send()
+    FieldGroup group;            ///< The fields being communicated
+  };
+
+  /// Start communicating a list of fields, without waiting for the
+  /// communication to finish. Packs arguments into a FieldGroup
+  template <typename... Ts>
+  CommunicateHandle startCommunicate(Ts&... ts) {
+    FieldGroup g(ts...);
+    return startCommunicate(g);
+  }
+
+  /// Start communicating the guard cells of the fields in \p g,
+  /// returning without waiting for the data to arrive. This allows
+  /// calculations which don't need the guard cells, for example
+  /// stencils evaluated over the "RGN_INTERIOR" region, to overlap
+  /// with the communication:
+  ///
+  ///     auto handle = mesh->startCommunicate(f, g);
+  ///     // Calculations over "RGN_INTERIOR"
+  ///     mesh->finishCommunicate(handle);
+  ///     // Calculations over "RGN_INTERIOR_EDGE"
+  ///
+  /// The data in the fields must not be modified until
+  /// finishCommunicate has been called
+  CommunicateHandle startCommunicate(FieldGroup& g);
+
+  /// Wait for a communication started by startCommunicate to finish.
+  /// As for communicate, this also calculates the parallel slices of
+  /// 3D fields if calcParallelSlices_on_communicate is set
+  void finishCommunicate(CommunicateHandle& h);
+
   /*!
    * Send a list of FieldData objects
    * Packs arguments into a FieldGroup and passes
@@ -846,15 +881,36 @@ class Mesh {
   // MAXREGIONBLOCKSIZE in include/bout/region.hxx
   int maxregionblocksize;
   
+  /// Return the handle for the region called region_name. Handles
+  /// are the same on every mesh, and looking up a region by handle
+  /// avoids searching for the name each time
+  static RegionID getRegionID(const std::string& region_name) {
+    return RegionID::fromName(region_name);
+  }
+
   /// Get the named region from the region_map for the data iterator
   ///
   /// Throws if region_name not found
   const Region<> &getRegion(const std::string &region_name) const{
     return getRegion3D(region_name);
   }
-  const Region<Ind3D> &getRegion3D(const std::string &region_name) const;
-  const Region<Ind2D> &getRegion2D(const std::string &region_name) const;
-  const Region<IndPerp> &getRegionPerp(const std::string &region_name) const;
+  const Region<Ind3D> &getRegion3D(const std::string &region_name) const {
+    return getRegion3D(getRegionID(region_name));
+  }
+  const Region<Ind2D> &getRegion2D(const std::string &region_name) const {
+    return getRegion2D(getRegionID(region_name));
+  }
+  const Region<IndPerp> &getRegionPerp(const std::string &region_name) const {
+    return getRegionPerp(getRegionID(region_name));
+  }
+
+  /// Get a region by handle
+  ///
+  /// Throws if the region is not defined on this mesh
+  const Region<> &getRegion(RegionID region) const { return getRegion3D(region); }
+  const Region<Ind3D> &getRegion3D(RegionID region) const;
+  const Region<Ind2D> &getRegion2D(RegionID region) const;
+  const Region<IndPerp> &getRegionPerp(RegionID region) const;
 
   /// Indicate if named region has already been defined
   bool hasRegion3D(const std::string& region_name) const;
@@ -937,9 +993,10 @@ private:
       bool force_interpolate_from_centre=false);
 
   //Internal region related information
-  std::map<std::string, Region<Ind3D>> regionMap3D;
-  std::map<std::string, Region<Ind2D>> regionMap2D;
-  std::map<std::string, Region<IndPerp>> regionMapPerp;
+  /// Regions, indexed by RegionID. nullptr if not defined on this mesh
+  std::vector<std::shared_ptr<Region<Ind3D>>> regions3D;
+  std::vector<std::shared_ptr<Region<Ind2D>>> regions2D;
+  std::vector<std::shared_ptr<Region<IndPerp>>> regionsPerp;
   Array<int> indexLookup3Dto2D;
 };
 
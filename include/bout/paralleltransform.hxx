@@ -299,14 +299,17 @@ private:
   void shiftZ(const BoutReal* in, int len, BoutReal zangle, BoutReal* out) const;
 
   /*!
-   * Shift a given 1D array, assumed to be in Z, by the given \p zangle
+   * Shift \p nlines consecutive 1D arrays, assumed to be in Z, by the
+   * given phases. All the lines are transformed with a single batched FFT
    *
-   * @param[in] in  A 1D array of length mesh.LocalNz
+   * @param[in] in  \p nlines contiguous 1D arrays of length mesh.LocalNz
    * @param[in] phs Phase shift, assumed to have length (mesh.LocalNz/2 + 1) i.e. the
-   * number of modes
-   * @param[out] out  A 1D array of length mesh.LocalNz, already allocated
+   * number of modes, for each line
+   * @param[out] out  \p nlines 1D arrays of length mesh.LocalNz, already allocated
+   * @param[in] nlines  Number of Z lines to shift
    */
-  void shiftZ(const BoutReal* in, const dcomplex* phs, BoutReal* out) const;
+  void shiftZ(const BoutReal* in, const dcomplex* phs, BoutReal* out,
+              int nlines = 1) const;
 
   /// Calculate and store the phases for to/from field aligned and for
   /// the parallel slices using zShift
@@ -43,8 +43,13 @@
 #define __REGION_H__
 
 #include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <ostream>
+#include <string>
 #include <type_traits>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -384,6 +389,101 @@ inline const std::string toString(const IndPerp& i) {
              + std::to_string(i.z()) + ")";
 }
 
+/// Handle for a named region
+///
+/// Region names are interned: each name always gives the same
+/// RegionID, on every mesh. Looking up a region by RegionID is an
+/// index into a vector, rather than a search through a map of
+/// strings, so look the name up once and reuse the handle:
+///
+///     static const auto rgn = Mesh::getRegionID("RGN_NOBNDRY");
+///     BOUT_FOR(i, f.getRegion(rgn)) {
+///       ...
+///     }
+class RegionID {
+public:
+  RegionID() = default;
+  explicit RegionID(int id) : id(id) {}
+
+  /// Return the handle for the region called \p name
+  ///
+  /// Names which have already been registered are found without
+  /// taking a lock, so this is safe to call inside OpenMP regions,
+  /// but it still hashes \p name: keep the handle rather than
+  /// calling this in a loop
+  static RegionID fromName(const std::string& name) {
+    auto& registry = getRegistry();
+    {
+      const auto* snapshot = registry.current.load(std::memory_order_acquire);
+      const auto found = snapshot->ids.find(name);
+      if (found != std::end(snapshot->ids)) {
+        return RegionID{found->second};
+      }
+    }
+
+    // Not seen before: publish a new snapshot with this name added
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    const auto* snapshot = registry.current.load(std::memory_order_relaxed);
+    const auto found = snapshot->ids.find(name);
+    if (found != std::end(snapshot->ids)) {
+      return RegionID{found->second};
+    }
+    auto next = std::unique_ptr<Snapshot>(new Snapshot(*snapshot));
+    const int new_id = next->names.size();
+    next->ids.emplace(name, new_id);
+    next->names.push_back(name);
+    registry.current.store(next.get(), std::memory_order_release);
+    registry.snapshots.push_back(std::move(next));
+    return RegionID{new_id};
+  }
+
+  /// The name of the region
+  const std::string& name() const {
+    static const std::string invalid = "<invalid region>";
+    const auto* snapshot = getRegistry().current.load(std::memory_order_acquire);
+    if (id < 0 or id >= static_cast<int>(snapshot->names.size())) {
+      return invalid;
+    }
+    return snapshot->names[id];
+  }
+
+  /// Index of this region, or -1 if not set
+  int value() const { return id; }
+
+private:
+  int id{-1};
+
+  /// All the names seen so far. The ID of a name is its position in `names`
+  struct Snapshot {
+    std::unordered_map<std::string, int> ids;
+    std::vector<std::string> names;
+  };
+
+  /// Snapshots are never modified once published, and never freed,
+  /// so readers can use `current` without locking. There are only a
+  /// few tens of region names, so keeping the old snapshots is cheap
+  struct Registry {
+    Registry() {
+      snapshots.emplace_back(new Snapshot());
+      current.store(snapshots.back().get());
+    }
+    std::mutex mutex; ///< Held while adding a name
+    std::atomic<const Snapshot*> current{nullptr};
+    std::vector<std::unique_ptr<const Snapshot>> snapshots;
+  };
+  static Registry& getRegistry() {
+    static Registry registry;
+    return registry;
+  }
+};
+
+inline bool operator==(const RegionID& lhs, const RegionID& rhs) {
+  return lhs.value() == rhs.value();
+}
+inline bool operator!=(const RegionID& lhs, const RegionID& rhs) {
+  return !(lhs == rhs);
+}
+
 /// Structure to hold various derived "statistics" from a particular region
 struct RegionStats {
   int numBlocks = 0;           ///< How many blocks
@@ -466,6 +566,16 @@ inline std::ostream &operator<<(std::ostream &out, const RegionStats &stats){
 ///     BOUT_FOR_SERIAL(i, region) {
 ///       max = f[i] > max ? f[i] : max;
 ///     }
+///
+/// Regions constructed from a range in x, y and z are "boxes": only
+/// the range and the contiguous blocks are stored, and the blocks are
+/// calculated directly from the range. The explicit list of indices
+/// is only created if it is asked for, e.g. by getIndices() or a
+/// range-based for loop, and is then shared between copies of the
+/// region. BOUT_FOR only uses the blocks, so looping over a box region
+/// never touches the indices. Operations which can make a region
+/// irregular (mask, addition, offset, etc.) return regions with
+/// explicit indices.
 template <typename T = Ind3D> class Region {
   // Following prevents a Region being created with anything other
   // than Ind2D, Ind3D or IndPerp as template type
@@ -482,6 +592,11 @@ public:
   /// Collection of contiguous regions
   using ContiguousBlocks = std::vector<ContiguousBlock>;
 
+  /// The inclusive ranges of a box region
+  struct Box {
+    int xstart, xend, ystart, yend, zstart, zend;
+  };
+
   // NOTE::
   // Probably want to require a mesh in constructor, both to know nx/ny/nz
   // but also to ensure consistency etc.
@@ -497,7 +612,8 @@ public:
 
   Region<T>(int xstart, int xend, int ystart, int yend, int zstart, int zend, int ny,
             int nz, int maxregionblocksize = MAXREGIONBLOCKSIZE)
-      : ny(ny), nz(nz) {
+      : ny(ny), nz(nz), box{xstart, xend, ystart, yend, zstart, zend},
+        box_indices(std::make_shared<BoxIndices>()) {
 #if CHECK > 1
     if (std::is_base_of<Ind2D, T>::value) {
       if (nz != 1)
@@ -519,8 +635,11 @@ public:
     }
 #endif
     
-    indices = createRegionIndices(xstart, xend, ystart, yend, zstart, zend, ny, nz);
-    blocks = getContiguousBlocks(maxregionblocksize);
+    if (boxSize() > 0) {
+      ASSERT1(ny > 0);
+      ASSERT1(nz > 0);
+    }
+    blocks = getBoxBlocks(maxregionblocksize);
   };
 
   Region<T>(RegionIndices &indices, int maxregionblocksize = MAXREGIONBLOCKSIZE) : indices(indices) {
@@ -538,26 +657,58 @@ public:
   /// for-loops or with STL algorithms, etc.
   ///
   /// Note that if the indices are altered using these iterators, the
-  /// blocks may become out of sync and will need to manually updated
-  typename RegionIndices::iterator begin() { return std::begin(indices); };
-  typename RegionIndices::const_iterator begin() const { return std::begin(indices); };
-  typename RegionIndices::const_iterator cbegin() const { return indices.cbegin(); };
-  typename RegionIndices::iterator end() { return std::end(indices); };
-  typename RegionIndices::const_iterator end() const { return std::end(indices); };
-  typename RegionIndices::const_iterator cend() const { return indices.cend(); };
+  /// blocks may become out of sync and will need to manually updated.
+  /// The non-const versions turn a box region into an explicit one
+  typename RegionIndices::iterator begin() {
+    makeExplicit();
+    return std::begin(indices);
+  };
+  typename RegionIndices::const_iterator begin() const {
+    return std::begin(getIndices());
+  };
+  typename RegionIndices::const_iterator cbegin() const { return getIndices().cbegin(); };
+  typename RegionIndices::iterator end() {
+    makeExplicit();
+    return std::end(indices);
+  };
+  typename RegionIndices::const_iterator end() const { return std::end(getIndices()); };
+  typename RegionIndices::const_iterator cend() const { return getIndices().cend(); };
 
   const ContiguousBlocks &getBlocks() const { return blocks; };
-  const RegionIndices &getIndices() const { return indices; };
+
+  /// The indices of this region. For a box region these are created
+  /// the first time this is called
+  const RegionIndices &getIndices() const {
+    if (not isBox()) {
+      return indices;
+    }
+    std::call_once(box_indices->created, [this]() {
+      box_indices->indices = createRegionIndices(box.xstart, box.xend, box.ystart,
+                                                 box.yend, box.zstart, box.zend, ny, nz);
+    });
+    return box_indices->indices;
+  };
+
+  /// Is this a box region, described only by its range in x, y and z?
+  bool isBox() const { return box_indices != nullptr; }
+
+  /// The range of a box region
+  const Box &getBox() const {
+    ASSERT1(isBox());
+    return box;
+  }
 
   /// Set the indices and ensure blocks updated
   void setIndices (RegionIndices &indicesIn, int maxregionblocksize = MAXREGIONBLOCKSIZE) {
     indices = indicesIn;
+    box_indices.reset();
     blocks = getContiguousBlocks(maxregionblocksize);
   };
 
   /// Set the blocks and ensure indices updated
   void setBlocks (ContiguousBlocks &blocksIn) {
     blocks = blocksIn;
+    box_indices.reset();
     indices = getRegionIndices();
   };
 
@@ -687,7 +838,7 @@ public:
 
   /// Number of indices (possibly repeated)
   unsigned int size() const {
-    return indices.size();
+    return isBox() ? boxSize() : indices.size();
   }
 
   /// Returns a RegionStats struct desribing the region
@@ -732,15 +883,41 @@ public:
   // sorted this would prevent this usage.
 
 private:
-  RegionIndices indices;   //< Flattened indices
+  /// The indices of a box region, created when first needed
+  struct BoxIndices {
+    std::once_flag created;
+    RegionIndices indices;
+  };
+
+  RegionIndices indices;   //< Flattened indices, if not a box region
   ContiguousBlocks blocks; //< Contiguous sections of flattened indices
   int ny = -1;             //< Size of y dimension
   int nz = -1;             //< Size of z dimension
+  Box box{0, -1, 0, -1, 0, -1}; //< Range of a box region
+  /// Shared between copies of a box region, nullptr otherwise
+  std::shared_ptr<BoxIndices> box_indices;
+
+  /// Number of points in the box
+  int boxSize() const {
+    if ((box.xend < box.xstart) || (box.yend < box.ystart) || (box.zend < box.zstart)) {
+      return 0;
+    }
+    return (box.xend - box.xstart + 1) * (box.yend - box.ystart + 1)
+           * (box.zend - box.zstart + 1);
+  }
+
+  /// Store the indices explicitly, so that they can be changed
+  void makeExplicit() {
+    if (isBox()) {
+      indices = getIndices();
+      box_indices.reset();
+    }
+  }
 
   /// Helper function to create a RegionIndices, given the start and end
   /// points in x, y, z, and the total y, z lengths
   inline RegionIndices createRegionIndices(int xstart, int xend, int ystart, int yend,
-                                           int zstart, int zend, int ny, int nz) {
+                                           int zstart, int zend, int ny, int nz) const {
 
     if ((xend + 1 <= xstart) ||
         (yend + 1 <= ystart) ||
@@ -785,6 +962,46 @@ private:
   }
 
 
+  /// Returns the contiguous blocks of a box region, calculated from the
+  /// range rather than the indices. Each (x, y) row of z points is
+  /// contiguous, and consecutive rows join up if they cover all of z
+  /// (or all of y and z). The result is the same as
+  /// getContiguousBlocks would give for the explicit indices
+  ContiguousBlocks getBoxBlocks(int maxregionblocksize) const {
+    ASSERT1(maxregionblocksize > 0);
+    ContiguousBlocks result;
+    if (boxSize() == 0) {
+      return result;
+    }
+
+    const int rowLength = box.zend - box.zstart + 1;
+    int blockStart = -1, blockEnd = -1; // Current block [blockStart, blockEnd)
+
+    for (int x = box.xstart; x <= box.xend; ++x) {
+      for (int y = box.ystart; y <= box.yend; ++y) {
+        int start = (x * ny + y) * nz + box.zstart;
+        int remaining = rowLength;
+        while (remaining > 0) {
+          if (blockEnd != start or blockEnd - blockStart == maxregionblocksize) {
+            // Can't extend the current block
+            if (blockStart >= 0) {
+              result.push_back({T{blockStart, ny, nz}, T{blockEnd, ny, nz}});
+            }
+            blockStart = blockEnd = start;
+          }
+          const int count =
+              std::min(remaining, maxregionblocksize - (blockEnd - blockStart));
+          blockEnd += count;
+          start += count;
+          remaining -= count;
+        }
+      }
+    }
+    result.push_back({T{blockStart, ny, nz}, T{blockEnd, ny, nz}});
+
+    return result;
+  }
+
   /// Returns a vector of all contiguous blocks contained in the passed region.
   /// Limits the maximum size of any contiguous block to maxBlockSize.
   /// A contiguous block is described by the inclusive start and the exclusive end
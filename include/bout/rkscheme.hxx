@@ -37,6 +37,7 @@ class RKScheme;
 
 #include <bout_types.hxx>
 #include <options.hxx>
+#include <unused.hxx>
 #include <utils.hxx>
 
 #include <iomanip>
@@ -47,6 +48,8 @@ class RKScheme;
 #define RKSCHEME_CASHKARP    "cashkarp"
 #define RKSCHEME_RK4         "rk4"
 #define RKSCHEME_RKF34       "rkf34"
+#define RKSCHEME_RK3LS       "rk3ls"
+#define RKSCHEME_RK4LS       "rk4ls"
 
 class RKScheme {
  public:
@@ -66,11 +69,23 @@ class RKScheme {
   virtual void setCurState(const Array<BoutReal> &start, Array<BoutReal> &out,int curStage, 
 			   BoutReal dt);
 
-  //Calculate the output state and return the error estimate (if adaptive)
+  //Where the derivatives of the given stage should be saved
+  virtual BoutReal* getStageDerivs(int curStage) { return &steps(curStage, 0); };
+
+  //Called once the derivatives of a stage have been saved. The state
+  //is the one set by setCurState, and may be updated in place.
+  virtual void finishStage(Array<BoutReal> &UNUSED(state), int UNUSED(curStage),
+                           BoutReal UNUSED(dt)){};
+
+  //Calculate the output state and return the local part of the error
+  //estimate (if adaptive). The solver sums this over processors.
   virtual BoutReal setOutputStates(const Array<BoutReal> &start,BoutReal dt, Array<BoutReal> &resultFollow);
 
-  //Update the timestep
-  virtual BoutReal updateTimestep(BoutReal dt,BoutReal err);
+  //Returns the order of the error estimate
+  int getOrder(){return order;};
+
+  //Returns the factor applied to new timesteps
+  BoutReal getTimestepFactor(){return dtfac;};
 
   //Returns the string name for the given scheme
   virtual std::string getType(){return label;};
@@ -81,6 +96,9 @@ class RKScheme {
   //Returns the number of orders for the current scheme
   int getNumOrders(){return numOrders;};
 
+  //Returns the number of state sized arrays held in steps
+  virtual int getStorageCount(){return numStages;};
+
   //The intermediate stages
   Matrix<BoutReal> steps;
 
@@ -107,6 +125,7 @@ class RKScheme {
 
   BoutReal dtfac;
 
+  //Local part of the error estimate, given two solutions
   virtual BoutReal getErr(Array<BoutReal> &solA, Array<BoutReal> &solB);
 
   virtual void constructOutput(const Array<BoutReal> &start,BoutReal dt, 
@@ -122,4 +141,46 @@ class RKScheme {
   void zeroSteps();
 };
 
+/// Base class for low-storage (2N) schemes in Williamson form
+///
+/// Each stage updates two registers in place
+///
+///     dq = A[i]*dq + dt*f(t + c[i]*dt, q)
+///      q = q + B[i]*dq
+///
+/// so only dq and the stage derivatives are stored, rather than one
+/// array per stage. The stage state q is built up in the output
+/// array. If the scheme has an embedded solution, the difference
+/// between the two solutions is accumulated as the stages are taken.
+class LowStorageRKScheme : public RKScheme {
+ public:
+  LowStorageRKScheme(Options *opts = nullptr) : RKScheme(opts) {};
+
+  void setCurState(const Array<BoutReal> &start, Array<BoutReal> &out, int curStage,
+                   BoutReal dt) override;
+
+  BoutReal* getStageDerivs(int UNUSED(curStage)) override { return &steps(1, 0); };
+
+  void finishStage(Array<BoutReal> &state, int curStage, BoutReal dt) override;
+
+  BoutReal setOutputStates(const Array<BoutReal> &start, BoutReal dt,
+                           Array<BoutReal> &resultFollow) override;
+
+  int getStorageCount() override { return 2; };
+
+ protected:
+  //The 2N coefficients
+  Array<BoutReal> lowStorageA;
+  Array<BoutReal> lowStorageB;
+  //Weights of the embedded solution, if numOrders == 2
+  Array<BoutReal> embeddedCoeffs;
+
+  //Fill the Butcher tableau from the 2N coefficients
+  void setButcherTableau();
+
+ private:
+  //Weights giving the error estimate from the stage derivatives
+  Array<BoutReal> errCoeffs;
+};
+
 #endif // __RKSCHEME_H__
@@ -72,8 +72,11 @@ using TimestepMonitorFunc = int (*)(Solver* solver, BoutReal simtime, BoutReal l
 #include "physicsmodel.hxx"
 #undef BOUT_NO_USING_NAMESPACE_BOUTGLOBALS
 
+#include <array>
 #include <list>
+#include <set>
 #include <string>
+#include <vector>
 
 using SolverType = std::string;
 constexpr auto SOLVERCVODE = "cvode";
@@ -429,9 +432,64 @@ protected:
   void save_derivs(BoutReal* dudata);
   void set_id(BoutReal* udata);
 
+  /// Is the state ordered field by field, rather than interleaving
+  /// the variables at each point? Solvers which rely on the
+  /// interleaved structure (e.g. through globalIndex) can't use this
+  bool field_major{false};
+
   /// Returns a Field3D containing the global indices
   Field3D globalIndex(int localStart);
 
+  /// Offsets {x, y, z} from a point to the points on which a time
+  /// derivative there depends. z offsets are periodic, in [0, LocalNz)
+  using StencilOffsets = std::set<std::array<int, 3>>;
+  /// Element [i][j] holds the offsets at which the time derivative of
+  /// variable i depends on variable j. Variables are numbered with
+  /// the 2D fields first, then the 3D fields
+  using JacobianStencil = std::vector<std::vector<StencilOffsets>>;
+
+  /// Find the stencil of the Jacobian by perturbing each variable in
+  /// turn, at points spaced further apart than the widest stencil,
+  /// and seeing which time derivatives change. This costs one RHS
+  /// evaluation per variable, plus one. The variables and their time
+  /// derivatives are left unchanged.
+  ///
+  /// Couplings which are zero in the current state are not found,
+  /// and a coupling wider than solver:jacobian_width_x/y is folded
+  /// back into that width, so this is not exact. Unless
+  /// solver:jacobian_star is false, the nearest-neighbour star
+  /// coupling every variable to every other is added.
+  ///
+  /// A 2D time derivative depending on a 3D variable is taken to
+  /// depend on all z at that (x, y)
+  ///
+  /// Points whose neighbourhood wraps round a periodic direction or
+  /// crosses a branch cut are not perturbed, as a change there could
+  /// come from either side. Only guard cells are checked, so a
+  /// jacobian_width_x/y wider than the guard cells is not protected
+  ///
+  /// If \p implicit_only is true, the stencil of run_diffusive (the
+  /// part solved implicitly by IMEX schemes) is found rather than
+  /// that of the whole RHS
+  JacobianStencil jacobianStencil(bool implicit_only = false);
+
+  /// Non-zero elements of the Jacobian on this processor, in the
+  /// interleaved state ordering (see globalIndex)
+  struct JacobianPattern {
+    /// Global index of the first row on this processor
+    int first_row{0};
+    /// Sorted global column indices of the non-zeros in each local row
+    std::vector<std::vector<int>> columns;
+    /// Number of non-zeros in each row in the diagonal block (columns on
+    /// this processor) and in the off-diagonal block
+    std::vector<int> d_nnz, o_nnz;
+  };
+
+  /// Apply \p stencil at each point of the state, to give the sparsity
+  /// pattern of the Jacobian for preallocation and colouring. The
+  /// diagonal is always included
+  JacobianPattern jacobianPattern(const JacobianStencil& stencil);
+
   /// Maximum internal timestep
   BoutReal max_dt{-1.0};
 
@@ -439,6 +497,9 @@ protected:
   auto getMonitors() const -> const std::list<Monitor*>& { return monitors; }
 
 private:
+  /// Value returned by getLocalN, once calculated
+  int cacheLocalN{-1};
+
   /// Number of calls to the RHS function
   int rhs_ncalls{0};
   /// Number of calls to the explicit (convective) RHS function
@@ -486,7 +547,6 @@ private:
   void post_rhs(BoutReal t);
 
   /// Loading data from BOUT++ to/from solver
-  void loop_vars_op(Ind2D i2d, BoutReal* udata, int& p, SOLVER_VAR_OP op, bool bndry);
   void loop_vars(BoutReal* udata, SOLVER_VAR_OP op);
 
   /// Check if a variable has already been added
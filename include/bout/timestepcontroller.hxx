@@ -0,0 +1,95 @@
+/**************************************************************************
+ * Step size controller for adaptive explicit solvers
+ *
+ **************************************************************************
+ *
+ * This file is part of BOUT++.
+ *
+ * BOUT++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * BOUT++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with BOUT++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **************************************************************************/
+
+class TimestepController;
+
+#ifndef __TIMESTEPCONTROLLER_H__
+#define __TIMESTEPCONTROLLER_H__
+
+#include "bout_types.hxx"
+
+class Options;
+
+/// Chooses the next timestep of an adaptive solver from the error
+/// estimates of the current and previous steps
+///
+/// With r = (rtol/2) / err, the timestep after an accepted step is
+///
+///     dt_new = safety * dt * r_n^(k1/q) * r_{n-1}^(-k2/q) * r_{n-2}^(k3/q)
+///
+/// where q is the order of the error estimate plus one. The gains
+/// are set by solver:controller:
+///
+///  - "I": k1 = 1. The timestep is only changed if err > rtol or
+///    err < 0.1*rtol, as the solvers have always done
+///  - "PI": k1 = 0.8, k2 = 0.31
+///  - "PID": k1 = 0.58, k2 = 0.21, k3 = 0.1
+///  - "Gustafsson": the explicit form of Gustafsson's controller,
+///    k1 = 0.635, k2 = 0.268
+///
+/// and can be overridden with controller_k1, controller_k2 and
+/// controller_k3. After a rejected step the I controller is used and
+/// the history is not updated.
+///
+/// reduce() combines the per-step global reductions (the error sum
+/// and any timestep limit set with limitTimestep) into a single
+/// MPI_Allreduce.
+class TimestepController {
+public:
+  /// @param[in] options  The solver options
+  /// @param[in] order    Order of the error estimate
+  /// @param[in] rtol     Steps with err < rtol are accepted
+  /// @param[in] safety   Factor applied to every new timestep
+  TimestepController(Options* options, int order, BoutReal rtol, BoutReal safety = 1.0);
+
+  /// Sum \p local_err over all processors, and divide by \p neq.
+  /// Any timestep limits are combined in the same reduction.
+  BoutReal reduce(BoutReal local_err, int neq);
+
+  /// Limit the next timestep on this processor to \p dt. The limit is
+  /// applied on all processors after the next reduce()
+  void limitTimestep(BoutReal dt);
+
+  /// Is a step with error \p err accepted?
+  bool accept(BoutReal err) const { return err < rtol; }
+
+  /// The timestep to use after a step of size \p dt with error \p err
+  BoutReal nextTimestep(BoutReal dt, BoutReal err);
+
+  /// Forget the errors of previous steps
+  void reset();
+
+private:
+  BoutReal rtol;
+  BoutReal safety;
+  BoutReal exponent; ///< 1 / (order + 1)
+  BoutReal k1{1.0}, k2{0.0}, k3{0.0}; ///< Controller gains
+  bool deadband{true}; ///< Only change the timestep outside [0.1*rtol, rtol]?
+
+  /// Error ratios of the previous two accepted steps
+  BoutReal ratio_prev1{1.0}, ratio_prev2{1.0};
+
+  /// Timestep limit on this processor, and across all processors
+  BoutReal local_limit{-1.0}, global_limit{-1.0};
+};
+
+#endif // __TIMESTEPCONTROLLER_H__
@@ -54,6 +54,8 @@
 
 #include "bout/openmpwrap.hxx"
 
+#include <vector>
+
 template <class T> class CyclicReduce {
 public:
   CyclicReduce() = default;
@@ -114,6 +116,9 @@ public:
   void setCoefs(const Matrix<T>& a, const Matrix<T>& b, const Matrix<T>& c) {
     TRACE("CyclicReduce::setCoefs");
 
+    if (in_flight)
+      throw BoutException("CyclicReduce::setCoefs called while a solve is in progress");
+
     int nsys = std::get<0>(a.shape());
 
     // Make sure correct memory arrays allocated
@@ -160,14 +165,42 @@ public:
 
   /// Solve a set of tridiagonal systems
   ///
+  /// Equivalent to calling start() followed immediately by finish()
+  ///
   /// @param[in] rhs Matrix storing Values of the rhs for each system
   /// @param[out] x  Matrix storing the result for each system
   void solve(const Matrix<T> &rhs, Matrix<T> &x) {
     TRACE("CyclicReduce::solve");
+    start(rhs);
+    finish(x);
+  }
+
+  /// Start solving a set of tridiagonal systems
+  ///
+  /// This inserts the \p rhs, reduces the local part of the systems
+  /// to interface equations, and starts sending those to the
+  /// processors which will solve them. It returns without waiting for
+  /// the communication to complete: the solution is obtained by
+  /// calling finish().
+  ///
+  /// Several independent CyclicReduce objects can be in flight at the
+  /// same time, so that e.g. the local reduction of one batch of
+  /// systems overlaps the communication of another:
+  ///
+  ///     for (auto& cr : solvers) cr.start(rhs);
+  ///     for (auto& cr : solvers) cr.finish(x);
+  ///
+  /// If several solvers share a communicator, then all processors
+  /// must call start() and finish() on them in the same order
+  ///
+  /// @param[in] rhs Matrix storing Values of the rhs for each system
+  void start(const Matrix<T> &rhs) {
+    TRACE("CyclicReduce::start");
     ASSERT2(static_cast<int>(std::get<0>(rhs.shape())) == Nsys);
-    ASSERT2(static_cast<int>(std::get<0>(x.shape())) == Nsys);
     ASSERT2(static_cast<int>(std::get<1>(rhs.shape())) == N);
-    ASSERT2(static_cast<int>(std::get<1>(x.shape())) == N);
+
+    if (in_flight)
+      throw BoutException("CyclicReduce::start called before previous solve finished");
 
     // Multiple RHS
     int nrhs = std::get<0>(rhs.shape());
@@ -210,11 +243,11 @@ public:
     int ns = Nsys / nprocs;      // Number of systems to assign to all processors
     int nsextra = Nsys % nprocs; // Number of processors with 1 extra
 
-    auto* req = new MPI_Request[nprocs];
+    recv_req.assign(nprocs, MPI_REQUEST_NULL);
+    send_req.assign(nprocs, MPI_REQUEST_NULL);
 
     if (myns > 0) {
       // Post receives from all other processors
-      req[myproc] = MPI_REQUEST_NULL;
       for (int p = 0; p < nprocs; p++) { // Loop over processor
         // 2 interface equations per processor
         // myns systems to solve
@@ -232,16 +265,17 @@ public:
           output << "Expecting to receive " << len << " from " << p << endl;
 #endif
           MPI_Irecv(&recvbuffer(p, 0), len,
-                    MPI_BYTE, // Just sending raw data, unknown type
-                    p,        // Destination processor
-                    p,        // Identifier
-                    comm,     // Communicator
-                    &req[p]); // Request
+                    MPI_BYTE,      // Just sending raw data, unknown type
+                    p,             // Destination processor
+                    p,             // Identifier
+                    comm,          // Communicator
+                    &recv_req[p]); // Request
         }
       }
     }
 
-    // Send data
+    // Send data. myif is not modified again until the next start(),
+    // so the sends can complete in the background
     int s0 = 0;
     for (int p = 0; p < nprocs; p++) { // Loop over processor
       int nsp = ns;
@@ -253,22 +287,43 @@ public:
         for (int i = 0; i < 8; i++)
           output << "value " << i << " : " << myif(s0, i) << endl;
 #endif
-        MPI_Send(&myif(s0, 0),        // Data pointer
-                 8 * nsp * sizeof(T), // Number
-                 MPI_BYTE,            // Type
-                 p,                   // Destination
-                 myproc,              // Message identifier
-                 comm);               // Communicator
+        MPI_Isend(&myif(s0, 0),        // Data pointer
+                  8 * nsp * sizeof(T), // Number
+                  MPI_BYTE,            // Type
+                  p,                   // Destination
+                  myproc,              // Message identifier
+                  comm,                // Communicator
+                  &send_req[p]);       // Request
       }
       s0 += nsp;
     }
 
+    in_flight = true;
+  }
+
+  /// Finish solving the set of tridiagonal systems passed to start()
+  ///
+  /// Waits for the interface equations, solves them, exchanges the
+  /// interface solutions and back-solves the local systems
+  ///
+  /// @param[out] x  Matrix storing the result for each system
+  void finish(Matrix<T> &x) {
+    TRACE("CyclicReduce::finish");
+    ASSERT2(static_cast<int>(std::get<0>(x.shape())) == Nsys);
+    ASSERT2(static_cast<int>(std::get<1>(x.shape())) == N);
+
+    if (!in_flight)
+      throw BoutException("CyclicReduce::finish called without a matching start");
+
+    int ns = Nsys / nprocs;      // Number of systems to assign to all processors
+    int nsextra = Nsys % nprocs; // Number of processors with 1 extra
+
     if (myns > 0) {
       // Wait for data
       int p;
       do {
         MPI_Status stat;
-        MPI_Waitany(nprocs, req, &p, &stat);
+        MPI_Waitany(nprocs, recv_req.data(), &p, &stat);
         if (p != MPI_UNDEFINED) {
 // p is the processor number. Copy data
 #ifdef DIAGNOSE
@@ -282,7 +337,7 @@ public:
 #endif
               ifcs(i, 8 * p + j) = recvbuffer(p, 8 * i + j);
             }
-          req[p] = MPI_REQUEST_NULL;
+          recv_req[p] = MPI_REQUEST_NULL;
         }
       } while (p != MPI_UNDEFINED);
 
@@ -338,9 +393,15 @@ public:
       back_solve(myns, 2 * nprocs, ifcs, x1, xn, ifx);
     }
 
+    // The interface equations must have been sent before the send
+    // requests can be reused for the scatter
+    MPI_Waitall(nprocs, send_req.data(), MPI_STATUSES_IGNORE);
+
     if (nprocs > 1) {
       ///////////////////////////////////////
-      // Scatter back solution
+      // Scatter back solution. Uses different message identifiers to
+      // the gather, so that the two can't be confused when several
+      // solvers are in flight on the same communicator
 
       // Post receives
       for (int p = 0; p < nprocs; p++) { // Loop over processor
@@ -356,37 +417,38 @@ public:
             x1[sys0 + i] = ifx(i, 2 * p);
             xn[sys0 + i] = ifx(i, 2 * p + 1);
           }
-          req[p] = MPI_REQUEST_NULL;
+          recv_req[p] = MPI_REQUEST_NULL;
         } else if (nsp > 0) {
 #ifdef DIAGNOSE
           output << "Expecting receive from " << p << " of size " << len << endl;
 #endif
           MPI_Irecv(&recvbuffer(p, 0), len,
-                    MPI_BYTE, // Just sending raw data, unknown type
-                    p,        // Destination processor
-                    p,        // Identifier
-                    comm,     // Communicator
-                    &req[p]); // Request
+                    MPI_BYTE,      // Just sending raw data, unknown type
+                    p,             // Destination processor
+                    nprocs + p,    // Identifier
+                    comm,          // Communicator
+                    &recv_req[p]); // Request
         } else
-          req[p] = MPI_REQUEST_NULL;
+          recv_req[p] = MPI_REQUEST_NULL;
       }
 
       if (myns > 0) {
-        // Send data
+        // Send data. Each processor has its own row of ifp, so all
+        // the sends can be in progress at once
         for (int p = 0; p < nprocs; p++) { // Loop over processor
           if (p != myproc) {
 	    BOUT_OMP(parallel for)	    
             for (int i = 0; i < myns; i++) {
-              ifp[2 * i] = ifx(i, 2 * p);
-              ifp[2 * i + 1] = ifx(i, 2 * p + 1);
+              ifp(p, 2 * i) = ifx(i, 2 * p);
+              ifp(p, 2 * i + 1) = ifx(i, 2 * p + 1);
 #ifdef DIAGNOSE
-              output << "Returning: " << ifp[2 * i] << ", " << ifp[2 * i + 1] << " to "
-                     << p << endl;
+              output << "Returning: " << ifp(p, 2 * i) << ", " << ifp(p, 2 * i + 1)
+                     << " to " << p << endl;
 #endif
             }
-            MPI_Send(std::begin(ifp), 2 * myns * sizeof(T), MPI_BYTE, p,
-                     myproc, // Message identifier
-                     comm);
+            MPI_Isend(&ifp(p, 0), 2 * myns * sizeof(T), MPI_BYTE, p,
+                      nprocs + myproc, // Message identifier
+                      comm, &send_req[p]);
           }
         }
       }
@@ -396,7 +458,7 @@ public:
       int nsp;
       do {
         MPI_Status stat;
-        MPI_Waitany(nprocs, req, &fromproc, &stat);
+        MPI_Waitany(nprocs, recv_req.data(), &fromproc, &stat);
 
         if (fromproc != MPI_UNDEFINED) {
           // fromproc is the processor number. Copy data
@@ -420,15 +482,18 @@ public:
                    << xn[s0 + i] << " from " << fromproc << endl;
 #endif
           }
-          req[fromproc] = MPI_REQUEST_NULL;
+          recv_req[fromproc] = MPI_REQUEST_NULL;
         }
       } while (fromproc != MPI_UNDEFINED);
+
+      MPI_Waitall(nprocs, send_req.data(), MPI_STATUSES_IGNORE);
     }
 
     ///////////////////////////////////////
     // Solve local equations
     back_solve(Nsys, N, coefs, x1, xn, x);
-    delete[] req;
+
+    in_flight = false;
   }
 
 private:
@@ -449,9 +514,13 @@ private:
   Matrix<T> ifcs;       ///< Coefficients for interface solve
   Matrix<T> if2x2;      ///< 2x2 interface equations on this processor
   Matrix<T> ifx;        ///< Solution of interface equations
-  Array<T> ifp;         ///< Interface equations returned to processor p
+  Matrix<T> ifp;        ///< Interface solutions returned to each processor
   Array<T> x1, xn;      ///< Interface solutions for back-solving
 
+  std::vector<MPI_Request> recv_req; ///< Outstanding receives, one per processor
+  std::vector<MPI_Request> send_req; ///< Outstanding sends, one per processor
+  bool in_flight{false}; ///< Has start() been called without finish()?
+
   /// Allocate memory arrays
   /// @param[in] np   Number of processors
   /// @param[in] nsys  Number of independent systems to solve
@@ -497,7 +566,7 @@ private:
       if2x2.reallocate(myns, 2 * 4); // 2x2 interface equations on this processor
     }
     ifx.reallocate(myns, 2 * nprocs); // Solution of interface equations
-    ifp.reallocate(myns * 2);         // Solution to be sent to processor p
+    ifp.reallocate(nprocs, myns * 2); // Solution to be sent to each processor
     // Each system to be solved on this processor has two interface equations from each
     // processor
 
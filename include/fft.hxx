@@ -31,6 +31,8 @@
 #include "dcomplex.hxx"
 #include <bout/array.hxx>
 
+#include <string>
+
 class Options;
 
 namespace bout {
@@ -70,6 +72,48 @@ void rfft(const BoutReal *in, int length, dcomplex *out);
  */
 void irfft(const dcomplex *in, int length, BoutReal *out);
 
+/*!
+ * Batched version of rfft: transforms \p howmany real signals of
+ * \p length points each with a single FFTW plan
+ *
+ * The i-th signal starts at `in + i * stride`, so that e.g. all the
+ * Z-lines of a Field3D can be transformed with
+ *
+ *     rfft(&f(0, 0, 0), nz, nx * ny, nz, out);
+ *
+ * and the lines at fixed y with `howmany = nx, stride = ny * nz`.
+ * The output is contiguous: the modes of the i-th signal are
+ * `out[i * (length / 2 + 1) + kz]`. As for rfft, the output is
+ * normalised by 1 / \p length
+ *
+ * Plans are created on first use and cached per thread, so repeated
+ * calls with the same shape only pay for the transform itself. This
+ * function may be called from inside OpenMP parallel regions
+ *
+ * \param[in] in      Pointer to the first signal
+ * \param[in] length  Number of points in each signal
+ * \param[in] howmany Number of signals to transform
+ * \param[in] stride  Distance between the starts of consecutive signals
+ * \param[out] out    Pointer to `howmany * (length / 2 + 1)` complex values
+ */
+void rfft(const BoutReal* in, int length, int howmany, int stride, dcomplex* out);
+
+/*!
+ * Batched version of irfft: inverse transforms \p howmany complex
+ * signals of `length / 2 + 1` modes each
+ *
+ * The input is contiguous, with the modes of the i-th signal at
+ * `in[i * (length / 2 + 1) + kz]`. The i-th real output signal
+ * starts at `out + i * stride`
+ *
+ * \param[in] in      Pointer to `howmany * (length / 2 + 1)` complex values
+ * \param[in] length  Number of points in each real output signal
+ * \param[in] howmany Number of signals to transform
+ * \param[in] stride  Distance between the starts of consecutive output signals
+ * \param[out] out    Pointer to the first output signal
+ */
+void irfft(const dcomplex* in, int length, int howmany, int stride, BoutReal* out);
+
 /*!
  * Discrete Sine Transform
  *
@@ -92,6 +136,39 @@ void fft_init(bool fft_measure);
 /// "fftw_measure". If it is nullptr, use the global `Options` root
 void fft_init(Options* options = nullptr);
 
+/// Load FFTW wisdom from \p filename, so that plans measured in
+/// previous runs don't need to be measured again. Returns false if
+/// the file couldn't be read
+bool fft_import_wisdom(const std::string& filename);
+
+/// Save the FFTW wisdom gathered so far to \p filename. Returns
+/// false if the file couldn't be written
+bool fft_export_wisdom(const std::string& filename);
+
+/// Load FFTW wisdom from the file given by the "wisdom_file" option
+/// in \p options (the "fft" section if nullptr), and remember the file
+/// for fft_save_wisdom. Does nothing if the option is empty, which is
+/// the default. The file is only read by processor 0 of BoutComm, and
+/// the wisdom broadcast to all the others.
+///
+/// If "wisdom_file" is set this must be called collectively. Returns
+/// true if wisdom was loaded
+bool fft_load_wisdom(Options* options = nullptr);
+
+/// If any processor has measured new plans, gather all the new wisdom
+/// onto processor 0 of BoutComm and save it to the file given to
+/// fft_load_wisdom. Does nothing if no file was given.
+///
+/// If a file was given this must be called collectively, as it is in
+/// BoutFinalise. A processor which exits without calling it (e.g.
+/// after an exception) will deadlock the others, so wisdom files
+/// should only be used in runs which finish normally. Returns true if
+/// the file was written
+bool fft_save_wisdom();
+
+/// Destroy all the cached plans and working arrays
+void fft_cleanup();
+
 /// Returns the fft of a real signal \p in using fftw_forward
 Array<dcomplex> rfft(const Array<BoutReal>& in);
 
@@ -119,6 +196,16 @@ inline void irfft(const dcomplex *in, int length, BoutReal *out) {
   return bout::fft::irfft(in, length, out);
 }
 
+inline void rfft(const BoutReal* in, int length, int howmany, int stride,
+                 dcomplex* out) {
+  return bout::fft::rfft(in, length, howmany, stride, out);
+}
+
+inline void irfft(const dcomplex* in, int length, int howmany, int stride,
+                  BoutReal* out) {
+  return bout::fft::irfft(in, length, howmany, stride, out);
+}
+
 inline void DST(const BoutReal *in, int length, dcomplex *out) {
   return bout::fft::DST(in, length, out);
 }
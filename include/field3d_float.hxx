@@ -0,0 +1,81 @@
+#ifndef __FIELD3D_FLOAT_H__
+#define __FIELD3D_FLOAT_H__
+
+#include "bout/array.hxx"
+#include "bout/region.hxx"
+#include "field.hxx"
+#include "field3d.hxx"
+
+/// A 3D field which stores its values in single precision
+///
+/// This halves the memory and bandwidth used by large fields which
+/// are set once and then only read, such as coefficients or
+/// diagnostics, at the cost of keeping only about 7 significant
+/// figures. Values are converted to BoutReal when read.
+///
+/// There is no arithmetic on Field3DF itself: either convert to a
+/// Field3D with toField3D(), or use it in a lazy expression, where
+/// it is converted point by point:
+///
+///     Field3DF coef{emptyFrom(f)};
+///     coef = a * b;  // Rounded to float
+///     Field3D result = lazy(f) * lazy(coef);
+class Field3DF : public Field {
+public:
+  using ind_type = Ind3D;
+  /// Data type stored in this field
+  using value_type = float;
+
+  Field3DF(Mesh* localmesh = nullptr, CELL_LOC location_in = CELL_CENTRE,
+           DirectionTypes directions_in = {YDirectionType::Standard,
+                                           ZDirectionType::Standard});
+
+  /// Convert \p f to single precision, keeping its metadata
+  explicit Field3DF(const Field3D& f);
+
+  /// Round the values of \p f to single precision. The metadata is
+  /// copied from \p f
+  Field3DF& operator=(const Field3D& f);
+  Field3DF& operator=(BoutReal val);
+
+  /// Ensures that memory is allocated and unique
+  Field3DF& allocate();
+
+  bool isAllocated() const { return !data.empty(); }
+
+  int getNx() const override { return nx; }
+  int getNy() const override { return ny; }
+  int getNz() const override { return nz; }
+
+  /// Convert back to double precision
+  Field3D toField3D() const;
+
+  /// Return a Region<Ind3D> reference to use to iterate over this field
+  const Region<Ind3D>& getRegion(const std::string& region_name) const;
+
+  float& operator[](const Ind3D& d) { return data[d.ind]; }
+  BoutReal operator[](const Ind3D& d) const { return data[d.ind]; }
+
+  float& operator()(int jx, int jy, int jz) {
+    ASSERT3(isAllocated());
+    ASSERT3(jx >= 0 && jx < nx && jy >= 0 && jy < ny && jz >= 0 && jz < nz);
+    return data[(jx * ny + jy) * nz + jz];
+  }
+  BoutReal operator()(int jx, int jy, int jz) const {
+    ASSERT3(isAllocated());
+    ASSERT3(jx >= 0 && jx < nx && jy >= 0 && jy < ny && jz >= 0 && jz < nz);
+    return data[(jx * ny + jy) * nz + jz];
+  }
+
+  /// Pointer to the start of the data, for use in tight loops
+  const float* begin() const { return std::begin(data); }
+
+private:
+  /// Array sizes (from fieldmesh). These are valid only if fieldmesh is not null
+  int nx{-1}, ny{-1}, nz{-1};
+
+  /// Internal data array. Handles allocation/freeing of memory
+  Array<float> data;
+};
+
+#endif // __FIELD3D_FLOAT_H__
@@ -124,4 +124,48 @@ stencil inline populateStencil(const FieldType& f, const typename FieldType::ind
   populateStencil<direction, stagger, nGuard, FieldType>(s, f, i);
   return s;
 }
+
+/// Fill a Z stencil directly from the data of a Field3D, for a point
+/// \p ind at least nGuard points away from both ends of its Z line,
+/// so that no wrapping around in Z is needed. Sets the same values as
+/// populateStencil<DIRECTION::Z, stagger, nGuard>
+template <STAGGER stagger = STAGGER::None, int nGuard = 1>
+stencil inline populateStencilInteriorZ(const BoutReal* data, int ind) {
+  static_assert(nGuard == 1 || nGuard == 2,
+                "populateStencilInteriorZ only supports one or two guard cells");
+  stencil s;
+  const BoutReal* f = data + ind;
+  switch (stagger) {
+  case (STAGGER::None):
+    if (nGuard == 2) {
+      s.mm = f[-2];
+    }
+    s.m = f[-1];
+    s.c = f[0];
+    s.p = f[1];
+    if (nGuard == 2) {
+      s.pp = f[2];
+    }
+    break;
+  case (STAGGER::C2L):
+    if (nGuard == 2) {
+      s.mm = f[-2];
+    }
+    s.m = f[-1];
+    s.c = f[0];
+    s.p = s.c;
+    s.pp = f[1];
+    break;
+  case (STAGGER::L2C):
+    s.mm = f[-1];
+    s.m = f[0];
+    s.c = s.m;
+    s.p = f[1];
+    if (nGuard == 2) {
+      s.pp = f[2];
+    }
+    break;
+  }
+  return s;
+}
 #endif /* __STENCILS_H__ */
@@ -42,6 +42,7 @@ const char DEFAULT_DIR[] = "data";
 #include "boutcomm.hxx"
 #include "boutexception.hxx"
 #include "datafile.hxx"
+#include "fft.hxx"
 #include "invert_laplace.hxx"
 #include "msg_stack.hxx"
 #include "optionsreader.hxx"
@@ -58,6 +59,7 @@ const char DEFAULT_DIR[] = "data";
 
 #include <csignal>
 #include <ctime>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -150,10 +152,17 @@ int BoutInitialise(int& argc, char**& argv) {
 
     setRunStartInfo(Options::root());
 
+    // Must be set before the mesh allocates any fields
+    setupArrayStore(Options::root());
+
     if (MYPE == 0) {
       writeSettingsFile(Options::root(), args.data_dir, args.set_file);
     }
 
+    // Set up FFTs, loading any saved wisdom before the first plans are made
+    bout::fft::fft_init();
+    bout::fft::fft_load_wisdom();
+
     // Create the mesh
     bout::globals::mesh = Mesh::create();
     // Load from sources. Required for Field initialisation
@@ -516,6 +525,92 @@ void setRunFinishInfo(Options& options) {
   options["run"]["finished"].force(ctime(&end_time), "");
 }
 
+void setupArrayStore(Options& options) {
+  const bool first_touch =
+      options["memory"]["first_touch"]
+          .doc("First touch new field memory in parallel, with the same partitioning "
+               "as BOUT_FOR loops. Improves memory placement on NUMA systems")
+          .withDefault(false);
+
+  Array<BoutReal>::setFirstTouch(first_touch);
+  Array<dcomplex>::setFirstTouch(first_touch);
+  Array<float>::setFirstTouch(first_touch);
+
+  const BoutReal store_limit =
+      options["memory"]["store_limit"]
+          .doc("Maximum memory in MiB to keep for reuse in each Array store, once "
+               "released. By default (< 0), no limit")
+          .withDefault(-1.0);
+
+  if (store_limit >= 0.0) {
+    const auto max_bytes = static_cast<std::size_t>(store_limit * 1024 * 1024);
+    Array<BoutReal>::setStoreLimit(max_bytes);
+    Array<dcomplex>::setStoreLimit(max_bytes);
+    Array<float>::setStoreLimit(max_bytes);
+  }
+}
+
+template <typename T>
+void printStoreStatistics(const std::string& name) {
+  using StoreStats = typename Array<T>::StoreStats;
+  constexpr BoutReal MiB = 1024 * 1024;
+
+  const auto threads = Array<T>::storeStatistics();
+
+  output_info.write(_("Array<%s> store: %.1f MiB allocated (peak %.1f MiB), %.1f MiB "
+                      "cached\n"),
+                    name.c_str(), Array<T>::allocatedBytes() / MiB,
+                    Array<T>::peakAllocatedBytes() / MiB, Array<T>::cachedBytes() / MiB);
+
+  const auto hitRate = [](const StoreStats& stats) {
+    const auto requests = stats.hits + stats.misses;
+    return requests == 0 ? 0.0 : (100. * stats.hits) / requests;
+  };
+
+  // Totals over all threads for each size
+  std::map<int, StoreStats> totals;
+  for (const auto& thread : threads) {
+    for (const auto& entry : thread) {
+      auto& total = totals[entry.first];
+      total.cached += entry.second.cached;
+      total.hits += entry.second.hits;
+      total.misses += entry.second.misses;
+      total.freed += entry.second.freed;
+    }
+  }
+
+  for (const auto& entry : totals) {
+    const auto& stats = entry.second;
+    const auto live = stats.misses - stats.freed - stats.cached;
+    output_info.write(_("  size %9d: %6lu live, %6lu cached, %9.1f MiB, %5.1f%% hits\n"),
+                      entry.first, static_cast<unsigned long>(live),
+                      static_cast<unsigned long>(stats.cached),
+                      (live + stats.cached) * entry.first * sizeof(T) / MiB,
+                      hitRate(stats));
+  }
+
+  if (threads.size() > 1) {
+    for (std::size_t i = 0; i < threads.size(); ++i) {
+      StoreStats total;
+      std::size_t cached_bytes = 0;
+      for (const auto& entry : threads[i]) {
+        total.hits += entry.second.hits;
+        total.misses += entry.second.misses;
+        cached_bytes += entry.second.cached * entry.first * sizeof(T);
+      }
+      output_info.write(_("  thread %3lu: %9.1f MiB cached, %5.1f%% hits\n"),
+                        static_cast<unsigned long>(i), cached_bytes / MiB,
+                        hitRate(total));
+    }
+  }
+}
+
+void printArrayStoreStatistics() {
+  printStoreStatistics<BoutReal>("BoutReal");
+  printStoreStatistics<dcomplex>("dcomplex");
+  printStoreStatistics<float>("float");
+}
+
 Datafile setupDumpFile(Options& options, Mesh& mesh, const std::string& data_dir) {
   // Check if restarting
   const bool append = options["append"]
@@ -606,9 +701,14 @@ int BoutFinalise(bool write_settings) {
   // Laplacian inversion
   Laplacian::cleanup();
 
+  // FFT plans, saving any new wisdom
+  bout::fft::fft_save_wisdom();
+  bout::fft::fft_cleanup();
+
   // Delete field memory
   Array<BoutReal>::cleanup();
   Array<dcomplex>::cleanup();
+  Array<float>::cleanup();
   Array<fcmplx>::cleanup();
   Array<int>::cleanup();
   Array<unsigned long>::cleanup();
@@ -652,6 +752,7 @@ int BoutMonitor::call(Solver* solver, BoutReal t, int iter, int NOUT) {
   static BoutReal wall_limit, mpi_start_time; // Keep track of remaining wall time
 
   static bool stopCheck;            // Check for file, exit if exists?
+  static bool memoryStatistics;     // Print Array store statistics?
   static std::string stopCheckName; // File checked, whose existence triggers a stop
 
   // Set the global variables. This is done because they need to be
@@ -699,6 +800,11 @@ int BoutMonitor::call(Solver* solver, BoutReal t, int iter, int NOUT) {
       stopCheckName = data_dir + "/" + stopCheckName;
     }
 
+    memoryStatistics =
+        options["memory"]["statistics"]
+            .doc(_("Write Array memory store statistics to the log at each output"))
+            .withDefault(false);
+
     /// Record the starting time
     mpi_start_time = MPI_Wtime() - run_data.wtime;
 
@@ -716,6 +822,10 @@ int BoutMonitor::call(Solver* solver, BoutReal t, int iter, int NOUT) {
 
   run_data.writeProgress(simtime, output_split);
 
+  if (memoryStatistics) {
+    bout::experimental::printArrayStoreStatistics();
+  }
+
   // This bit only to screen, not log file
 
   run_data.t_elapsed = MPI_Wtime() - mpi_start_time;
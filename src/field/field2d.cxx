@@ -129,6 +129,9 @@ const Region<Ind2D> &Field2D::getRegion(REGION region) const {
 const Region<Ind2D> &Field2D::getRegion(const std::string &region_name) const {
   return fieldmesh->getRegion2D(region_name);
 };
+const Region<Ind2D> &Field2D::getRegion(RegionID region) const {
+  return fieldmesh->getRegion2D(region);
+};
 
 // Not in header because we need to access fieldmesh
 BoutReal& Field2D::operator[](const Ind3D &d) {
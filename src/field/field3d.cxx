@@ -231,6 +231,9 @@ const Region<Ind3D> &Field3D::getRegion(REGION region) const {
 const Region<Ind3D> &Field3D::getRegion(const std::string &region_name) const {
   return fieldmesh->getRegion3D(region_name);
 };
+const Region<Ind3D> &Field3D::getRegion(RegionID region) const {
+  return fieldmesh->getRegion3D(region);
+};
 
 const Region<Ind2D> &Field3D::getRegion2D(REGION region) const {
   return fieldmesh->getRegion2D(toString(region));
@@ -238,6 +241,9 @@ const Region<Ind2D> &Field3D::getRegion2D(REGION region) const {
 const Region<Ind2D> &Field3D::getRegion2D(const std::string &region_name) const {
   return fieldmesh->getRegion2D(region_name);
 };
+const Region<Ind2D> &Field3D::getRegion2D(RegionID region) const {
+  return fieldmesh->getRegion2D(region);
+};
 
 /***************************************************************
  *                         OPERATORS 
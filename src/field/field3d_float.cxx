@@ -0,0 +1,87 @@
+#include "field3d_float.hxx"
+
+#include "bout/mesh.hxx"
+#include "globals.hxx"
+#include "msg_stack.hxx"
+
+Field3DF::Field3DF(Mesh* localmesh, CELL_LOC location_in, DirectionTypes directions_in)
+    : Field(localmesh, location_in, directions_in) {
+  if (fieldmesh) {
+    nx = fieldmesh->LocalNx;
+    ny = fieldmesh->LocalNy;
+    nz = fieldmesh->LocalNz;
+  }
+}
+
+Field3DF::Field3DF(const Field3D& f)
+    : Field3DF(f.getMesh(), f.getLocation(), f.getDirections()) {
+  *this = f;
+}
+
+Field3DF& Field3DF::allocate() {
+  if (data.empty()) {
+    if (!fieldmesh) {
+      fieldmesh = bout::globals::mesh;
+      nx = fieldmesh->LocalNx;
+      ny = fieldmesh->LocalNy;
+      nz = fieldmesh->LocalNz;
+    }
+    data.reallocate(nx * ny * nz);
+  } else {
+    data.ensureUnique();
+  }
+  return *this;
+}
+
+Field3DF& Field3DF::operator=(const Field3D& f) {
+  TRACE("Field3DF = Field3D");
+
+  if (!f.isAllocated() || (fieldmesh != f.getMesh())) {
+    // No data to copy, or sizes may be different
+    data.clear();
+  }
+  // Take the mesh, location and directions even if there is no data
+  Field::operator=(f);
+  nx = f.getNx();
+  ny = f.getNy();
+  nz = f.getNz();
+
+  if (!f.isAllocated()) {
+    return *this;
+  }
+
+  allocate();
+
+  BOUT_FOR(i, getRegion("RGN_ALL")) { data[i.ind] = static_cast<float>(f[i]); }
+
+  return *this;
+}
+
+Field3DF& Field3DF::operator=(BoutReal val) {
+  TRACE("Field3DF = BoutReal");
+
+  allocate();
+
+  const auto value = static_cast<float>(val);
+  BOUT_FOR(i, getRegion("RGN_ALL")) { data[i.ind] = value; }
+
+  return *this;
+}
+
+Field3D Field3DF::toField3D() const {
+  TRACE("Field3DF::toField3D");
+
+  Field3D result{fieldmesh, location, directions};
+  if (!isAllocated()) {
+    return result;
+  }
+  result.allocate();
+
+  BOUT_FOR(i, getRegion("RGN_ALL")) { result[i] = data[i.ind]; }
+
+  return result;
+}
+
+const Region<Ind3D>& Field3DF::getRegion(const std::string& region_name) const {
+  return fieldmesh->getRegion3D(region_name);
+}
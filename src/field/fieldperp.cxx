@@ -103,6 +103,9 @@ const Region<IndPerp> &FieldPerp::getRegion(REGION region) const {
 const Region<IndPerp> &FieldPerp::getRegion(const std::string &region_name) const {
   return fieldmesh->getRegionPerp(region_name);
 };
+const Region<IndPerp> &FieldPerp::getRegion(RegionID region) const {
+  return fieldmesh->getRegionPerp(region);
+};
 
 //////////////// NON-MEMBER FUNCTIONS //////////////////
 
@@ -60,6 +60,14 @@ operators = OrderedDict([
     ('-', 'subtraction'),
 ])
 
+# The node operation structs in bout/field_expr.hxx
+operator_structs = OrderedDict([
+    ('*', 'Multiply'),
+    ('/', 'Divide'),
+    ('+', 'Add'),
+    ('-', 'Subtract'),
+])
+
 header = """// This file is autogenerated - see gen_fieldops.py
 #include <bout/mesh.hxx>
 #include <bout/region.hxx>
@@ -67,6 +75,28 @@ header = """// This file is autogenerated - see gen_fieldops.py
 #include <field3d.hxx>
 #include <globals.hxx>
 #include <interpolation.hxx>
+
+namespace {
+/// Handle for the region all the operators loop over
+const RegionID region_all = Mesh::getRegionID("RGN_ALL");
+} // namespace
+"""
+
+expr_header = """// This file is autogenerated - see gen_fieldops.py
+// Binary operators for the lazy expressions in bout/field_expr.hxx,
+// which includes this file
+
+#ifndef __GENERATED_FIELDEXPR_H__
+#define __GENERATED_FIELDEXPR_H__
+
+namespace bout {
+namespace expr {
+"""
+
+expr_footer = """} // namespace expr
+} // namespace bout
+
+#endif // __GENERATED_FIELDEXPR_H__
 """
 
 
@@ -175,6 +205,108 @@ def returnType(f1, f2):
     else:
         return copy(field3D)
 
+
+class ExprOperand(object):
+    """An operand of the lazy expression operators: either an
+    expression, or a Field3D/Field2D/BoutReal which is wrapped in a
+    leaf node
+
+    """
+
+    def __init__(self, kind, name, param):
+        # "Expr", or the C++ type of the field
+        self.kind = kind
+        # name of this operand
+        self.name = name
+        # Name of the template parameter if this is an expression
+        self.param = param
+
+    @property
+    def node(self):
+        """The type of the expression node for this operand
+
+        """
+        if self.kind == "Expr":
+            return self.param
+        elif self.kind == "BoutReal":
+            return "Scalar"
+        else:
+            return "FieldLeaf<{self.kind}>".format(self=self)
+
+    @property
+    def argument(self):
+        """The type of the function argument, a reference except for
+        BoutReal
+
+        """
+        if self.kind == "Expr":
+            return "Expr<{self.param}>&".format(self=self)
+        elif self.kind == "BoutReal":
+            return "BoutReal"
+        else:
+            return "{self.kind}&".format(self=self)
+
+    @property
+    def wrapped(self):
+        """Converts the argument to its expression node
+
+        """
+        if self.kind == "Expr":
+            return "{self.name}.self()".format(self=self)
+        else:
+            return "{self.node}({self.name})".format(self=self)
+
+    def __eq__(self, other):
+        try:
+            return self.kind == other.kind
+        except AttributeError:
+            return self.kind == other
+
+    def __ne__(self, other):
+        return not (self == other)
+
+    def __str__(self):
+        return "expression" if self.kind == "Expr" else self.kind
+
+
+def write_expressions(filename, env):
+    """Write the binary operators for lazy expressions to filename.
+    At least one operand of each operator is an expression
+
+    """
+    template = env.get_template("gen_fieldexpr.jinja")
+    kinds = ["Expr", "Field3D", "Field2D", "BoutReal"]
+
+    with smart_open(filename, "w") as f:
+        f.write(expr_header)
+
+        for lhs_kind, rhs_kind in itertools.product(kinds, kinds):
+            if "Expr" not in (lhs_kind, rhs_kind):
+                continue
+            lhs = ExprOperand(lhs_kind, 'lhs', 'L')
+            rhs = ExprOperand(rhs_kind, 'rhs', 'R')
+            template_params = ", ".join("typename " + operand.param
+                                        for operand in (lhs, rhs)
+                                        if operand == "Expr")
+
+            for operator, operator_name in operators.items():
+                f.write("\n")
+                f.write(template.render(
+                    operator=operator,
+                    operator_name=operator_name,
+                    operator_struct=operator_structs[operator],
+                    # Match the non-lazy operators, which multiply by
+                    # the inverse when dividing by a BoutReal
+                    scale_by_inverse=(operator == '/' and rhs == "BoutReal"),
+                    template_params=template_params,
+                    lhs=lhs,
+                    rhs=rhs))
+                f.write("\n")
+
+        f.write("\n")
+        f.write(expr_footer)
+
+
 if __name__ == "__main__":
 
     parser = argparse.ArgumentParser(description="Generate code for the Field arithmetic operators")
@@ -185,13 +317,23 @@ if __name__ == "__main__":
     parser.add_argument("--no-openmp", action="store_false", default=False, dest = "noOpenMP", 
                         help="Don't use OpenMP compatible loops")
 
+    # Generate include/bout/generated_fieldexpr.hxx instead
+    parser.add_argument("--expressions", action="store_true", default=False,
+                        help="Generate the operators for lazy expressions")
+
     args = parser.parse_args()
 
+    if args.expressions:
+        env = jinja2.Environment(loader=jinja2.FileSystemLoader('.'),
+                                 trim_blocks=True)
+        write_expressions(args.filename, env)
+        sys.exit(0)
+
     #Setup
     index_var = 'index'
     jz_var = 'jz'
     mixed_base_ind_var = "base_ind"
-    region_name = '"RGN_ALL"'
+    region_name = 'region_all'
     
     if args.noOpenMP:
         region_loop = 'BOUT_FOR_SERIAL'
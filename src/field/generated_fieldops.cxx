@@ -6,6 +6,11 @@
 #include <globals.hxx>
 #include <interpolation.hxx>
 
+namespace {
+/// Handle for the region all the operators loop over
+const RegionID region_all = Mesh::getRegionID("RGN_ALL");
+} // namespace
+
 // Provide the C++ wrapper for multiplication of Field3D and Field3D
 Field3D operator*(const Field3D& lhs, const Field3D& rhs) {
   ASSERT1(areFieldsCompatible(lhs, rhs));
@@ -14,7 +19,7 @@ Field3D operator*(const Field3D& lhs, const Field3D& rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) {
+  BOUT_FOR(index, result.getRegion(region_all)) {
     result[index] = lhs[index] * rhs[index];
   }
 
@@ -36,7 +41,7 @@ Field3D& Field3D::operator*=(const Field3D& rhs) {
     checkData(*this);
     checkData(rhs);
 
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) { (*this)[index] *= rhs[index]; }
+    BOUT_FOR(index, this->getRegion(region_all)) { (*this)[index] *= rhs[index]; }
 
     checkData(*this);
 
@@ -54,7 +59,7 @@ Field3D operator/(const Field3D& lhs, const Field3D& rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) {
+  BOUT_FOR(index, result.getRegion(region_all)) {
     result[index] = lhs[index] / rhs[index];
   }
 
@@ -76,7 +81,7 @@ Field3D& Field3D::operator/=(const Field3D& rhs) {
     checkData(*this);
     checkData(rhs);
 
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) { (*this)[index] /= rhs[index]; }
+    BOUT_FOR(index, this->getRegion(region_all)) { (*this)[index] /= rhs[index]; }
 
     checkData(*this);
 
@@ -94,7 +99,7 @@ Field3D operator+(const Field3D& lhs, const Field3D& rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) {
+  BOUT_FOR(index, result.getRegion(region_all)) {
     result[index] = lhs[index] + rhs[index];
   }
 
@@ -116,7 +121,7 @@ Field3D& Field3D::operator+=(const Field3D& rhs) {
     checkData(*this);
     checkData(rhs);
 
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) { (*this)[index] += rhs[index]; }
+    BOUT_FOR(index, this->getRegion(region_all)) { (*this)[index] += rhs[index]; }
 
     checkData(*this);
 
@@ -134,7 +139,7 @@ Field3D operator-(const Field3D& lhs, const Field3D& rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) {
+  BOUT_FOR(index, result.getRegion(region_all)) {
     result[index] = lhs[index] - rhs[index];
   }
 
@@ -156,7 +161,7 @@ Field3D& Field3D::operator-=(const Field3D& rhs) {
     checkData(*this);
     checkData(rhs);
 
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) { (*this)[index] -= rhs[index]; }
+    BOUT_FOR(index, this->getRegion(region_all)) { (*this)[index] -= rhs[index]; }
 
     checkData(*this);
 
@@ -176,7 +181,7 @@ Field3D operator*(const Field3D& lhs, const Field2D& rhs) {
 
   Mesh* localmesh = lhs.getMesh();
 
-  BOUT_FOR(index, rhs.getRegion("RGN_ALL")) {
+  BOUT_FOR(index, rhs.getRegion(region_all)) {
     const auto base_ind = localmesh->ind2Dto3D(index);
     for (int jz = 0; jz < localmesh->LocalNz; ++jz) {
       result[base_ind + jz] = lhs[base_ind + jz] * rhs[index];
@@ -201,7 +206,7 @@ Field3D& Field3D::operator*=(const Field2D& rhs) {
     checkData(*this);
     checkData(rhs);
 
-    BOUT_FOR(index, rhs.getRegion("RGN_ALL")) {
+    BOUT_FOR(index, rhs.getRegion(region_all)) {
       const auto base_ind = fieldmesh->ind2Dto3D(index);
       for (int jz = 0; jz < fieldmesh->LocalNz; ++jz) {
         (*this)[base_ind + jz] *= rhs[index];
@@ -226,7 +231,7 @@ Field3D operator/(const Field3D& lhs, const Field2D& rhs) {
 
   Mesh* localmesh = lhs.getMesh();
 
-  BOUT_FOR(index, rhs.getRegion("RGN_ALL")) {
+  BOUT_FOR(index, rhs.getRegion(region_all)) {
     const auto base_ind = localmesh->ind2Dto3D(index);
     const auto tmp = 1.0 / rhs[index];
     for (int jz = 0; jz < localmesh->LocalNz; ++jz) {
@@ -252,7 +257,7 @@ Field3D& Field3D::operator/=(const Field2D& rhs) {
     checkData(*this);
     checkData(rhs);
 
-    BOUT_FOR(index, rhs.getRegion("RGN_ALL")) {
+    BOUT_FOR(index, rhs.getRegion(region_all)) {
       const auto base_ind = fieldmesh->ind2Dto3D(index);
       const auto tmp = 1.0 / rhs[index];
       for (int jz = 0; jz < fieldmesh->LocalNz; ++jz) {
@@ -278,7 +283,7 @@ Field3D operator+(const Field3D& lhs, const Field2D& rhs) {
 
   Mesh* localmesh = lhs.getMesh();
 
-  BOUT_FOR(index, rhs.getRegion("RGN_ALL")) {
+  BOUT_FOR(index, rhs.getRegion(region_all)) {
     const auto base_ind = localmesh->ind2Dto3D(index);
     for (int jz = 0; jz < localmesh->LocalNz; ++jz) {
       result[base_ind + jz] = lhs[base_ind + jz] + rhs[index];
@@ -303,7 +308,7 @@ Field3D& Field3D::operator+=(const Field2D& rhs) {
     checkData(*this);
     checkData(rhs);
 
-    BOUT_FOR(index, rhs.getRegion("RGN_ALL")) {
+    BOUT_FOR(index, rhs.getRegion(region_all)) {
       const auto base_ind = fieldmesh->ind2Dto3D(index);
       for (int jz = 0; jz < fieldmesh->LocalNz; ++jz) {
         (*this)[base_ind + jz] += rhs[index];
@@ -328,7 +333,7 @@ Field3D operator-(const Field3D& lhs, const Field2D& rhs) {
 
   Mesh* localmesh = lhs.getMesh();
 
-  BOUT_FOR(index, rhs.getRegion("RGN_ALL")) {
+  BOUT_FOR(index, rhs.getRegion(region_all)) {
     const auto base_ind = localmesh->ind2Dto3D(index);
     for (int jz = 0; jz < localmesh->LocalNz; ++jz) {
       result[base_ind + jz] = lhs[base_ind + jz] - rhs[index];
@@ -353,7 +358,7 @@ Field3D& Field3D::operator-=(const Field2D& rhs) {
     checkData(*this);
     checkData(rhs);
 
-    BOUT_FOR(index, rhs.getRegion("RGN_ALL")) {
+    BOUT_FOR(index, rhs.getRegion(region_all)) {
       const auto base_ind = fieldmesh->ind2Dto3D(index);
       for (int jz = 0; jz < fieldmesh->LocalNz; ++jz) {
         (*this)[base_ind + jz] -= rhs[index];
@@ -378,7 +383,7 @@ FieldPerp operator*(const Field3D& lhs, const FieldPerp& rhs) {
 
   Mesh* localmesh = lhs.getMesh();
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) {
+  BOUT_FOR(index, result.getRegion(region_all)) {
     int yind = rhs.getIndex();
     const auto base_ind = localmesh->indPerpto3D(index, yind);
     result[index] = lhs[base_ind] * rhs[index];
@@ -398,7 +403,7 @@ FieldPerp operator/(const Field3D& lhs, const FieldPerp& rhs) {
 
   Mesh* localmesh = lhs.getMesh();
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) {
+  BOUT_FOR(index, result.getRegion(region_all)) {
     int yind = rhs.getIndex();
     const auto base_ind = localmesh->indPerpto3D(index, yind);
     result[index] = lhs[base_ind] / rhs[index];
@@ -418,7 +423,7 @@ FieldPerp operator+(const Field3D& lhs, const FieldPerp& rhs) {
 
   Mesh* localmesh = lhs.getMesh();
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) {
+  BOUT_FOR(index, result.getRegion(region_all)) {
     int yind = rhs.getIndex();
     const auto base_ind = localmesh->indPerpto3D(index, yind);
     result[index] = lhs[base_ind] + rhs[index];
@@ -438,7 +443,7 @@ FieldPerp operator-(const Field3D& lhs, const FieldPerp& rhs) {
 
   Mesh* localmesh = lhs.getMesh();
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) {
+  BOUT_FOR(index, result.getRegion(region_all)) {
     int yind = rhs.getIndex();
     const auto base_ind = localmesh->indPerpto3D(index, yind);
     result[index] = lhs[base_ind] - rhs[index];
@@ -455,7 +460,7 @@ Field3D operator*(const Field3D& lhs, const BoutReal rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) { result[index] = lhs[index] * rhs; }
+  BOUT_FOR(index, result.getRegion(region_all)) { result[index] = lhs[index] * rhs; }
 
   checkData(result);
   return result;
@@ -474,7 +479,7 @@ Field3D& Field3D::operator*=(const BoutReal rhs) {
     checkData(*this);
     checkData(rhs);
 
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) { (*this)[index] *= rhs; }
+    BOUT_FOR(index, this->getRegion(region_all)) { (*this)[index] *= rhs; }
 
     checkData(*this);
 
@@ -492,7 +497,7 @@ Field3D operator/(const Field3D& lhs, const BoutReal rhs) {
   checkData(rhs);
 
   const auto tmp = 1.0 / rhs;
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) { result[index] = lhs[index] * tmp; }
+  BOUT_FOR(index, result.getRegion(region_all)) { result[index] = lhs[index] * tmp; }
 
   checkData(result);
   return result;
@@ -512,7 +517,7 @@ Field3D& Field3D::operator/=(const BoutReal rhs) {
     checkData(rhs);
 
     const auto tmp = 1.0 / rhs;
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) { (*this)[index] *= tmp; }
+    BOUT_FOR(index, this->getRegion(region_all)) { (*this)[index] *= tmp; }
 
     checkData(*this);
 
@@ -529,7 +534,7 @@ Field3D operator+(const Field3D& lhs, const BoutReal rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) { result[index] = lhs[index] + rhs; }
+  BOUT_FOR(index, result.getRegion(region_all)) { result[index] = lhs[index] + rhs; }
 
   checkData(result);
   return result;
@@ -548,7 +553,7 @@ Field3D& Field3D::operator+=(const BoutReal rhs) {
     checkData(*this);
     checkData(rhs);
 
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) { (*this)[index] += rhs; }
+    BOUT_FOR(index, this->getRegion(region_all)) { (*this)[index] += rhs; }
 
     checkData(*this);
 
@@ -565,7 +570,7 @@ Field3D operator-(const Field3D& lhs, const BoutReal rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) { result[index] = lhs[index] - rhs; }
+  BOUT_FOR(index, result.getRegion(region_all)) { result[index] = lhs[index] - rhs; }
 
   checkData(result);
   return result;
@@ -584,7 +589,7 @@ Field3D& Field3D::operator-=(const BoutReal rhs) {
     checkData(*this);
     checkData(rhs);
 
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) { (*this)[index] -= rhs; }
+    BOUT_FOR(index, this->getRegion(region_all)) { (*this)[index] -= rhs; }
 
     checkData(*this);
 
@@ -604,7 +609,7 @@ Field3D operator*(const Field2D& lhs, const Field3D& rhs) {
 
   Mesh* localmesh = lhs.getMesh();
 
-  BOUT_FOR(index, lhs.getRegion("RGN_ALL")) {
+  BOUT_FOR(index, lhs.getRegion(region_all)) {
     const auto base_ind = localmesh->ind2Dto3D(index);
     for (int jz = 0; jz < localmesh->LocalNz; ++jz) {
       result[base_ind + jz] = lhs[index] * rhs[base_ind + jz];
@@ -625,7 +630,7 @@ Field3D operator/(const Field2D& lhs, const Field3D& rhs) {
 
   Mesh* localmesh = lhs.getMesh();
 
-  BOUT_FOR(index, lhs.getRegion("RGN_ALL")) {
+  BOUT_FOR(index, lhs.getRegion(region_all)) {
     const auto base_ind = localmesh->ind2Dto3D(index);
     for (int jz = 0; jz < localmesh->LocalNz; ++jz) {
       result[base_ind + jz] = lhs[index] / rhs[base_ind + jz];
@@ -646,7 +651,7 @@ Field3D operator+(const Field2D& lhs, const Field3D& rhs) {
 
   Mesh* localmesh = lhs.getMesh();
 
-  BOUT_FOR(index, lhs.getRegion("RGN_ALL")) {
+  BOUT_FOR(index, lhs.getRegion(region_all)) {
     const auto base_ind = localmesh->ind2Dto3D(index);
     for (int jz = 0; jz < localmesh->LocalNz; ++jz) {
       result[base_ind + jz] = lhs[index] + rhs[base_ind + jz];
@@ -667,7 +672,7 @@ Field3D operator-(const Field2D& lhs, const Field3D& rhs) {
 
   Mesh* localmesh = lhs.getMesh();
 
-  BOUT_FOR(index, lhs.getRegion("RGN_ALL")) {
+  BOUT_FOR(index, lhs.getRegion(region_all)) {
     const auto base_ind = localmesh->ind2Dto3D(index);
     for (int jz = 0; jz < localmesh->LocalNz; ++jz) {
       result[base_ind + jz] = lhs[index] - rhs[base_ind + jz];
@@ -686,7 +691,7 @@ Field2D operator*(const Field2D& lhs, const Field2D& rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) {
+  BOUT_FOR(index, result.getRegion(region_all)) {
     result[index] = lhs[index] * rhs[index];
   }
 
@@ -704,7 +709,7 @@ Field2D& Field2D::operator*=(const Field2D& rhs) {
     checkData(*this);
     checkData(rhs);
 
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) { (*this)[index] *= rhs[index]; }
+    BOUT_FOR(index, this->getRegion(region_all)) { (*this)[index] *= rhs[index]; }
 
     checkData(*this);
 
@@ -722,7 +727,7 @@ Field2D operator/(const Field2D& lhs, const Field2D& rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) {
+  BOUT_FOR(index, result.getRegion(region_all)) {
     result[index] = lhs[index] / rhs[index];
   }
 
@@ -740,7 +745,7 @@ Field2D& Field2D::operator/=(const Field2D& rhs) {
     checkData(*this);
     checkData(rhs);
 
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) { (*this)[index] /= rhs[index]; }
+    BOUT_FOR(index, this->getRegion(region_all)) { (*this)[index] /= rhs[index]; }
 
     checkData(*this);
 
@@ -758,7 +763,7 @@ Field2D operator+(const Field2D& lhs, const Field2D& rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) {
+  BOUT_FOR(index, result.getRegion(region_all)) {
     result[index] = lhs[index] + rhs[index];
   }
 
@@ -776,7 +781,7 @@ Field2D& Field2D::operator+=(const Field2D& rhs) {
     checkData(*this);
     checkData(rhs);
 
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) { (*this)[index] += rhs[index]; }
+    BOUT_FOR(index, this->getRegion(region_all)) { (*this)[index] += rhs[index]; }
 
     checkData(*this);
 
@@ -794,7 +799,7 @@ Field2D operator-(const Field2D& lhs, const Field2D& rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) {
+  BOUT_FOR(index, result.getRegion(region_all)) {
     result[index] = lhs[index] - rhs[index];
   }
 
@@ -812,7 +817,7 @@ Field2D& Field2D::operator-=(const Field2D& rhs) {
     checkData(*this);
     checkData(rhs);
 
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) { (*this)[index] -= rhs[index]; }
+    BOUT_FOR(index, this->getRegion(region_all)) { (*this)[index] -= rhs[index]; }
 
     checkData(*this);
 
@@ -832,7 +837,7 @@ FieldPerp operator*(const Field2D& lhs, const FieldPerp& rhs) {
 
   Mesh* localmesh = lhs.getMesh();
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) {
+  BOUT_FOR(index, result.getRegion(region_all)) {
     int yind = rhs.getIndex();
     const auto base_ind = localmesh->indPerpto3D(index, yind);
     result[index] = lhs[base_ind] * rhs[index];
@@ -852,7 +857,7 @@ FieldPerp operator/(const Field2D& lhs, const FieldPerp& rhs) {
 
   Mesh* localmesh = lhs.getMesh();
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) {
+  BOUT_FOR(index, result.getRegion(region_all)) {
     int yind = rhs.getIndex();
     const auto base_ind = localmesh->indPerpto3D(index, yind);
     result[index] = lhs[base_ind] / rhs[index];
@@ -872,7 +877,7 @@ FieldPerp operator+(const Field2D& lhs, const FieldPerp& rhs) {
 
   Mesh* localmesh = lhs.getMesh();
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) {
+  BOUT_FOR(index, result.getRegion(region_all)) {
     int yind = rhs.getIndex();
     const auto base_ind = localmesh->indPerpto3D(index, yind);
     result[index] = lhs[base_ind] + rhs[index];
@@ -892,7 +897,7 @@ FieldPerp operator-(const Field2D& lhs, const FieldPerp& rhs) {
 
   Mesh* localmesh = lhs.getMesh();
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) {
+  BOUT_FOR(index, result.getRegion(region_all)) {
     int yind = rhs.getIndex();
     const auto base_ind = localmesh->indPerpto3D(index, yind);
     result[index] = lhs[base_ind] - rhs[index];
@@ -909,7 +914,7 @@ Field2D operator*(const Field2D& lhs, const BoutReal rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) { result[index] = lhs[index] * rhs; }
+  BOUT_FOR(index, result.getRegion(region_all)) { result[index] = lhs[index] * rhs; }
 
   checkData(result);
   return result;
@@ -924,7 +929,7 @@ Field2D& Field2D::operator*=(const BoutReal rhs) {
     checkData(*this);
     checkData(rhs);
 
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) { (*this)[index] *= rhs; }
+    BOUT_FOR(index, this->getRegion(region_all)) { (*this)[index] *= rhs; }
 
     checkData(*this);
 
@@ -942,7 +947,7 @@ Field2D operator/(const Field2D& lhs, const BoutReal rhs) {
   checkData(rhs);
 
   const auto tmp = 1.0 / rhs;
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) { result[index] = lhs[index] * tmp; }
+  BOUT_FOR(index, result.getRegion(region_all)) { result[index] = lhs[index] * tmp; }
 
   checkData(result);
   return result;
@@ -958,7 +963,7 @@ Field2D& Field2D::operator/=(const BoutReal rhs) {
     checkData(rhs);
 
     const auto tmp = 1.0 / rhs;
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) { (*this)[index] *= tmp; }
+    BOUT_FOR(index, this->getRegion(region_all)) { (*this)[index] *= tmp; }
 
     checkData(*this);
 
@@ -975,7 +980,7 @@ Field2D operator+(const Field2D& lhs, const BoutReal rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) { result[index] = lhs[index] + rhs; }
+  BOUT_FOR(index, result.getRegion(region_all)) { result[index] = lhs[index] + rhs; }
 
   checkData(result);
   return result;
@@ -990,7 +995,7 @@ Field2D& Field2D::operator+=(const BoutReal rhs) {
     checkData(*this);
     checkData(rhs);
 
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) { (*this)[index] += rhs; }
+    BOUT_FOR(index, this->getRegion(region_all)) { (*this)[index] += rhs; }
 
     checkData(*this);
 
@@ -1007,7 +1012,7 @@ Field2D operator-(const Field2D& lhs, const BoutReal rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) { result[index] = lhs[index] - rhs; }
+  BOUT_FOR(index, result.getRegion(region_all)) { result[index] = lhs[index] - rhs; }
 
   checkData(result);
   return result;
@@ -1022,7 +1027,7 @@ Field2D& Field2D::operator-=(const BoutReal rhs) {
     checkData(*this);
     checkData(rhs);
 
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) { (*this)[index] -= rhs; }
+    BOUT_FOR(index, this->getRegion(region_all)) { (*this)[index] -= rhs; }
 
     checkData(*this);
 
@@ -1042,7 +1047,7 @@ FieldPerp operator*(const FieldPerp& lhs, const Field3D& rhs) {
 
   Mesh* localmesh = lhs.getMesh();
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) {
+  BOUT_FOR(index, result.getRegion(region_all)) {
     int yind = lhs.getIndex();
     const auto base_ind = localmesh->indPerpto3D(index, yind);
     result[index] = lhs[index] * rhs[base_ind];
@@ -1064,7 +1069,7 @@ FieldPerp& FieldPerp::operator*=(const Field3D& rhs) {
 
     Mesh* localmesh = this->getMesh();
 
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) {
+    BOUT_FOR(index, this->getRegion(region_all)) {
       int yind = this->getIndex();
       const auto base_ind = localmesh->indPerpto3D(index, yind);
       (*this)[index] *= rhs[base_ind];
@@ -1088,7 +1093,7 @@ FieldPerp operator/(const FieldPerp& lhs, const Field3D& rhs) {
 
   Mesh* localmesh = lhs.getMesh();
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) {
+  BOUT_FOR(index, result.getRegion(region_all)) {
     int yind = lhs.getIndex();
     const auto base_ind = localmesh->indPerpto3D(index, yind);
     result[index] = lhs[index] / rhs[base_ind];
@@ -1110,7 +1115,7 @@ FieldPerp& FieldPerp::operator/=(const Field3D& rhs) {
 
     Mesh* localmesh = this->getMesh();
 
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) {
+    BOUT_FOR(index, this->getRegion(region_all)) {
       int yind = this->getIndex();
       const auto base_ind = localmesh->indPerpto3D(index, yind);
       (*this)[index] /= rhs[base_ind];
@@ -1134,7 +1139,7 @@ FieldPerp operator+(const FieldPerp& lhs, const Field3D& rhs) {
 
   Mesh* localmesh = lhs.getMesh();
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) {
+  BOUT_FOR(index, result.getRegion(region_all)) {
     int yind = lhs.getIndex();
     const auto base_ind = localmesh->indPerpto3D(index, yind);
     result[index] = lhs[index] + rhs[base_ind];
@@ -1156,7 +1161,7 @@ FieldPerp& FieldPerp::operator+=(const Field3D& rhs) {
 
     Mesh* localmesh = this->getMesh();
 
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) {
+    BOUT_FOR(index, this->getRegion(region_all)) {
       int yind = this->getIndex();
       const auto base_ind = localmesh->indPerpto3D(index, yind);
       (*this)[index] += rhs[base_ind];
@@ -1180,7 +1185,7 @@ FieldPerp operator-(const FieldPerp& lhs, const Field3D& rhs) {
 
   Mesh* localmesh = lhs.getMesh();
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) {
+  BOUT_FOR(index, result.getRegion(region_all)) {
     int yind = lhs.getIndex();
     const auto base_ind = localmesh->indPerpto3D(index, yind);
     result[index] = lhs[index] - rhs[base_ind];
@@ -1202,7 +1207,7 @@ FieldPerp& FieldPerp::operator-=(const Field3D& rhs) {
 
     Mesh* localmesh = this->getMesh();
 
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) {
+    BOUT_FOR(index, this->getRegion(region_all)) {
       int yind = this->getIndex();
       const auto base_ind = localmesh->indPerpto3D(index, yind);
       (*this)[index] -= rhs[base_ind];
@@ -1226,7 +1231,7 @@ FieldPerp operator*(const FieldPerp& lhs, const Field2D& rhs) {
 
   Mesh* localmesh = lhs.getMesh();
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) {
+  BOUT_FOR(index, result.getRegion(region_all)) {
     int yind = lhs.getIndex();
     const auto base_ind = localmesh->indPerpto3D(index, yind);
     result[index] = lhs[index] * rhs[base_ind];
@@ -1248,7 +1253,7 @@ FieldPerp& FieldPerp::operator*=(const Field2D& rhs) {
 
     Mesh* localmesh = this->getMesh();
 
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) {
+    BOUT_FOR(index, this->getRegion(region_all)) {
       int yind = this->getIndex();
       const auto base_ind = localmesh->indPerpto3D(index, yind);
       (*this)[index] *= rhs[base_ind];
@@ -1272,7 +1277,7 @@ FieldPerp operator/(const FieldPerp& lhs, const Field2D& rhs) {
 
   Mesh* localmesh = lhs.getMesh();
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) {
+  BOUT_FOR(index, result.getRegion(region_all)) {
     int yind = lhs.getIndex();
     const auto base_ind = localmesh->indPerpto3D(index, yind);
     result[index] = lhs[index] / rhs[base_ind];
@@ -1294,7 +1299,7 @@ FieldPerp& FieldPerp::operator/=(const Field2D& rhs) {
 
     Mesh* localmesh = this->getMesh();
 
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) {
+    BOUT_FOR(index, this->getRegion(region_all)) {
       int yind = this->getIndex();
       const auto base_ind = localmesh->indPerpto3D(index, yind);
       (*this)[index] /= rhs[base_ind];
@@ -1318,7 +1323,7 @@ FieldPerp operator+(const FieldPerp& lhs, const Field2D& rhs) {
 
   Mesh* localmesh = lhs.getMesh();
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) {
+  BOUT_FOR(index, result.getRegion(region_all)) {
     int yind = lhs.getIndex();
     const auto base_ind = localmesh->indPerpto3D(index, yind);
     result[index] = lhs[index] + rhs[base_ind];
@@ -1340,7 +1345,7 @@ FieldPerp& FieldPerp::operator+=(const Field2D& rhs) {
 
     Mesh* localmesh = this->getMesh();
 
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) {
+    BOUT_FOR(index, this->getRegion(region_all)) {
       int yind = this->getIndex();
       const auto base_ind = localmesh->indPerpto3D(index, yind);
       (*this)[index] += rhs[base_ind];
@@ -1364,7 +1369,7 @@ FieldPerp operator-(const FieldPerp& lhs, const Field2D& rhs) {
 
   Mesh* localmesh = lhs.getMesh();
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) {
+  BOUT_FOR(index, result.getRegion(region_all)) {
     int yind = lhs.getIndex();
     const auto base_ind = localmesh->indPerpto3D(index, yind);
     result[index] = lhs[index] - rhs[base_ind];
@@ -1386,7 +1391,7 @@ FieldPerp& FieldPerp::operator-=(const Field2D& rhs) {
 
     Mesh* localmesh = this->getMesh();
 
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) {
+    BOUT_FOR(index, this->getRegion(region_all)) {
       int yind = this->getIndex();
       const auto base_ind = localmesh->indPerpto3D(index, yind);
       (*this)[index] -= rhs[base_ind];
@@ -1408,7 +1413,7 @@ FieldPerp operator*(const FieldPerp& lhs, const FieldPerp& rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) {
+  BOUT_FOR(index, result.getRegion(region_all)) {
     result[index] = lhs[index] * rhs[index];
   }
 
@@ -1426,7 +1431,7 @@ FieldPerp& FieldPerp::operator*=(const FieldPerp& rhs) {
     checkData(*this);
     checkData(rhs);
 
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) { (*this)[index] *= rhs[index]; }
+    BOUT_FOR(index, this->getRegion(region_all)) { (*this)[index] *= rhs[index]; }
 
     checkData(*this);
 
@@ -1444,7 +1449,7 @@ FieldPerp operator/(const FieldPerp& lhs, const FieldPerp& rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) {
+  BOUT_FOR(index, result.getRegion(region_all)) {
     result[index] = lhs[index] / rhs[index];
   }
 
@@ -1462,7 +1467,7 @@ FieldPerp& FieldPerp::operator/=(const FieldPerp& rhs) {
     checkData(*this);
     checkData(rhs);
 
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) { (*this)[index] /= rhs[index]; }
+    BOUT_FOR(index, this->getRegion(region_all)) { (*this)[index] /= rhs[index]; }
 
     checkData(*this);
 
@@ -1480,7 +1485,7 @@ FieldPerp operator+(const FieldPerp& lhs, const FieldPerp& rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) {
+  BOUT_FOR(index, result.getRegion(region_all)) {
     result[index] = lhs[index] + rhs[index];
   }
 
@@ -1498,7 +1503,7 @@ FieldPerp& FieldPerp::operator+=(const FieldPerp& rhs) {
     checkData(*this);
     checkData(rhs);
 
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) { (*this)[index] += rhs[index]; }
+    BOUT_FOR(index, this->getRegion(region_all)) { (*this)[index] += rhs[index]; }
 
     checkData(*this);
 
@@ -1516,7 +1521,7 @@ FieldPerp operator-(const FieldPerp& lhs, const FieldPerp& rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) {
+  BOUT_FOR(index, result.getRegion(region_all)) {
     result[index] = lhs[index] - rhs[index];
   }
 
@@ -1534,7 +1539,7 @@ FieldPerp& FieldPerp::operator-=(const FieldPerp& rhs) {
     checkData(*this);
     checkData(rhs);
 
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) { (*this)[index] -= rhs[index]; }
+    BOUT_FOR(index, this->getRegion(region_all)) { (*this)[index] -= rhs[index]; }
 
     checkData(*this);
 
@@ -1551,7 +1556,7 @@ FieldPerp operator*(const FieldPerp& lhs, const BoutReal rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) { result[index] = lhs[index] * rhs; }
+  BOUT_FOR(index, result.getRegion(region_all)) { result[index] = lhs[index] * rhs; }
 
   checkData(result);
   return result;
@@ -1566,7 +1571,7 @@ FieldPerp& FieldPerp::operator*=(const BoutReal rhs) {
     checkData(*this);
     checkData(rhs);
 
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) { (*this)[index] *= rhs; }
+    BOUT_FOR(index, this->getRegion(region_all)) { (*this)[index] *= rhs; }
 
     checkData(*this);
 
@@ -1584,7 +1589,7 @@ FieldPerp operator/(const FieldPerp& lhs, const BoutReal rhs) {
   checkData(rhs);
 
   const auto tmp = 1.0 / rhs;
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) { result[index] = lhs[index] * tmp; }
+  BOUT_FOR(index, result.getRegion(region_all)) { result[index] = lhs[index] * tmp; }
 
   checkData(result);
   return result;
@@ -1599,7 +1604,7 @@ FieldPerp& FieldPerp::operator/=(const BoutReal rhs) {
     checkData(*this);
     checkData(rhs);
 
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) { (*this)[index] /= rhs; }
+    BOUT_FOR(index, this->getRegion(region_all)) { (*this)[index] /= rhs; }
 
     checkData(*this);
 
@@ -1616,7 +1621,7 @@ FieldPerp operator+(const FieldPerp& lhs, const BoutReal rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) { result[index] = lhs[index] + rhs; }
+  BOUT_FOR(index, result.getRegion(region_all)) { result[index] = lhs[index] + rhs; }
 
   checkData(result);
   return result;
@@ -1631,7 +1636,7 @@ FieldPerp& FieldPerp::operator+=(const BoutReal rhs) {
     checkData(*this);
     checkData(rhs);
 
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) { (*this)[index] += rhs; }
+    BOUT_FOR(index, this->getRegion(region_all)) { (*this)[index] += rhs; }
 
     checkData(*this);
 
@@ -1648,7 +1653,7 @@ FieldPerp operator-(const FieldPerp& lhs, const BoutReal rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) { result[index] = lhs[index] - rhs; }
+  BOUT_FOR(index, result.getRegion(region_all)) { result[index] = lhs[index] - rhs; }
 
   checkData(result);
   return result;
@@ -1663,7 +1668,7 @@ FieldPerp& FieldPerp::operator-=(const BoutReal rhs) {
     checkData(*this);
     checkData(rhs);
 
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) { (*this)[index] -= rhs; }
+    BOUT_FOR(index, this->getRegion(region_all)) { (*this)[index] -= rhs; }
 
     checkData(*this);
 
@@ -1680,7 +1685,7 @@ Field3D operator*(const BoutReal lhs, const Field3D& rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) { result[index] = lhs * rhs[index]; }
+  BOUT_FOR(index, result.getRegion(region_all)) { result[index] = lhs * rhs[index]; }
 
   checkData(result);
   return result;
@@ -1693,7 +1698,7 @@ Field3D operator/(const BoutReal lhs, const Field3D& rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) { result[index] = lhs / rhs[index]; }
+  BOUT_FOR(index, result.getRegion(region_all)) { result[index] = lhs / rhs[index]; }
 
   checkData(result);
   return result;
@@ -1706,7 +1711,7 @@ Field3D operator+(const BoutReal lhs, const Field3D& rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) { result[index] = lhs + rhs[index]; }
+  BOUT_FOR(index, result.getRegion(region_all)) { result[index] = lhs + rhs[index]; }
 
   checkData(result);
   return result;
@@ -1719,7 +1724,7 @@ Field3D operator-(const BoutReal lhs, const Field3D& rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) { result[index] = lhs - rhs[index]; }
+  BOUT_FOR(index, result.getRegion(region_all)) { result[index] = lhs - rhs[index]; }
 
   checkData(result);
   return result;
@@ -1732,7 +1737,7 @@ Field2D operator*(const BoutReal lhs, const Field2D& rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) { result[index] = lhs * rhs[index]; }
+  BOUT_FOR(index, result.getRegion(region_all)) { result[index] = lhs * rhs[index]; }
 
   checkData(result);
   return result;
@@ -1745,7 +1750,7 @@ Field2D operator/(const BoutReal lhs, const Field2D& rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) { result[index] = lhs / rhs[index]; }
+  BOUT_FOR(index, result.getRegion(region_all)) { result[index] = lhs / rhs[index]; }
 
   checkData(result);
   return result;
@@ -1758,7 +1763,7 @@ Field2D operator+(const BoutReal lhs, const Field2D& rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) { result[index] = lhs + rhs[index]; }
+  BOUT_FOR(index, result.getRegion(region_all)) { result[index] = lhs + rhs[index]; }
 
   checkData(result);
   return result;
@@ -1771,7 +1776,7 @@ Field2D operator-(const BoutReal lhs, const Field2D& rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) { result[index] = lhs - rhs[index]; }
+  BOUT_FOR(index, result.getRegion(region_all)) { result[index] = lhs - rhs[index]; }
 
   checkData(result);
   return result;
@@ -1784,7 +1789,7 @@ FieldPerp operator*(const BoutReal lhs, const FieldPerp& rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) { result[index] = lhs * rhs[index]; }
+  BOUT_FOR(index, result.getRegion(region_all)) { result[index] = lhs * rhs[index]; }
 
   checkData(result);
   return result;
@@ -1797,7 +1802,7 @@ FieldPerp operator/(const BoutReal lhs, const FieldPerp& rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) { result[index] = lhs / rhs[index]; }
+  BOUT_FOR(index, result.getRegion(region_all)) { result[index] = lhs / rhs[index]; }
 
   checkData(result);
   return result;
@@ -1810,7 +1815,7 @@ FieldPerp operator+(const BoutReal lhs, const FieldPerp& rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) { result[index] = lhs + rhs[index]; }
+  BOUT_FOR(index, result.getRegion(region_all)) { result[index] = lhs + rhs[index]; }
 
   checkData(result);
   return result;
@@ -1823,7 +1828,7 @@ FieldPerp operator-(const BoutReal lhs, const FieldPerp& rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) { result[index] = lhs - rhs[index]; }
+  BOUT_FOR(index, result.getRegion(region_all)) { result[index] = lhs - rhs[index]; }
 
   checkData(result);
   return result;
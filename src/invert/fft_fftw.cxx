@@ -33,9 +33,22 @@
 #ifdef BOUT_HAS_FFTW
 #include <bout/constants.hxx>
 #include <bout/openmpwrap.hxx>
+#include <bout/sys/timer.hxx>
+#include <boutcomm.hxx>
+#include <boutexception.hxx>
+#include <output.hxx>
 
 #include <fftw3.h>
+#include <atomic>
 #include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <tuple>
+#include <vector>
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -51,6 +64,8 @@ namespace fft {
 bool fft_initialised{false};
 /// Should FFTW find an optimised plan by measuring various plans?
 bool fft_measure{false};
+/// File to read FFTW wisdom from and save it to. Not used if empty
+std::string fft_wisdom_file;
 
 void fft_init(Options* options) {
   if (fft_initialised) {
@@ -70,286 +85,405 @@ void fft_init(bool fft_measure) {
 }
 
 /***********************************************************
- * Real FFTs
+ * Plan registry
  ***********************************************************/
 
-#ifndef _OPENMP
-// Serial code
-void rfft(MAYBE_UNUSED(const BoutReal *in), MAYBE_UNUSED(int length), MAYBE_UNUSED(dcomplex *out)) {
-#ifndef BOUT_HAS_FFTW
-  throw BoutException("This instance of BOUT++ has been compiled without fftw support.");
+#ifdef BOUT_HAS_FFTW
+namespace {
+/// Identifies a plan in the registry
+///
+/// FFTW plans may only be executed on arrays with the same alignment
+/// as the ones they were created with, and each plan has a working
+/// array which can only be used by one thread at a time, so plans
+/// belong to an OpenMP thread (see threadIndex)
+struct PlanKey {
+  int length;            ///< Number of points in each real signal
+  int howmany;           ///< Number of signals
+  int stride;            ///< Distance between the starts of consecutive real signals
+  bool forward;          ///< Real-to-complex if true, complex-to-real otherwise
+  int alignment;         ///< fftw_alignment_of the real array
+  std::uint64_t thread;  ///< threadIndex of the thread which owns the plan
+
+  bool operator<(const PlanKey& other) const {
+    return std::tie(length, howmany, stride, forward, alignment, thread)
+           < std::tie(other.length, other.howmany, other.stride, other.forward,
+                      other.alignment, other.thread);
+  }
+};
+
+/// Identifies the calling thread by its nesting level, in the top 8
+/// bits, and its OpenMP thread number in each enclosing parallel
+/// region, 14 bits per level. The level is needed so that, for
+/// example, thread 1 at the top level and thread 1 inside thread 0 of
+/// a nested region, which can run at the same time, get different
+/// keys. Unlike an OS thread id this is reused when the OpenMP runtime
+/// creates new threads, so the registry holds at most one set of plans
+/// per thread position.
+std::uint64_t threadIndex() {
+#ifdef _OPENMP
+  constexpr int bits_per_level = 14;
+  constexpr int max_level = 4;
+  const int nesting = omp_get_level();
+  std::uint64_t index = static_cast<std::uint64_t>(nesting) << 56;
+  for (int level = 1; level <= nesting; ++level) {
+    const int thread = omp_get_ancestor_thread_num(level);
+    if ((level > max_level) or (thread >= (1 << bits_per_level))) {
+      // Can't be distinguished from other threads, so two threads
+      // could share a plan's working array
+      throw BoutException("FFT plans: OpenMP nested more than %d levels deep, or "
+                          "more than %d threads in a parallel region",
+                          max_level, 1 << bits_per_level);
+    }
+    index |= static_cast<std::uint64_t>(thread) << (bits_per_level * (max_level - level));
+  }
+  return index;
 #else
-  // static variables initialized once
-  static double *fin;
-  static fftw_complex *fout;
-  static fftw_plan p;
-  static int n = 0;
+  return 0;
+#endif
+}
 
-  // If the current length mismatches n
-  if(length != n) {
-    // If n has been used before
-    if(n > 0) {
-      // Free the previously initialized data
-      fftw_destroy_plan(p);
-      fftw_free(fin);
-      fftw_free(fout);
-    }
+/// A plan, along with the complex working array it is executed with
+struct PlanEntry {
+  fftw_plan plan;
+  fftw_complex* cmplx;
+};
+
+/// All the plans created so far. Only accessed inside the
+/// fft_plan_registry critical section
+std::map<PlanKey, PlanEntry> plan_registry;
+/// Incremented whenever the registry is cleared, so that the
+/// per-thread caches know to drop their pointers into it
+std::atomic<int> registry_generation{0};
+/// Have any plans been measured since the wisdom was loaded?
+bool new_wisdom{false};
+
+/// Find or create the plan for \p key. Must only be called inside the
+/// fft_plan_registry critical section, as FFTW planning is not thread safe
+const PlanEntry& findOrCreatePlan(const PlanKey& key) {
+  auto found = plan_registry.find(key);
+  if (found != plan_registry.end()) {
+    return found->second;
+  }
 
-    fft_init();
+  fft_init();
 
-    // Initialize the input for the fourier transformation
-    fin = (double*) fftw_malloc(sizeof(double) * length);
-    // Initialize the output of the fourier transformation
-    /* NOTE: Only the non-redundant output is given
-     *       I.e the offset and the positive frequencies (so no mirroring
-     *       around the Nyquist frequency)
-     */
-    fout = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * (length/2 + 1));
+  unsigned int flags = FFTW_ESTIMATE;
+  if (fft_measure) {
+    flags = FFTW_MEASURE;
+    new_wisdom = true;
+  }
 
-    unsigned int flags = FFTW_ESTIMATE;
-    if (fft_measure) {
-      flags = FFTW_MEASURE;
-    }
+  const int nmodes = (key.length / 2) + 1;
+
+  // Planning may overwrite the arrays, so plan using a scratch real
+  // array which is offset to have the same alignment as the caller's
+  const int offset = key.alignment / static_cast<int>(sizeof(double));
+  const int real_size = (key.howmany - 1) * key.stride + key.length;
+  auto* scratch = static_cast<double*>(fftw_malloc(sizeof(double) * (real_size + offset)));
+  double* real = scratch + offset;
+
+  auto* cmplx = static_cast<fftw_complex*>(
+      fftw_malloc(sizeof(fftw_complex) * nmodes * key.howmany));
+
+  fftw_plan plan;
+  if (key.forward) {
+    // Preserve the input, so the plan can be executed directly on the
+    // caller's data
+    plan = fftw_plan_many_dft_r2c(1, &key.length, key.howmany, real, nullptr, 1,
+                                  key.stride, cmplx, nullptr, 1, nmodes,
+                                  flags | FFTW_PRESERVE_INPUT);
+  } else {
+    plan = fftw_plan_many_dft_c2r(1, &key.length, key.howmany, cmplx, nullptr, 1,
+                                  nmodes, real, nullptr, 1, key.stride, flags);
+  }
 
-    /* fftw call
-     * Plan a real-input/complex-output discrete Fourier transform (DFT)
-     * in 1 dimensions. Returns a fftw_plan (containing pointers etc.)
-     * r2c = real to complex
-     */
-    p = fftw_plan_dft_r2c_1d(length, fin, fout, flags);
+  // Plans are always executed with the new-array interface, so the
+  // scratch array is no longer needed
+  fftw_free(scratch);
 
-    n = length;
+  return plan_registry.emplace(key, PlanEntry{plan, cmplx}).first->second;
+}
+
+/// Get the plan for transforming \p howmany real signals of \p length
+/// points, whose starts are \p stride apart, starting at \p real
+const PlanEntry& getPlan(int length, int howmany, int stride, bool forward,
+                         BoutReal* real) {
+  const PlanKey key{length,  howmany, stride, forward, fftw_alignment_of(real),
+                    threadIndex()};
+
+  // Per-thread cache of pointers into the registry, so that the
+  // common case of reusing a plan doesn't need the critical section
+  thread_local std::map<PlanKey, const PlanEntry*> cache;
+  thread_local int cache_generation{-1};
+
+  const int generation = registry_generation;
+  if (cache_generation != generation) {
+    cache.clear();
+    cache_generation = generation;
   }
 
-  // Put the input to fin
-  for(int i=0;i<n;i++)
-    fin[i] = in[i];
+  auto cached = cache.find(key);
+  if (cached != cache.end()) {
+    return *(cached->second);
+  }
 
-  // fftw call executing the fft
-  fftw_execute(p);
-  
-  //Normalising factor
-  const BoutReal fac = 1.0/((double) n);
-  const int nmodes = (n/2) + 1;
-
-  // Store the output in out, and normalize
-  for(int i=0;i<nmodes;i++)
-    out[i] = dcomplex(fout[i][0], fout[i][1]) * fac; // Normalise
+  // Time the planning, but not inside parallel regions as Timer isn't
+  // thread safe. The timer is kept out of the critical section
+#ifdef _OPENMP
+  const bool timed = omp_in_parallel() == 0;
+#else
+  const bool timed = true;
 #endif
+  std::unique_ptr<Timer> timer;
+  if (timed) {
+    timer.reset(new Timer("fftw_plan"));
+  }
+
+  const PlanEntry* entry;
+  BOUT_OMP(critical(fft_plan_registry))
+  { entry = &findOrCreatePlan(key); }
+
+  cache.emplace(key, entry);
+  return *entry;
 }
+} // namespace
+#endif
 
-void irfft(MAYBE_UNUSED(const dcomplex *in), MAYBE_UNUSED(int length), MAYBE_UNUSED(BoutReal *out)) {
+bool fft_import_wisdom(MAYBE_UNUSED(const std::string& filename)) {
 #ifndef BOUT_HAS_FFTW
-  throw BoutException("This instance of BOUT++ has been compiled without fftw support.");
+  return false;
 #else
-  // static variables initialized once
-  static fftw_complex *fin;
-  static double *fout;
-  static fftw_plan p;
-  static int n = 0;
-
-  // If the current length mismatches n
-  if(length != n) {
-    // If n has been used before
-    if(n > 0) {
-      // Free the previously initialized data
-      fftw_destroy_plan(p);
-      fftw_free(fin);
-      fftw_free(fout);
-    }
+  bool success;
+  BOUT_OMP(critical(fft_plan_registry))
+  { success = fftw_import_wisdom_from_filename(filename.c_str()) != 0; }
+  if (!success) {
+    output_warn.write("WARNING: Could not read FFTW wisdom from '%s'\n",
+                      filename.c_str());
+  }
+  return success;
+#endif
+}
 
-    fft_init();
+bool fft_export_wisdom(MAYBE_UNUSED(const std::string& filename)) {
+#ifndef BOUT_HAS_FFTW
+  return false;
+#else
+  bool success;
+  BOUT_OMP(critical(fft_plan_registry))
+  { success = fftw_export_wisdom_to_filename(filename.c_str()) != 0; }
+  if (!success) {
+    output_warn.write("WARNING: Could not write FFTW wisdom to '%s'\n",
+                      filename.c_str());
+  }
+  return success;
+#endif
+}
 
-    // Initilaize the input for the inverse fourier transformation
-    /* NOTE: Only the non-redundant input is given
-     *       I.e the offset and the positive frequencies (so no mirroring
-     *       around the Nyquist frequency)
-     */
-    fin = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * (length/2 + 1));
-    // Initialize the output of the fourier transformation
-    fout = (double*) fftw_malloc(sizeof(double) * length);
+bool fft_load_wisdom(MAYBE_UNUSED(Options* options)) {
+#ifndef BOUT_HAS_FFTW
+  return false;
+#else
+  fft_init();
+  if (options == nullptr) {
+    options = Options::getRoot()->getSection("fft");
+  }
+  fft_wisdom_file = (*options)["wisdom_file"]
+                        .doc("File to load FFTW wisdom from at startup and save it to "
+                             "at exit. Disabled if empty")
+                        .withDefault("");
+  if (fft_wisdom_file.empty()) {
+    return false;
+  }
 
-    unsigned int flags = FFTW_ESTIMATE;
-    if (fft_measure) {
-      flags = FFTW_MEASURE;
+  MPI_Comm comm = BoutComm::get();
+  int rank;
+  MPI_Comm_rank(comm, &rank);
+
+  // Only the first processor reads the file, which is then shared
+  // with all the others. A missing file is not an error, as it
+  // won't exist the first time the wisdom is used
+  std::string wisdom;
+  if (rank == 0) {
+    std::ifstream wisdom_stream(fft_wisdom_file);
+    if (wisdom_stream.good()) {
+      std::stringstream buffer;
+      buffer << wisdom_stream.rdbuf();
+      wisdom = buffer.str();
+    } else {
+      output_info.write("FFTW wisdom file '%s' not found\n", fft_wisdom_file.c_str());
     }
-
-    /* fftw call
-     * Plan a complex-input/real-output discrete Fourier transform (DFT)
-     * in 1 dimensions. Returns a fftw_plan (containing pointers etc.)
-     * c2r = complex to real
-     */
-    p = fftw_plan_dft_c2r_1d(length, fin, fout, flags);
-
-    n = length;
   }
 
-  // Store the real and imaginary parts in the proper way
-  const int nmodes = (n/2) + 1;
-  for(int i=0;i<nmodes;i++) {
-    fin[i][0] = in[i].real();
-    fin[i][1] = in[i].imag();
+  int length = static_cast<int>(wisdom.size());
+  MPI_Bcast(&length, 1, MPI_INT, 0, comm);
+  if (length == 0) {
+    return false;
   }
-
-  // fftw call executing the fft
-  fftw_execute(p);
-
-  // Store the output of the fftw to the out
-  for(int i=0;i<n;i++)
-    out[i] = fout[i];
+  wisdom.resize(length);
+  MPI_Bcast(&wisdom[0], length, MPI_CHAR, 0, comm);
+
+  bool success;
+  BOUT_OMP(critical(fft_plan_registry))
+  { success = fftw_import_wisdom_from_string(wisdom.c_str()) != 0; }
+  if (success) {
+    output_info.write("Loaded FFTW wisdom from '%s'\n", fft_wisdom_file.c_str());
+  } else {
+    output_warn.write("WARNING: Could not use FFTW wisdom from '%s'\n",
+                      fft_wisdom_file.c_str());
+  }
+  return success;
 #endif
 }
 
-#else
-// Parallel thread-safe version of rfft and irfft
-void rfft(MAYBE_UNUSED(const BoutReal *in), MAYBE_UNUSED(int length), MAYBE_UNUSED(dcomplex *out)) {
+bool fft_save_wisdom() {
 #ifndef BOUT_HAS_FFTW
-  throw BoutException("This instance of BOUT++ has been compiled without fftw support.");
+  return false;
 #else
-  static double *finall;
-  static fftw_complex *foutall;
-  static fftw_plan *p;
-  static int size = 0, nthreads = 0;
-
-  int th_id = omp_get_thread_num();
-  int n_th = omp_get_num_threads(); // Number of threads
-
-  // Sort out memory. Also, FFTW planning routines not thread safe
-  if ((size != length) || (nthreads < n_th)) {
-    // We make the check to see if the problem size has changed twice
-    // intentionally. The first check ensures we don't pay the cost of
-    // obtaining a lock for the critical section if we don't need to do
-    // any work here. The second check is required to make sure that
-    // only one thread does the actual setup when required. Note we can't
-    // use a `single` block here as that requires all threads to reach the
-    // block (implicit barrier) which may not be true in all cases (e.g.
-    // if there are 8 threads but only 4 call the fft routine).
-    BOUT_OMP(critical(rfft))
-    if ((size != length) || (nthreads < n_th)) {
-      if(size > 0) {
-        // Free all memory
-        for(int i=0;i<nthreads;i++)
-          fftw_destroy_plan(p[i]);
-        delete[] p;
-        fftw_free(finall);
-        fftw_free(foutall);
-      }
+  if (fft_wisdom_file.empty()) {
+    return false;
+  }
 
-      fft_init();
+  MPI_Comm comm = BoutComm::get();
 
-      finall = static_cast<double *>(fftw_malloc(sizeof(double) * length * n_th));
-      foutall = static_cast<fftw_complex *>(
-          fftw_malloc(sizeof(fftw_complex) * (length / 2 + 1) * n_th));
-      p = new fftw_plan[n_th]; //Never freed
+  // Only write the file if any processor has measured new plans
+  int local_new_wisdom = new_wisdom ? 1 : 0;
+  int any_new_wisdom;
+  MPI_Allreduce(&local_new_wisdom, &any_new_wisdom, 1, MPI_INT, MPI_LOR, comm);
+  if (any_new_wisdom == 0) {
+    return false;
+  }
 
-      unsigned int flags = FFTW_ESTIMATE;
-      if (fft_measure) {
-        flags = FFTW_MEASURE;
-      }
+  int rank, nprocs;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &nprocs);
+
+  // Processors may have measured plans for different sizes, so gather
+  // everyone's new wisdom onto the first processor to merge
+  std::string wisdom;
+  if (new_wisdom) {
+    char* exported;
+    BOUT_OMP(critical(fft_plan_registry))
+    { exported = fftw_export_wisdom_to_string(); }
+    if (exported != nullptr) {
+      wisdom = exported;
+      free(exported);
+    }
+  }
 
-      for(int i=0;i<n_th;i++)
-        // fftw call
-        // Plan a real-input/complex-output discrete Fourier transform (DFT)
-        // in 1 dimensions. Returns a fftw_plan (containing pointers etc.)
-        p[i] = fftw_plan_dft_r2c_1d(length, finall+i*length,
-                                    foutall+i*(length/2 + 1), flags);
-      size = length;
-      nthreads = n_th;
+  int length = static_cast<int>(wisdom.size());
+  std::vector<int> lengths(rank == 0 ? nprocs : 0);
+  MPI_Gather(&length, 1, MPI_INT, lengths.data(), 1, MPI_INT, 0, comm);
+
+  std::vector<int> offsets(lengths.size());
+  std::string all_wisdom;
+  if (rank == 0) {
+    int total = 0;
+    for (int proc = 0; proc < nprocs; ++proc) {
+      offsets[proc] = total;
+      total += lengths[proc];
+    }
+    all_wisdom.resize(total);
+  }
+  MPI_Gatherv(&wisdom[0], length, MPI_CHAR, &all_wisdom[0], lengths.data(),
+              offsets.data(), MPI_CHAR, 0, comm);
+
+  // Every processor returns whether the file was written
+  int saved = 0;
+  if (rank == 0) {
+    BOUT_OMP(critical(fft_plan_registry)) {
+      for (int proc = 1; proc < nprocs; ++proc) {
+        if (lengths[proc] > 0) {
+          fftw_import_wisdom_from_string(
+              all_wisdom.substr(offsets[proc], lengths[proc]).c_str());
+        }
+      }
+    }
+    if (fft_export_wisdom(fft_wisdom_file)) {
+      output_info.write("Saved FFTW wisdom to '%s'\n", fft_wisdom_file.c_str());
+      saved = 1;
     }
   }
+  MPI_Bcast(&saved, 1, MPI_INT, 0, comm);
 
-  // Get working arrays for this thread
-  double *fin = finall + th_id * size;
-  fftw_complex *fout = foutall + th_id * (size / 2 + 1);
+  new_wisdom = false;
+  return saved != 0;
+#endif
+}
 
-  for (int i = 0; i < size; i++)
-    fin[i] = in[i];
+void fft_cleanup() {
+#ifdef BOUT_HAS_FFTW
+  BOUT_OMP(critical(fft_plan_registry)) {
+    for (auto& entry : plan_registry) {
+      fftw_destroy_plan(entry.second.plan);
+      fftw_free(entry.second.cmplx);
+    }
+    plan_registry.clear();
+    ++registry_generation;
+  }
+#endif
+}
 
-  // fftw call executing the fft
-  fftw_execute(p[th_id]);
+/***********************************************************
+ * Real FFTs
+ ***********************************************************/
 
-  //Normalising factor
-  const BoutReal fac = 1.0 / static_cast<BoutReal>(size);
-  const int nmodes = (size / 2) + 1;
+void rfft(const BoutReal* in, int length, dcomplex* out) {
+  rfft(in, length, 1, length, out);
+}
 
-  for(int i=0;i<nmodes;i++)
-    out[i] = dcomplex(fout[i][0], fout[i][1]) * fac; // Normalise
-#endif
+void irfft(const dcomplex* in, int length, BoutReal* out) {
+  irfft(in, length, 1, length, out);
 }
 
-void irfft(MAYBE_UNUSED(const dcomplex *in), MAYBE_UNUSED(int length), MAYBE_UNUSED(BoutReal *out)) {
+void rfft(MAYBE_UNUSED(const BoutReal* in), MAYBE_UNUSED(int length),
+          MAYBE_UNUSED(int howmany), MAYBE_UNUSED(int stride),
+          MAYBE_UNUSED(dcomplex* out)) {
 #ifndef BOUT_HAS_FFTW
   throw BoutException("This instance of BOUT++ has been compiled without fftw support.");
 #else
-  static fftw_complex *finall;
-  static double *foutall;
-  static fftw_plan *p;
-  static int size = 0, nthreads = 0;
-
-  int th_id = omp_get_thread_num();
-  int n_th = omp_get_num_threads(); // Number of threads
-
-  // Sort out memory. Also, FFTW planning routines not thread safe
-  if ((size != length) || (nthreads < n_th)) {
-    // We make the check to see if the problem size has changed twice
-    // intentionally. The first check ensures we don't pay the cost of
-    // obtaining a lock for the critical section if we don't need to do
-    // any work here. The second check is required to make sure that
-    // only one thread does the actual setup when required. Note we can't
-    // use a `single` block here as that requires all threads to reach the
-    // block (implicit barrier) which may not be true in all cases (e.g.
-    // if there are 8 threads but only 4 call the fft routine).
-    BOUT_OMP(critical(irfft))
-    if ((size != length) || (nthreads < n_th)) {
-      if (size > 0) {
-        // Free all memory
-        for (int i = 0; i < nthreads; i++)
-          fftw_destroy_plan(p[i]);
-        delete[] p;
-        fftw_free(finall);
-        fftw_free(foutall);
-      }
-
-      fft_init();
+  ASSERT1(length > 0);
+  ASSERT1(howmany > 0);
+  ASSERT1(stride >= length);
 
-      finall = static_cast<fftw_complex *>(
-          fftw_malloc(sizeof(fftw_complex) * (length / 2 + 1) * n_th));
-      foutall = static_cast<double *>(fftw_malloc(sizeof(double) * length * n_th));
+  // The plan preserves its input, so can read the caller's data directly
+  auto* real = const_cast<BoutReal*>(in);
+  const auto& entry = getPlan(length, howmany, stride, true, real);
 
-      p = new fftw_plan[n_th]; // Never freed
+  fftw_execute_dft_r2c(entry.plan, real, entry.cmplx);
 
-      unsigned int flags = FFTW_ESTIMATE;
-      if (fft_measure) {
-        flags = FFTW_MEASURE;
-      }
+  // Normalising factor
+  const BoutReal fac = 1.0 / static_cast<BoutReal>(length);
+  const int nmodes = (length / 2) + 1;
 
-      for (int i = 0; i < n_th; i++)
-        p[i] = fftw_plan_dft_c2r_1d(length, finall + i * (length / 2 + 1),
-                                    foutall + i * length, flags);
-      size = length;
-      nthreads = n_th;
-    }
+  for (int i = 0; i < nmodes * howmany; i++) {
+    out[i] = dcomplex(entry.cmplx[i][0], entry.cmplx[i][1]) * fac;
   }
+#endif
+}
 
-  // Get working arrays for this thread
-  fftw_complex *fin = finall + th_id * (size / 2 + 1);
-  double *fout = foutall + th_id * size;
+void irfft(MAYBE_UNUSED(const dcomplex* in), MAYBE_UNUSED(int length),
+           MAYBE_UNUSED(int howmany), MAYBE_UNUSED(int stride),
+           MAYBE_UNUSED(BoutReal* out)) {
+#ifndef BOUT_HAS_FFTW
+  throw BoutException("This instance of BOUT++ has been compiled without fftw support.");
+#else
+  ASSERT1(length > 0);
+  ASSERT1(howmany > 0);
+  ASSERT1(stride >= length);
 
-  const int nmodes = (size / 2) + 1;
+  const auto& entry = getPlan(length, howmany, stride, false, out);
 
-  for(int i=0;i<nmodes;i++) {
-    fin[i][0] = in[i].real();
-    fin[i][1] = in[i].imag();
+  // c2r transforms overwrite their input, so copy it to the working
+  // array. The output is written straight into the caller's data
+  const int nmodes = (length / 2) + 1;
+  for (int i = 0; i < nmodes * howmany; i++) {
+    entry.cmplx[i][0] = in[i].real();
+    entry.cmplx[i][1] = in[i].imag();
   }
 
-  // fftw call executing the fft
-  fftw_execute(p[th_id]);
-
-  for (int i = 0; i < size; i++)
-    out[i] = fout[i];
+  fftw_execute_dft_c2r(entry.plan, entry.cmplx, out);
 #endif
 }
-#endif
 
 //  Discrete sine transforms (B Shanahan)
 
@@ -3,7 +3,9 @@
  *
  * \brief FFT + Tridiagonal solver in serial or parallel
  *
- * Not particularly optimised: Each y slice is solved sequentially
+ * Field3D inversions gather the systems for every kz mode of every
+ * local y slice into a single set, so that each inversion needs only
+ * one round of communication in X
  *
  * CHANGELOG
  * =========
@@ -41,9 +43,16 @@
 #include <bout/sys/timer.hxx>
 #include <bout/constants.hxx>
 #include <output.hxx>
+#include <bout/openmpwrap.hxx>
 
 #include "cyclic_laplace.hxx"
 
+#include <algorithm>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 LaplaceCyclic::LaplaceCyclic(Options *opt, const CELL_LOC loc, Mesh *mesh_in)
     : Laplacian(opt, loc, mesh_in), Acoef(0.0), C1coef(1.0), C2coef(1.0), Dcoef(1.0) {
   Acoef.setLocation(location);
@@ -84,11 +93,15 @@ LaplaceCyclic::LaplaceCyclic(Options *opt, const CELL_LOC loc, Mesh *mesh_in)
   // Create a cyclic reduction object, operating on dcomplex values
   cr = new CyclicReduce<dcomplex>(localmesh->getXcomm(), n);
   cr->setPeriodic(localmesh->periodicX);
+
+  cr3D = new CyclicReduce<dcomplex>(localmesh->getXcomm(), n);
+  cr3D->setPeriodic(localmesh->periodicX);
 }
 
 LaplaceCyclic::~LaplaceCyclic() {
-  // Delete tridiagonal solver
+  // Delete tridiagonal solvers
   delete cr;
+  delete cr3D;
 }
 
 FieldPerp LaplaceCyclic::solve(const FieldPerp& rhs, const FieldPerp& x0) {
@@ -359,8 +372,8 @@ Field3D LaplaceCyclic::solve(const Field3D& rhs, const Field3D& x0) {
     }
 
     // Solve tridiagonal systems
-    cr->setCoefs(a3D, b3D, c3D);
-    cr->solve(bcmplx3D, xcmplx3D);
+    cr3D->setCoefs(a3D, b3D, c3D);
+    cr3D->solve(bcmplx3D, xcmplx3D);
 
     // FFT back to real space
     BOUT_OMP(parallel) {
@@ -388,34 +401,51 @@ Field3D LaplaceCyclic::solve(const Field3D& rhs, const Field3D& x0) {
       }
     }
   } else {
-    BOUT_OMP(parallel) {
-      /// Create a local thread-scope working array
-      auto k1d = Array<dcomplex>(localmesh->LocalNz / 2 +
-                                 1); // ZFFT routine expects input of this length
+    // The Z-lines for consecutive Y at a given X are contiguous, so are
+    // transformed with a single batched FFT. Split Y into blocks so
+    // that there are at least as many (X, Y block) pairs as threads
+#ifdef _OPENMP
+    const int nthreads = omp_get_max_threads();
+#else
+    const int nthreads = 1;
+#endif
+    const int nyblocks = std::min(ny, (nthreads + nx - 1) / nx);
+    const int nblocks = nx * nyblocks;
 
-      // Loop over X and Y indices, including boundaries but not guard cells
-      // (unless periodic in x)
+    BOUT_OMP(parallel) {
+      /// Create a local thread-scope working array for a block of Y points
+      auto k2d = Matrix<dcomplex>(ny, localmesh->LocalNz / 2 +
+                                          1); // ZFFT routine expects input of this length
 
+      // Loop over X indices and Y blocks, including boundaries but not
+      // guard cells (unless periodic in x)
       BOUT_OMP(for)
-      for (int ind = 0; ind < nxny; ++ind) {
-        // ind = (ix - xs)*(ye - ys + 1) + (iy - ys)
-        int ix = xs + ind / ny;
-        int iy = ys + ind % ny;
+      for (int ind = 0; ind < nblocks; ++ind) {
+        // ind = (ix - xs) * nyblocks + block
+        int ix = xs + ind / nyblocks;
+        int block = ind % nyblocks;
+        int ystart = ys + (block * ny) / nyblocks;
+        int yend = ys + ((block + 1) * ny) / nyblocks; // One past the last
 
-        // Take FFT in Z direction, apply shift, and put result in k1d
+        // Take FFT in Z direction, apply shift, and put result in k2d
 
         if (((ix < inbndry) && (inner_boundary_flags & INVERT_SET) && localmesh->firstX()) ||
             ((localmesh->LocalNx - ix - 1 < outbndry) && (outer_boundary_flags & INVERT_SET) &&
              localmesh->lastX())) {
           // Use the values in x0 in the boundary
-          rfft(x0(ix, iy), localmesh->LocalNz, std::begin(k1d));
+          rfft(x0(ix, ystart), localmesh->LocalNz, yend - ystart, localmesh->LocalNz,
+               std::begin(k2d));
         } else {
-          rfft(rhs(ix, iy), localmesh->LocalNz, std::begin(k1d));
+          rfft(rhs(ix, ystart), localmesh->LocalNz, yend - ystart, localmesh->LocalNz,
+               std::begin(k2d));
         }
 
         // Copy into array, transposing so kz is first index
-        for (int kz = 0; kz < nmode; kz++)
-          bcmplx3D((iy - ys) * nmode + kz, ix - xs) = k1d[kz];
+        for (int iy = ystart; iy < yend; iy++) {
+          for (int kz = 0; kz < nmode; kz++) {
+            bcmplx3D((iy - ys) * nmode + kz, ix - xs) = k2d(iy - ystart, kz);
+          }
+        }
       }
 
       // Get elements of the tridiagonal matrix
@@ -437,34 +467,39 @@ Field3D LaplaceCyclic::solve(const Field3D& rhs, const Field3D& x0) {
     }
 
     // Solve tridiagonal systems
-    cr->setCoefs(a3D, b3D, c3D);
-    cr->solve(bcmplx3D, xcmplx3D);
+    cr3D->setCoefs(a3D, b3D, c3D);
+    cr3D->solve(bcmplx3D, xcmplx3D);
 
     // FFT back to real space
     BOUT_OMP(parallel) {
-      /// Create a local thread-scope working array
-      auto k1d = Array<dcomplex>((localmesh->LocalNz) / 2 +
-                                 1); // ZFFT routine expects input of this length
+      /// Create a local thread-scope working array for a block of Y points
+      auto k2d = Matrix<dcomplex>(ny, (localmesh->LocalNz) / 2 +
+                                          1); // ZFFT routine expects input of this length
 
       const bool zero_DC = global_flags & INVERT_ZERO_DC;
 
       BOUT_OMP(for nowait)
-      for (int ind = 0; ind < nxny; ++ind) { // Loop over X and Y
-        // ind = (ix - xs)*(ye - ys + 1) + (iy - ys)
-        int ix = xs + ind / ny;
-        int iy = ys + ind % ny;
-
-        if (zero_DC) {
-          k1d[0] = 0.;
+      for (int ind = 0; ind < nblocks; ++ind) { // Loop over X and Y blocks
+        // ind = (ix - xs) * nyblocks + block
+        int ix = xs + ind / nyblocks;
+        int block = ind % nyblocks;
+        int ystart = ys + (block * ny) / nyblocks;
+        int yend = ys + ((block + 1) * ny) / nyblocks; // One past the last
+
+        for (int iy = ystart; iy < yend; iy++) {
+          if (zero_DC) {
+            k2d(iy - ystart, 0) = 0.;
+          }
+
+          for (int kz = zero_DC; kz < nmode; kz++)
+            k2d(iy - ystart, kz) = xcmplx3D((iy - ys) * nmode + kz, ix - xs);
+
+          for (int kz = nmode; kz < localmesh->LocalNz / 2 + 1; kz++)
+            k2d(iy - ystart, kz) = 0.0; // Filtering out all higher harmonics
         }
 
-        for (int kz = zero_DC; kz < nmode; kz++)
-          k1d[kz] = xcmplx3D((iy - ys) * nmode + kz, ix - xs);
-
-        for (int kz = nmode; kz < localmesh->LocalNz / 2 + 1; kz++)
-          k1d[kz] = 0.0; // Filtering out all higher harmonics
-
-        irfft(std::begin(k1d), localmesh->LocalNz, x(ix, iy));
+        irfft(std::begin(k2d), localmesh->LocalNz, yend - ystart, localmesh->LocalNz,
+              x(ix, ystart));
       }
     }
   }
@@ -40,7 +40,8 @@ class LaplaceCyclic;
 
 /// Solves the 2D Laplacian equation using the CyclicReduce class
 /*!
- * 
+ * Field3D inversions solve all the local y-planes together, rather
+ * than one FieldPerp at a time
  */
 class LaplaceCyclic : public Laplacian {
 public:
@@ -100,7 +101,13 @@ private:
   
   bool dst;
   
-  CyclicReduce<dcomplex> *cr; ///< Tridiagonal solver
+  CyclicReduce<dcomplex> *cr; ///< Tridiagonal solver for a single y-plane
+
+  /// Tridiagonal solver for every kz mode of every y-plane at once, so
+  /// that a Field3D inversion needs a single round of communication.
+  /// Kept separate from \p cr so alternating FieldPerp and Field3D
+  /// solves don't have to resize the solver's arrays each time
+  CyclicReduce<dcomplex> *cr3D;
 };
 
 #endif // __SPT_H__
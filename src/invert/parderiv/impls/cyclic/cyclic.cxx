@@ -47,11 +47,45 @@
 #include <bout/surfaceiter.hxx>
 
 #include <cmath>
+#include <vector>
 
 InvertParCR::InvertParCR(Options *opt, Mesh *mesh_in)
   : InvertPar(opt, mesh_in), A(1.0), B(0.0), C(0.0), D(0.0), E(0.0) {
   // Number of k equations to solve for each x location
   nsys = 1 + (localmesh->LocalNz)/2; 
+
+  // Set up a solver for each flux surface
+  maxsize = localmesh->LocalNy - 2 * localmesh->ystart;
+  SurfaceIter surf(localmesh);
+  for (surf.first(); !surf.isDone(); surf.next()) {
+    // Test if open or closed field-lines
+    BoutReal ts = 0.0;
+    bool closed = surf.closed(ts);
+
+    // Number of rows
+    int y0 = 0;
+    int size = localmesh->LocalNy - 2 * localmesh->ystart; // If no boundaries
+    if (!closed) {
+      if (surf.firstY()) {
+        y0 += localmesh->ystart;
+        size += localmesh->ystart;
+      }
+      if (surf.lastY())
+        size += localmesh->ystart;
+    }
+    if (size > maxsize)
+      maxsize = size;
+
+    int rank, np;
+    MPI_Comm_rank(surf.communicator(), &rank);
+    MPI_Comm_size(surf.communicator(), &np);
+
+    surfaces.push_back({surf.xpos, y0, size, closed, ts, rank == 0, rank == np - 1, {},
+                        Matrix<dcomplex>(nsys, size), Matrix<dcomplex>(nsys, size)});
+    auto& cr = surfaces.back().cr;
+    cr.setup(surf.communicator(), size);
+    cr.setPeriodic(closed);
+  }
 }
 
 const Field3D InvertParCR::solve(const Field3D &f) {
@@ -64,57 +98,23 @@ const Field3D InvertParCR::solve(const Field3D &f) {
 
   Field3D alignedField = toFieldAligned(f, "RGN_NOX");
 
-  // Create cyclic reduction object
-  auto cr = bout::utils::make_unique<CyclicReduce<dcomplex>>();
-
-  // Find out if we are on a boundary
-  int size = localmesh->LocalNy - 2 * localmesh->ystart;
-  SurfaceIter surf(localmesh);
-  for(surf.first(); !surf.isDone(); surf.next()) {
-    int n = localmesh->LocalNy - 2 * localmesh->ystart;
-    if (!surf.closed()) {
-      // Open field line
-      if (surf.firstY())
-        n += localmesh->ystart;
-      if (surf.lastY())
-        n += localmesh->ystart;
-
-      if (n > size)
-        size = n; // Maximum size
-    }
-  }
-
   auto rhs = Matrix<dcomplex>(localmesh->LocalNy, nsys);
-  auto rhsk = Matrix<dcomplex>(nsys, size);
-  auto xk = Matrix<dcomplex>(nsys, size);
-  auto a = Matrix<dcomplex>(nsys, size);
-  auto b = Matrix<dcomplex>(nsys, size);
-  auto c = Matrix<dcomplex>(nsys, size);
+  auto a = Matrix<dcomplex>(nsys, maxsize);
+  auto b = Matrix<dcomplex>(nsys, maxsize);
+  auto c = Matrix<dcomplex>(nsys, maxsize);
+
+  // Loop over flux-surfaces, starting the solves
+  for (auto& surface : surfaces) {
+    const int x = surface.x;
+    const int y0 = surface.y0;
+    const int size = surface.size;
+    const bool closed = surface.closed;
+    const BoutReal ts = surface.ts;
+    const bool first = surface.first;
+    const bool last = surface.last;
+    auto& cr = surface.cr;
+    auto& rhsk = surface.rhsk;
 
-  // Loop over flux-surfaces
-  for (surf.first(); !surf.isDone(); surf.next()) {
-    int x = surf.xpos;
-    
-    // Test if open or closed field-lines
-    BoutReal ts;
-    bool closed = surf.closed(ts);
-
-    // Number of rows
-    int y0 = 0;
-    size = localmesh->LocalNy - 2 * localmesh->ystart; // If no boundaries
-    if(!closed) {
-      if(surf.firstY()) {
-        y0 += localmesh->ystart;
-        size += localmesh->ystart;
-      }
-      if(surf.lastY())
-        size += localmesh->ystart;
-    }
-      
-    // Setup CyclicReduce object
-    cr->setup(surf.communicator(), size);
-    cr->setPeriodic(closed);
-    
     // Take Fourier transform
     for (int y = 0; y < localmesh->LocalNy - 2 * localmesh->ystart; y++)
       rfft(alignedField(x, y + localmesh->ystart), localmesh->LocalNz, &rhs(y + y0, 0));
@@ -148,17 +148,14 @@ const Field3D InvertParCR::solve(const Field3D &f) {
 
     if(closed) {
       // Twist-shift
-      int rank, np;
-      MPI_Comm_rank(surf.communicator(), &rank);
-      MPI_Comm_size(surf.communicator(), &np);
-      if(rank == 0) {
+      if(first) {
         for(int k=0; k<nsys; k++) {
           BoutReal kwave=k*2.0*PI/coord->zlength(); // wave number is 1/[rad]
           dcomplex phase(cos(kwave*ts) , -sin(kwave*ts));
           a(k, 0) *= phase;
         }
       }
-      if(rank == np-1) {
+      if(last) {
         for(int k=0; k<nsys; k++) {
           BoutReal kwave=k*2.0*PI/coord->zlength(); // wave number is 1/[rad]
           dcomplex phase(cos(kwave*ts) , sin(kwave*ts));
@@ -167,7 +164,7 @@ const Field3D InvertParCR::solve(const Field3D &f) {
       }
     }else {
       // Open surface, so may have boundaries
-      if(surf.firstY()) {
+      if(first) {
         for(int k=0; k<nsys; k++) {
           for (int y = 0; y < localmesh->ystart; y++) {
             a(k, y) = 0.;
@@ -178,7 +175,7 @@ const Field3D InvertParCR::solve(const Field3D &f) {
           }
         }
       }
-      if(surf.lastY()) {
+      if(last) {
         for(int k=0; k<nsys; k++) {
           for (int y = size - localmesh->ystart; y < size; y++) {
             a(k, y) = -1.;
@@ -191,19 +188,26 @@ const Field3D InvertParCR::solve(const Field3D &f) {
       }
     }
     
-    // Solve cyclic tridiagonal system for each k
-    cr->setCoefs(a, b, c);
-    cr->solve(rhsk, xk);
+    // Start solving cyclic tridiagonal system for each k. The
+    // communication completes while the next surfaces are set up
+    cr.setCoefs(a, b, c);
+    cr.start(rhsk);
+  }
+
+  // Finish the solves, in the same order as they were started
+  for (auto& surface : surfaces) {
+    surface.cr.finish(surface.xk);
 
     // Put back into rhs array
     for(int k=0;k<nsys;k++) {
-      for(int y=0;y<size;y++)
-        rhs(y, k) = xk(k, y);
+      for(int y=0;y<surface.size;y++)
+        rhs(y, k) = surface.xk(k, y);
     }
     
     // Inverse Fourier transform 
-    for(int y=0;y<size;y++)
-      irfft(&rhs(y, 0), localmesh->LocalNz, result(x, y + localmesh->ystart - y0));
+    for(int y=0;y<surface.size;y++)
+      irfft(&rhs(y, 0), localmesh->LocalNz,
+            result(surface.x, y + localmesh->ystart - surface.y0));
   }
 
   return fromFieldAligned(result, "RGN_NOBNDRY");
@@ -43,6 +43,9 @@
 #include "dcomplex.hxx"
 #include <globals.hxx>
 #include "utils.hxx"
+#include <cyclic_reduction.hxx>
+
+#include <vector>
 
 class InvertParCR : public InvertPar {
 public:
@@ -81,6 +84,22 @@ private:
   Field2D A, B, C, D, E;
   
   int nsys;
+
+  /// The cyclic reduction solve for one flux surface. Each surface
+  /// has its own solver, so that the interface equations of one
+  /// surface can be exchanged while the next surface is reduced.
+  /// These are set up in the constructor and reused by every solve
+  struct SurfaceSolve {
+    int x, y0, size;
+    bool closed;
+    BoutReal ts; ///< Twist-shift angle, if closed
+    bool first, last; ///< First or last processor on the surface
+    CyclicReduce<dcomplex> cr;
+    Matrix<dcomplex> rhsk, xk;
+  };
+  std::vector<SurfaceSolve> surfaces;
+
+  int maxsize; ///< Largest number of rows on any surface
 };
 
 
@@ -7,6 +7,8 @@
 #include <bout/assert.hxx>
 #include <bout/constants.hxx>
 #include <bout/coordinates.hxx>
+#include <bout/deriv_store.hxx>
+#include <bout/openmpwrap.hxx>
 #include <msg_stack.hxx>
 #include <output.hxx>
 #include <utils.hxx>
@@ -644,6 +646,10 @@ int Coordinates::geometry(bool recalculate_staggered,
 
   output_progress.write("Calculating differential geometry terms\n");
 
+  // The cached Delp2 coefficients depend on the metric, so recalculate on next use
+  delp2_a = delp2_b = delp2_c = Tensor<dcomplex>{};
+  delp2_single_pass = defaultDerivativesAreC2();
+
   if (min(abs(dx)) < 1e-8)
     throw BoutException("dx magnitude less than 1e-8");
 
@@ -1288,6 +1294,77 @@ Field3D Coordinates::Grad2_par2(const Field3D& f, CELL_LOC outloc,
 
 #include <invert_laplace.hxx> // Delp2 uses same coefficients as inversion code
 
+bool Coordinates::defaultDerivativesAreC2() {
+  const auto& store = DerivativeStore<Field3D>::getInstance();
+  // Is the default method for this derivative the C2 one?
+  const auto isC2 = [&store](DERIV derivType, DIRECTION direction) {
+    return &store.getStandardDerivative("DEFAULT", direction, STAGGER::None, derivType)
+           == &store.getStandardDerivative("C2", direction, STAGGER::None, derivType);
+  };
+  return isC2(DERIV::Standard, DIRECTION::X) and isC2(DERIV::Standard, DIRECTION::Z)
+         and isC2(DERIV::StandardSecond, DIRECTION::X)
+         and isC2(DERIV::StandardSecond, DIRECTION::Z);
+}
+
+namespace {
+/// Non-FFT Delp2 of \p f with second order central differences, in a
+/// single pass over the field
+///
+/// This is the same as
+///
+///     G1 * DDX(f) + G3 * DDZ(f) + g11 * D2DX2(f) + g33 * D2DZ2(f)
+///       + 2 * g13 * D2DXDZ(f)
+///
+/// with the C2 methods, but reads the 3x3 stencil in X-Z once for each
+/// point instead of making ten passes over memory. The metric
+/// coefficients are combined once for each (x, y) point
+void delp2C2(const Coordinates& coords, const Field3D& f, Field3D& result) {
+  Mesh* localmesh = f.getMesh();
+  const int ny = localmesh->LocalNy;
+  const int nz = localmesh->LocalNz;
+  const int xoffset = ny * nz;
+  const BoutReal dz = coords.dz;
+
+  const BoutReal* in = &f(0, 0, 0);
+  BoutReal* out = &result(0, 0, 0);
+
+  BOUT_FOR(i, localmesh->getRegion2D("RGN_NOBNDRY")) {
+    const BoutReal dx = coords.dx[i];
+
+    // Coefficients of the differences in each direction
+    BoutReal cx = 0.5 * coords.G1[i] / dx;
+    if (coords.non_uniform) {
+      cx += 0.5 * coords.g11[i] * coords.d1_dx[i] / dx;
+    }
+    const BoutReal cxx = coords.g11[i] / (dx * dx);
+    const BoutReal cz = 0.5 * coords.G3[i] / dz;
+    const BoutReal czz = coords.g33[i] / (dz * dz);
+    const BoutReal cxz = 0.5 * coords.g13[i] / (dx * dz);
+
+    const int base = localmesh->ind2Dto3D(i).ind;
+    const BoutReal* fc = in + base;
+    const BoutReal* fxm = fc - xoffset;
+    const BoutReal* fxp = fc + xoffset;
+    BoutReal* res = out + base;
+
+    const auto point = [&](int jz, int jzm, int jzp) {
+      res[jz] = cx * (fxp[jz] - fxm[jz]) + cxx * (fxp[jz] + fxm[jz] - 2. * fc[jz])
+                + cz * (fc[jzp] - fc[jzm]) + czz * (fc[jzp] + fc[jzm] - 2. * fc[jz])
+                + cxz * ((fxp[jzp] - fxm[jzp]) - (fxp[jzm] - fxm[jzm]));
+    };
+
+    // Only the ends of the Z line need to wrap around
+    point(0, nz - 1, 1 % nz);
+    for (int jz = 1; jz < nz - 1; ++jz) {
+      point(jz, jz - 1, jz + 1);
+    }
+    if (nz > 1) {
+      point(nz - 1, nz - 2, 0);
+    }
+  }
+}
+} // namespace
+
 Field2D Coordinates::Delp2(const Field2D& f, CELL_LOC outloc, bool UNUSED(useFFT)) {
   TRACE("Coordinates::Delp2( Field2D )");
   ASSERT1(location == outloc || outloc == CELL_DEFAULT);
@@ -1297,6 +1374,30 @@ Field2D Coordinates::Delp2(const Field2D& f, CELL_LOC outloc, bool UNUSED(useFFT
   return result;
 }
 
+void Coordinates::calcDelp2Coefficients() {
+  if (not delp2_a.empty()) {
+    return;
+  }
+  TRACE("Coordinates::calcDelp2Coefficients");
+
+  const int nmodes = localmesh->LocalNz / 2 + 1;
+  delp2_a.reallocate(localmesh->LocalNy, localmesh->LocalNx, nmodes);
+  delp2_b.reallocate(localmesh->LocalNy, localmesh->LocalNx, nmodes);
+  delp2_c.reallocate(localmesh->LocalNy, localmesh->LocalNx, nmodes);
+  delp2_a = 0.0;
+  delp2_b = 0.0;
+  delp2_c = 0.0;
+
+  for (int jy = 0; jy < localmesh->LocalNy; jy++) {
+    for (int jx = localmesh->xstart; jx <= localmesh->xend; jx++) {
+      for (int jz = 0; jz < nmodes; jz++) {
+        laplace_tridag_coefs(jx, jy, jz, delp2_a(jy, jx, jz), delp2_b(jy, jx, jz),
+                             delp2_c(jy, jx, jz), nullptr, nullptr, location);
+      }
+    }
+  }
+}
+
 Field3D Coordinates::Delp2(const Field3D& f, CELL_LOC outloc, bool useFFT) {
   TRACE("Coordinates::Delp2( Field3D )");
 
@@ -1316,40 +1417,48 @@ Field3D Coordinates::Delp2(const Field3D& f, CELL_LOC outloc, bool useFFT) {
   Field3D result{emptyFrom(f).setLocation(outloc)};
 
   if (useFFT) {
-    int ncz = localmesh->LocalNz;
-
-    // Allocate memory
-    auto ft = Matrix<dcomplex>(localmesh->LocalNx, ncz / 2 + 1);
-    auto delft = Matrix<dcomplex>(localmesh->LocalNx, ncz / 2 + 1);
+    const int ncz = localmesh->LocalNz;
+    const int xstart = localmesh->xstart;
+    const int xend = localmesh->xend;
 
-    // Loop over all y indices
-    for (int jy = 0; jy < localmesh->LocalNy; jy++) {
+    calcDelp2Coefficients();
 
-      // Take forward FFT
+    BOUT_OMP(parallel) {
+      // Thread-local working arrays
+      auto ft = Matrix<dcomplex>(localmesh->LocalNx, ncz / 2 + 1);
+      auto delft = Matrix<dcomplex>(localmesh->LocalNx, ncz / 2 + 1);
 
-      for (int jx = 0; jx < localmesh->LocalNx; jx++)
-        rfft(&f(jx, jy, 0), ncz, &ft(jx, 0));
+      // Loop over all y indices
+      BOUT_OMP(for)
+      for (int jy = 0; jy < localmesh->LocalNy; jy++) {
 
-      // Loop over kz
-      for (int jz = 0; jz <= ncz / 2; jz++) {
+        // Take forward FFT of all the Z-lines at this y
+        rfft(&f(0, jy, 0), ncz, localmesh->LocalNx, localmesh->LocalNy * ncz, &ft(0, 0));
 
         // No smoothing in the x direction
-        for (int jx = localmesh->xstart; jx <= localmesh->xend; jx++) {
-          // Perform x derivative
-
-          dcomplex a, b, c;
-          laplace_tridag_coefs(jx, jy, jz, a, b, c, nullptr, nullptr, outloc);
-
-          delft(jx, jz) = a * ft(jx - 1, jz) + b * ft(jx, jz) + c * ft(jx + 1, jz);
+        for (int jx = xstart; jx <= xend; jx++) {
+          const dcomplex* a = &delp2_a(jy, jx, 0);
+          const dcomplex* b = &delp2_b(jy, jx, 0);
+          const dcomplex* c = &delp2_c(jy, jx, 0);
+          const dcomplex* ftm = &ft(jx - 1, 0);
+          const dcomplex* ftc = &ft(jx, 0);
+          const dcomplex* ftp = &ft(jx + 1, 0);
+          dcomplex* out = &delft(jx, 0);
+
+          // Loop over kz
+          for (int jz = 0; jz <= ncz / 2; jz++) {
+            out[jz] = a[jz] * ftm[jz] + b[jz] * ftc[jz] + c[jz] * ftp[jz];
+          }
         }
-      }
-
-      // Reverse FFT
-      for (int jx = localmesh->xstart; jx <= localmesh->xend; jx++) {
 
-        irfft(&delft(jx, 0), ncz, &result(jx, jy, 0));
+        // Reverse FFT
+        irfft(&delft(xstart, 0), ncz, xend - xstart + 1, localmesh->LocalNy * ncz,
+              &result(xstart, jy, 0));
       }
     }
+  } else if (not localmesh->IncIntShear and delp2_single_pass) {
+    // The default methods can be evaluated in a single pass
+    delp2C2(*this, f, result);
   } else {
     result = G1 * ::DDX(f, outloc) + G3 * ::DDZ(f, outloc) + g11 * ::D2DX2(f, outloc)
              + g33 * ::D2DZ2(f, outloc) + 2 * g13 * ::D2DXDZ(f, outloc);
@@ -1388,28 +1497,24 @@ FieldPerp Coordinates::Delp2(const FieldPerp& f, CELL_LOC outloc, bool useFFT) {
     auto ft = Matrix<dcomplex>(localmesh->LocalNx, ncz / 2 + 1);
     auto delft = Matrix<dcomplex>(localmesh->LocalNx, ncz / 2 + 1);
 
-    // Take forward FFT
-    for (int jx = 0; jx < localmesh->LocalNx; jx++)
-      rfft(&f(jx, 0), ncz, &ft(jx, 0));
-
-    // Loop over kz
-    for (int jz = 0; jz <= ncz / 2; jz++) {
-
-      // No smoothing in the x direction
-      for (int jx = localmesh->xstart; jx <= localmesh->xend; jx++) {
-        // Perform x derivative
+    calcDelp2Coefficients();
 
-        dcomplex a, b, c;
-        laplace_tridag_coefs(jx, jy, jz, a, b, c);
+    // Take forward FFT
+    rfft(&f(0, 0), ncz, localmesh->LocalNx, ncz, &ft(0, 0));
 
-        delft(jx, jz) = a * ft(jx - 1, jz) + b * ft(jx, jz) + c * ft(jx + 1, jz);
+    // No smoothing in the x direction
+    for (int jx = localmesh->xstart; jx <= localmesh->xend; jx++) {
+      // Loop over kz
+      for (int jz = 0; jz <= ncz / 2; jz++) {
+        delft(jx, jz) = delp2_a(jy, jx, jz) * ft(jx - 1, jz)
+                        + delp2_b(jy, jx, jz) * ft(jx, jz)
+                        + delp2_c(jy, jx, jz) * ft(jx + 1, jz);
       }
     }
 
     // Reverse FFT
-    for (int jx = localmesh->xstart; jx <= localmesh->xend; jx++) {
-      irfft(&delft(jx, 0), ncz, &result(jx, 0));
-    }
+    irfft(&delft(localmesh->xstart, 0), ncz, localmesh->xend - localmesh->xstart + 1, ncz,
+          &result(localmesh->xstart, 0));
 
   } else {
     throw BoutException("Non-fourier Delp2 not currently implented for FieldPerp.");
@@ -47,6 +47,8 @@
 #include <output.hxx>
 #include <utils.hxx>
 
+#include <algorithm>
+
 /// MPI type of BoutReal for communications
 #define PVEC_REAL_MPI_TYPE MPI_DOUBLE
 
@@ -69,6 +71,7 @@ If you want the old setting, you have to specify mesh:symmetricGlobalY=false in
 BoutMesh::~BoutMesh() {
   // Delete the communication handles
   clear_handles();
+  clear_plans();
 
   // Delete the boundary regions
   for (const auto &bndry : boundary)
@@ -82,6 +85,11 @@ BoutMesh::~BoutMesh() {
     MPI_Comm_free(&comm_inner);
   if (comm_outer != MPI_COMM_NULL)
     MPI_Comm_free(&comm_outer);
+
+  if (xguard_type3d != MPI_DATATYPE_NULL)
+    MPI_Type_free(&xguard_type3d);
+  if (xguard_type2d != MPI_DATATYPE_NULL)
+    MPI_Type_free(&xguard_type2d);
 }
 
 int BoutMesh::load() {
@@ -435,6 +443,21 @@ int BoutMesh::load() {
                    .doc("Whether to use asyncronous MPI sends")
                    .withDefault(false);
 
+  persistent_comms = options["persistent_comms"]
+                         .doc("Reuse persistent MPI requests when communicating groups "
+                              "with the same number of 3D and 2D fields")
+                         .withDefault(true);
+
+  xguard_datatypes = options["xguard_datatypes"]
+                         .doc("Send X guard cells directly from the fields using MPI "
+                              "datatypes, rather than copying through buffers")
+                         .withDefault(true);
+
+  communicate_corners = options["communicate_corners"]
+                            .doc("Also fill the X-Y corner guard cells when "
+                                 "communicating, by exchanging with diagonal neighbours")
+                            .withDefault(false);
+
   // Set global offsets
 
   OffsetX = PE_XIND * MXSUB;
@@ -871,6 +894,18 @@ int BoutMesh::load() {
   output_info << _("Constructing default regions") << endl;
   createDefaultRegions();
 
+  // The X guard cells of a field are MXG blocks of MYSUB contiguous
+  // Z-lines, separated by a whole X-slice
+  MPI_Type_vector(MXG, MYSUB * LocalNz, LocalNy * LocalNz, PVEC_REAL_MPI_TYPE,
+                  &xguard_type3d);
+  MPI_Type_commit(&xguard_type3d);
+  MPI_Type_vector(MXG, MYSUB, LocalNy, PVEC_REAL_MPI_TYPE, &xguard_type2d);
+  MPI_Type_commit(&xguard_type2d);
+
+  if (communicate_corners) {
+    setup_corners();
+  }
+
   // Add boundary regions
   addBoundaryRegions();
 
@@ -893,6 +928,10 @@ const int OUT_SENT_DOWN = 3; ///< Data higher in X than branch-cut, at lower bou
 // X communication signals
 const int IN_SENT_OUT = 4; ///< Data going in positive X direction (in to out)
 const int OUT_SENT_IN = 5; ///< Data going in negative X direction (out to in)
+// Corner communication signals. The corner is the one being filled on
+// the receiving processor: inner down, inner up, outer down, outer up
+const int CORNER_SENT = 6; ///< Plus the corner index, 0 to 3
+const int CORNER_SETUP = 10; ///< Request for a corner, sent once by setup_corners
 
 void BoutMesh::post_receive(CommHandle &ch) {
   BoutReal *inbuff;
@@ -929,6 +968,24 @@ void BoutMesh::post_receive(CommHandle &ch) {
               &ch.request[3]);
   }
 
+  if (!ch.x_datatypes)
+    post_receive_x(ch);
+}
+
+void BoutMesh::post_receive_x(CommHandle &ch) {
+  if (ch.x_datatypes) {
+    // Receive directly into the guard cells of the fields
+    if (IDATA_DEST != -1) {
+      MPI_Irecv(ch.xguard_base, 1, ch.xguard_types[XGUARD_RECV_INNER], IDATA_DEST,
+                OUT_SENT_IN, BoutComm::get(), &ch.request[4]);
+    }
+    if (ODATA_DEST != -1) {
+      MPI_Irecv(ch.xguard_base, 1, ch.xguard_types[XGUARD_RECV_OUTER], ODATA_DEST,
+                IN_SENT_OUT, BoutComm::get(), &ch.request[5]);
+    }
+    return;
+  }
+
   /// Post receive data from left (x-1)
 
   if (IDATA_DEST != -1) {
@@ -950,16 +1007,46 @@ comm_handle BoutMesh::send(FieldGroup &g) {
   /// Start timer
   Timer timer("comms");
 
-  /// Work out length of buffer needed
-  int xlen = msg_len(g.get(), 0, MXG, 0, MYSUB);
-  int ylen = msg_len(g.get(), 0, LocalNx, 0, MYG);
+  /// Reuse the plan for this shape of group if possible
+  CommHandle *ch = (persistent_comms && !g.empty()) ? get_plan(g) : nullptr;
 
-  /// Get a communications handle of (at least) the needed size
-  CommHandle *ch = get_handle(xlen, ylen);
-  ch->var_list = g; // Group of fields to send
+  if (ch != nullptr) {
+    ch->var_list = g; // Group of fields to send
 
-  /// Post receives
-  post_receive(*ch);
+    /// Restart the receives
+    for (auto &request : ch->request) {
+      if (request != MPI_REQUEST_NULL)
+        MPI_Start(&request);
+    }
+  } else {
+    /// Work out length of buffer needed
+    int xlen = msg_len(g.get(), 0, MXG, 0, MYSUB);
+    int ylen = msg_len(g.get(), 0, LocalNx, 0, MYG);
+
+    /// Get a communications handle of (at least) the needed size
+    ch = get_handle(xlen, ylen);
+    ch->var_list = g; // Group of fields to send
+    ch->x_datatypes = xguard_datatypes && (MXG > 0) && !g.empty();
+
+    /// Post receives
+    post_receive(*ch);
+  }
+
+  /// Send \p len BoutReals from \p buffer to processor \p dest
+  /// using send request \p index
+  auto send_buffer = [&](BoutReal *buffer, int len, int dest, int tag, int index) {
+    if (ch->persistent) {
+      MPI_Start(&(ch->sendreq[index]));
+    } else if (async_send) {
+      MPI_Isend(buffer,             // Buffer to send
+                len,                // Length of buffer in BoutReals
+                PVEC_REAL_MPI_TYPE, // Real variable type
+                dest,               // Destination processor
+                tag,                // Label (tag) for the message
+                BoutComm::get(), &(ch->sendreq[index]));
+    } else
+      MPI_Send(buffer, len, PVEC_REAL_MPI_TYPE, dest, tag, BoutComm::get());
+  };
 
   //////////////////////////////////////////////////
 
@@ -972,17 +1059,7 @@ comm_handle BoutMesh::send(FieldGroup &g) {
     len = pack_data(ch->var_list.get(), 0, UDATA_XSPLIT, MYSUB, MYSUB + MYG,
                     std::begin(ch->umsg_sendbuff));
     // Send the data to processor UDATA_INDEST
-
-    if (async_send) {
-      MPI_Isend(std::begin(ch->umsg_sendbuff), // Buffer to send
-                len,                           // Length of buffer in BoutReals
-                PVEC_REAL_MPI_TYPE,            // Real variable type
-                UDATA_INDEST,                  // Destination processor
-                IN_SENT_UP,                    // Label (tag) for the message
-                BoutComm::get(), &(ch->sendreq[0]));
-    } else
-      MPI_Send(std::begin(ch->umsg_sendbuff), len, PVEC_REAL_MPI_TYPE, UDATA_INDEST,
-               IN_SENT_UP, BoutComm::get());
+    send_buffer(std::begin(ch->umsg_sendbuff), len, UDATA_INDEST, IN_SENT_UP, 0);
   }
   if (UDATA_OUTDEST != -1) {             // if destination for outer x data
     outbuff = &(ch->umsg_sendbuff[len]); // A pointer to the start of the second part
@@ -990,12 +1067,7 @@ comm_handle BoutMesh::send(FieldGroup &g) {
     len =
         pack_data(ch->var_list.get(), UDATA_XSPLIT, LocalNx, MYSUB, MYSUB + MYG, outbuff);
     // Send the data to processor UDATA_OUTDEST
-    if (async_send) {
-      MPI_Isend(outbuff, len, PVEC_REAL_MPI_TYPE, UDATA_OUTDEST, OUT_SENT_UP,
-                BoutComm::get(), &(ch->sendreq[1]));
-    } else
-      MPI_Send(outbuff, len, PVEC_REAL_MPI_TYPE, UDATA_OUTDEST, OUT_SENT_UP,
-               BoutComm::get());
+    send_buffer(outbuff, len, UDATA_OUTDEST, OUT_SENT_UP, 1);
   }
 
   /// Send data going down (y-1)
@@ -1005,51 +1077,56 @@ comm_handle BoutMesh::send(FieldGroup &g) {
     len = pack_data(ch->var_list.get(), 0, DDATA_XSPLIT, MYG, 2 * MYG,
                     std::begin(ch->dmsg_sendbuff));
     // Send the data to processor DDATA_INDEST
-    if (async_send) {
-      MPI_Isend(std::begin(ch->dmsg_sendbuff), len, PVEC_REAL_MPI_TYPE, DDATA_INDEST,
-                IN_SENT_DOWN, BoutComm::get(), &(ch->sendreq[2]));
-    } else
-      MPI_Send(std::begin(ch->dmsg_sendbuff), len, PVEC_REAL_MPI_TYPE, DDATA_INDEST,
-               IN_SENT_DOWN, BoutComm::get());
+    send_buffer(std::begin(ch->dmsg_sendbuff), len, DDATA_INDEST, IN_SENT_DOWN, 2);
   }
   if (DDATA_OUTDEST != -1) {             // if destination for outer x data
     outbuff = &(ch->dmsg_sendbuff[len]); // A pointer to the start of the second part
                                          // of the buffer
     len = pack_data(ch->var_list.get(), DDATA_XSPLIT, LocalNx, MYG, 2 * MYG, outbuff);
     // Send the data to processor DDATA_OUTDEST
+    send_buffer(outbuff, len, DDATA_OUTDEST, OUT_SENT_DOWN, 3);
+  }
 
-    if (async_send) {
-      MPI_Isend(outbuff, len, PVEC_REAL_MPI_TYPE, DDATA_OUTDEST, OUT_SENT_DOWN,
-                BoutComm::get(), &(ch->sendreq[3]));
-    } else
-      MPI_Send(outbuff, len, PVEC_REAL_MPI_TYPE, DDATA_OUTDEST, OUT_SENT_DOWN,
-               BoutComm::get());
+  if (ch->x_datatypes) {
+    /// Receive directly into the X guard cells. Posted after the Y data
+    /// has been packed, since that includes the X guard cells next to
+    /// the Y guard cells
+    update_xguard_types(*ch);
+    post_receive_x(*ch);
   }
 
+  /// Send the X guard cells of all the fields straight from the fields
+  auto send_xguards = [&](XGuardType which, int dest, int tag, int index) {
+    MPI_Datatype type = ch->xguard_types[which];
+    if (ch->persistent || async_send) {
+      MPI_Isend(ch->xguard_base, 1, type, dest, tag, BoutComm::get(),
+                &(ch->sendreq[index]));
+    } else
+      MPI_Send(ch->xguard_base, 1, type, dest, tag, BoutComm::get());
+  };
+
   /// Send to the left (x-1)
 
-  if (IDATA_DEST != -1) {
+  if ((IDATA_DEST != -1) && ch->x_datatypes) {
+    send_xguards(XGUARD_SEND_INNER, IDATA_DEST, IN_SENT_OUT, 4);
+  } else if (IDATA_DEST != -1) {
     len = pack_data(ch->var_list.get(), MXG, 2 * MXG, MYG, MYG + MYSUB,
                     std::begin(ch->imsg_sendbuff));
-    if (async_send) {
-      MPI_Isend(std::begin(ch->imsg_sendbuff), len, PVEC_REAL_MPI_TYPE, IDATA_DEST,
-                IN_SENT_OUT, BoutComm::get(), &(ch->sendreq[4]));
-    } else
-      MPI_Send(std::begin(ch->imsg_sendbuff), len, PVEC_REAL_MPI_TYPE, IDATA_DEST,
-               IN_SENT_OUT, BoutComm::get());
+    send_buffer(std::begin(ch->imsg_sendbuff), len, IDATA_DEST, IN_SENT_OUT, 4);
   }
 
   /// Send to the right (x+1)
 
-  if (ODATA_DEST != -1) {
+  if ((ODATA_DEST != -1) && ch->x_datatypes) {
+    send_xguards(XGUARD_SEND_OUTER, ODATA_DEST, OUT_SENT_IN, 5);
+  } else if (ODATA_DEST != -1) {
     len = pack_data(ch->var_list.get(), MXSUB, MXSUB + MXG, MYG, MYG + MYSUB,
                     std::begin(ch->omsg_sendbuff));
-    if (async_send) {
-      MPI_Isend(std::begin(ch->omsg_sendbuff), len, PVEC_REAL_MPI_TYPE, ODATA_DEST,
-                OUT_SENT_IN, BoutComm::get(), &(ch->sendreq[5]));
-    } else
-      MPI_Send(std::begin(ch->omsg_sendbuff), len, PVEC_REAL_MPI_TYPE, ODATA_DEST,
-               OUT_SENT_IN, BoutComm::get());
+    send_buffer(std::begin(ch->omsg_sendbuff), len, ODATA_DEST, OUT_SENT_IN, 5);
+  }
+
+  if (communicate_corners && !g.empty()) {
+    send_corners(*ch);
   }
 
   /// Mark communication handle as in progress
@@ -1112,21 +1189,29 @@ int BoutMesh::wait(comm_handle handle) {
       break;
     }
     case 4: { // inner
+      if (ch->x_datatypes)
+        break; // Already received into the fields
       unpack_data(ch->var_list.get(), 0, MXG, MYG, MYG + MYSUB,
                   std::begin(ch->imsg_recvbuff));
       break;
     }
     case 5: { // outer
+      if (ch->x_datatypes)
+        break;
       unpack_data(ch->var_list.get(), MXSUB + MXG, MXSUB + 2 * MXG, MYG, MYG + MYSUB,
                   std::begin(ch->omsg_recvbuff));
       break;
     }
     }
-    if (ind != MPI_UNDEFINED)
+    // Completed persistent requests become inactive, and are kept for the next send
+    if ((ind != MPI_UNDEFINED) && !ch->persistent)
       ch->request[ind] = MPI_REQUEST_NULL;
   } while (ind != MPI_UNDEFINED);
 
-  if (async_send) {
+  // After the Y guard cells, which include stale values in the corners
+  wait_corners(*ch);
+
+  if (async_send || ch->persistent) {
     /// Asyncronous sending: Need to check if sends have completed (frees MPI memory)
     MPI_Status async_status;
 
@@ -1983,6 +2068,11 @@ BoutMesh::CommHandle *BoutMesh::get_handle(int xlen, int ylen) {
 
 void BoutMesh::free_handle(CommHandle *h) {
   h->var_list.clear();
+  if (h->persistent) {
+    // Plans stay in comm_plans, ready to be restarted
+    h->in_progress = false;
+    return;
+  }
   comm_list.push_front(h);
 }
 
@@ -1990,16 +2080,355 @@ void BoutMesh::clear_handles() {
   while (!comm_list.empty()) {
     CommHandle *ch = comm_list.front();
 
+    free_xguard_types(*ch);
     delete ch;
 
     comm_list.pop_front();
   }
 }
 
+BoutMesh::CommHandle *BoutMesh::get_plan(const FieldGroup &g) {
+  int n3d = 0, n2d = 0;
+  for (const auto &var : g) {
+    if (var->is3D()) {
+      n3d++;
+    } else {
+      n2d++;
+    }
+  }
+
+  auto it = comm_plans.find({n3d, n2d});
+  if (it != comm_plans.end()) {
+    // Could be in use if several groups of the same shape are sent
+    // before waiting. Fall back to a new handle in that case
+    return it->second->in_progress ? nullptr : it->second;
+  }
+
+  // Create the buffers, as for any other handle
+  int xlen = msg_len(g.get(), 0, MXG, 0, MYSUB);
+  int ylen = msg_len(g.get(), 0, LocalNx, 0, MYG);
+
+  CommHandle *ch = get_handle(xlen, ylen);
+  ch->persistent = true;
+  ch->x_datatypes = xguard_datatypes && (MXG > 0);
+  for (auto &i : ch->sendreq)
+    i = MPI_REQUEST_NULL;
+
+  // Message lengths, matching the ranges packed in send()
+  const auto &vars = g.get();
+  int ulen = msg_len(vars, 0, UDATA_XSPLIT, 0, MYG);
+  int dlen = msg_len(vars, 0, DDATA_XSPLIT, 0, MYG);
+
+  /// Receives: same as in post_receive
+
+  if (UDATA_INDEST != -1) {
+    MPI_Recv_init(std::begin(ch->umsg_recvbuff), ulen, PVEC_REAL_MPI_TYPE, UDATA_INDEST,
+                  IN_SENT_DOWN, BoutComm::get(), &ch->request[0]);
+  }
+  if (UDATA_OUTDEST != -1) {
+    MPI_Recv_init(&ch->umsg_recvbuff[(UDATA_INDEST != -1) ? ulen : 0],
+                  msg_len(vars, UDATA_XSPLIT, LocalNx, 0, MYG), PVEC_REAL_MPI_TYPE,
+                  UDATA_OUTDEST, OUT_SENT_DOWN, BoutComm::get(), &ch->request[1]);
+  }
+  if (DDATA_INDEST != -1) {
+    MPI_Recv_init(std::begin(ch->dmsg_recvbuff), dlen, PVEC_REAL_MPI_TYPE, DDATA_INDEST,
+                  IN_SENT_UP, BoutComm::get(), &ch->request[2]);
+  }
+  if (DDATA_OUTDEST != -1) {
+    MPI_Recv_init(&ch->dmsg_recvbuff[(DDATA_INDEST != -1) ? dlen : 0],
+                  msg_len(vars, DDATA_XSPLIT, LocalNx, 0, MYG), PVEC_REAL_MPI_TYPE,
+                  DDATA_OUTDEST, OUT_SENT_UP, BoutComm::get(), &ch->request[3]);
+  }
+  if ((IDATA_DEST != -1) && !ch->x_datatypes) {
+    MPI_Recv_init(std::begin(ch->imsg_recvbuff), msg_len(vars, 0, MXG, 0, MYSUB),
+                  PVEC_REAL_MPI_TYPE, IDATA_DEST, OUT_SENT_IN, BoutComm::get(),
+                  &ch->request[4]);
+  }
+  if ((ODATA_DEST != -1) && !ch->x_datatypes) {
+    MPI_Recv_init(std::begin(ch->omsg_recvbuff), msg_len(vars, 0, MXG, 0, MYSUB),
+                  PVEC_REAL_MPI_TYPE, ODATA_DEST, IN_SENT_OUT, BoutComm::get(),
+                  &ch->request[5]);
+  }
+
+  /// Sends: same as in send()
+
+  if (UDATA_INDEST != -1) {
+    MPI_Send_init(std::begin(ch->umsg_sendbuff), ulen, PVEC_REAL_MPI_TYPE, UDATA_INDEST,
+                  IN_SENT_UP, BoutComm::get(), &ch->sendreq[0]);
+  }
+  if (UDATA_OUTDEST != -1) {
+    MPI_Send_init(&ch->umsg_sendbuff[(UDATA_INDEST != -1) ? ulen : 0],
+                  msg_len(vars, UDATA_XSPLIT, LocalNx, 0, MYG), PVEC_REAL_MPI_TYPE,
+                  UDATA_OUTDEST, OUT_SENT_UP, BoutComm::get(), &ch->sendreq[1]);
+  }
+  if (DDATA_INDEST != -1) {
+    MPI_Send_init(std::begin(ch->dmsg_sendbuff), dlen, PVEC_REAL_MPI_TYPE, DDATA_INDEST,
+                  IN_SENT_DOWN, BoutComm::get(), &ch->sendreq[2]);
+  }
+  if (DDATA_OUTDEST != -1) {
+    MPI_Send_init(&ch->dmsg_sendbuff[(DDATA_INDEST != -1) ? dlen : 0],
+                  msg_len(vars, DDATA_XSPLIT, LocalNx, 0, MYG), PVEC_REAL_MPI_TYPE,
+                  DDATA_OUTDEST, OUT_SENT_DOWN, BoutComm::get(), &ch->sendreq[3]);
+  }
+  if ((IDATA_DEST != -1) && !ch->x_datatypes) {
+    MPI_Send_init(std::begin(ch->imsg_sendbuff), msg_len(vars, MXG, 2 * MXG, MYG, MYG + MYSUB),
+                  PVEC_REAL_MPI_TYPE, IDATA_DEST, IN_SENT_OUT, BoutComm::get(),
+                  &ch->sendreq[4]);
+  }
+  if ((ODATA_DEST != -1) && !ch->x_datatypes) {
+    MPI_Send_init(std::begin(ch->omsg_sendbuff),
+                  msg_len(vars, MXSUB, MXSUB + MXG, MYG, MYG + MYSUB), PVEC_REAL_MPI_TYPE,
+                  ODATA_DEST, OUT_SENT_IN, BoutComm::get(), &ch->sendreq[5]);
+  }
+
+  comm_plans[{n3d, n2d}] = ch;
+  return ch;
+}
+
+void BoutMesh::clear_plans() {
+  int finalised;
+  MPI_Finalized(&finalised);
+
+  for (auto &plan : comm_plans) {
+    CommHandle *ch = plan.second;
+    if (!finalised) {
+      for (auto &i : ch->request) {
+        if (i != MPI_REQUEST_NULL)
+          MPI_Request_free(&i);
+      }
+      for (auto &i : ch->sendreq) {
+        if (i != MPI_REQUEST_NULL)
+          MPI_Request_free(&i);
+      }
+    }
+    free_xguard_types(*ch);
+    delete ch;
+  }
+  comm_plans.clear();
+}
+
 /****************************************************************
  *                   Communication utilities
  ****************************************************************/
 
+void BoutMesh::update_xguard_types(CommHandle &ch) {
+  const auto &var_list = ch.var_list.get();
+  const int nvars = var_list.size();
+
+  // Start of each field's data
+  std::vector<BoutReal *> starts(nvars);
+  for (int i = 0; i < nvars; i++) {
+    const auto &var = var_list[i];
+    if (var->is3D()) {
+      ASSERT2(static_cast<Field3D *>(var)->isAllocated());
+      starts[i] = &(*static_cast<Field3D *>(var))(0, 0, 0);
+    } else {
+      ASSERT2(static_cast<Field2D *>(var)->isAllocated());
+      starts[i] = &(*static_cast<Field2D *>(var))(0, 0);
+    }
+  }
+  ch.xguard_base = starts[0];
+
+  // Addresses relative to the first field
+  std::vector<std::pair<MPI_Aint, bool>> layout(nvars);
+  MPI_Aint base;
+  MPI_Get_address(starts[0], &base);
+  for (int i = 0; i < nvars; i++) {
+    MPI_Aint address;
+    MPI_Get_address(starts[i], &address);
+    layout[i] = {address - base, var_list[i]->is3D()};
+  }
+
+  if ((layout == ch.xguard_layout) && (ch.xguard_types[0] != MPI_DATATYPE_NULL)) {
+    // Same fields, or fields laid out in the same way
+    return;
+  }
+  free_xguard_types(ch);
+  ch.xguard_layout = layout;
+
+  // First X index of each XGuardType
+  const int xstarts[4] = {0, MXSUB + MXG, MXG, MXSUB};
+
+  std::vector<int> blocklengths(nvars, 1);
+  std::vector<MPI_Aint> displacements(nvars);
+  std::vector<MPI_Datatype> types(nvars);
+  for (int t = 0; t < 4; t++) {
+    const int xge = xstarts[t];
+    for (int i = 0; i < nvars; i++) {
+      if (layout[i].second) {
+        displacements[i] =
+            layout[i].first + ((xge * LocalNy + MYG) * LocalNz) * sizeof(BoutReal);
+        types[i] = xguard_type3d;
+      } else {
+        displacements[i] = layout[i].first + (xge * LocalNy + MYG) * sizeof(BoutReal);
+        types[i] = xguard_type2d;
+      }
+    }
+    MPI_Type_create_struct(nvars, blocklengths.data(), displacements.data(),
+                           types.data(), &ch.xguard_types[t]);
+    MPI_Type_commit(&ch.xguard_types[t]);
+  }
+}
+
+void BoutMesh::free_xguard_types(CommHandle &ch) {
+  int finalised;
+  MPI_Finalized(&finalised);
+
+  for (auto &type : ch.xguard_types) {
+    if ((type != MPI_DATATYPE_NULL) && !finalised) {
+      MPI_Type_free(&type);
+    }
+    type = MPI_DATATYPE_NULL;
+  }
+  ch.xguard_layout.clear();
+}
+
+void BoutMesh::setup_corners() {
+  TRACE("BoutMesh::setup_corners");
+
+  // Get the Y connections of the X neighbours
+  const int ninfo = 6;
+  int mine[ninfo] = {UDATA_INDEST, UDATA_OUTDEST, UDATA_XSPLIT,
+                     DDATA_INDEST, DDATA_OUTDEST, DDATA_XSPLIT};
+  int inner[ninfo], outer[ninfo];
+  std::fill(inner, inner + ninfo, -1);
+  std::fill(outer, outer + ninfo, -1);
+
+  const int xin = (IDATA_DEST != -1) ? IDATA_DEST : MPI_PROC_NULL;
+  const int xout = (ODATA_DEST != -1) ? ODATA_DEST : MPI_PROC_NULL;
+  MPI_Sendrecv(mine, ninfo, MPI_INT, xout, CORNER_SETUP, inner, ninfo, MPI_INT, xin,
+               CORNER_SETUP, BoutComm::get(), MPI_STATUS_IGNORE);
+  MPI_Sendrecv(mine, ninfo, MPI_INT, xin, CORNER_SETUP, outer, ninfo, MPI_INT, xout,
+               CORNER_SETUP, BoutComm::get(), MPI_STATUS_IGNORE);
+
+  /// The processor which the X neighbour with Y connections \p info
+  /// connects to in Y for its local columns [xge, xlt). Columns which
+  /// straddle a branch cut have no single owner, so give -1
+  auto ydest = [](const int* info, bool up, int xge, int xlt) {
+    const int indest = info[up ? 0 : 3];
+    const int outdest = info[up ? 1 : 4];
+    const int xsplit = info[up ? 2 : 5];
+    if (xlt <= xsplit)
+      return indest;
+    if (xge >= xsplit)
+      return outdest;
+    return -1;
+  };
+
+  // Corners of this domain: inner down, inner up, outer down, outer up.
+  // The inner X guard cells are columns [MXSUB, MXSUB + MXG) of the inner
+  // neighbour, and the outer ones columns [MXG, 2 * MXG) of the outer
+  // neighbour. Y neighbours have the same X range
+  corner_recvs.clear();
+  std::vector<int> nrequests(NPES, 0);
+  for (int corner = 0; corner < 4; corner++) {
+    const bool is_inner = corner < 2;
+    const bool up = (corner % 2) == 1;
+
+    if ((is_inner ? IDATA_DEST : ODATA_DEST) == -1)
+      continue; // X boundary
+
+    int source = is_inner ? ydest(inner, up, MXSUB, MXSUB + MXG)
+                          : ydest(outer, up, MXG, 2 * MXG);
+    if (source < 0)
+      continue; // Y boundary or branch cut
+
+    CornerMessage msg;
+    msg.proc = source;
+    msg.tag = CORNER_SENT + corner;
+    msg.xge = is_inner ? 0 : MXSUB + MXG;
+    msg.xlt = is_inner ? MXG : LocalNx;
+    msg.yge = up ? MYSUB + MYG : 0;
+    msg.ylt = up ? LocalNy : MYG;
+    corner_recvs.push_back(msg);
+    nrequests[source]++;
+  }
+
+  // Tell the owners which corners they need to send here
+  int nsends;
+  MPI_Reduce_scatter_block(nrequests.data(), &nsends, 1, MPI_INT, MPI_SUM,
+                           BoutComm::get());
+
+  std::vector<int> corner_ids(corner_recvs.size());
+  std::vector<MPI_Request> requests(corner_recvs.size());
+  for (std::size_t i = 0; i < corner_recvs.size(); i++) {
+    corner_ids[i] = corner_recvs[i].tag - CORNER_SENT;
+    MPI_Isend(&corner_ids[i], 1, MPI_INT, corner_recvs[i].proc, CORNER_SETUP,
+              BoutComm::get(), &requests[i]);
+  }
+
+  corner_sends.clear();
+  for (int i = 0; i < nsends; i++) {
+    int corner;
+    MPI_Status status;
+    MPI_Recv(&corner, 1, MPI_INT, MPI_ANY_SOURCE, CORNER_SETUP, BoutComm::get(),
+             &status);
+
+    // The cells next to the requesting processor's corner
+    const bool is_inner = corner < 2;
+    const bool up = (corner % 2) == 1;
+
+    CornerMessage msg;
+    msg.proc = status.MPI_SOURCE;
+    msg.tag = CORNER_SENT + corner;
+    msg.xge = is_inner ? MXSUB : MXG;
+    msg.xlt = msg.xge + MXG;
+    msg.yge = up ? MYG : MYSUB;
+    msg.ylt = msg.yge + MYG;
+    corner_sends.push_back(msg);
+  }
+
+  MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+}
+
+void BoutMesh::send_corners(CommHandle &ch) {
+  const auto &vars = ch.var_list.get();
+  const int len = msg_len(vars, 0, MXG, 0, MYG); // Same for every corner
+  const int nrecvs = corner_recvs.size();
+  const int nsends = corner_sends.size();
+
+  if (ch.corner_recvbuff.size() < len * nrecvs) {
+    ch.corner_recvbuff.reallocate(len * nrecvs);
+  }
+  if (ch.corner_sendbuff.size() < len * nsends) {
+    ch.corner_sendbuff.reallocate(len * nsends);
+  }
+
+  ch.corner_request.resize(nrecvs);
+  for (int i = 0; i < nrecvs; i++) {
+    const auto &msg = corner_recvs[i];
+    MPI_Irecv(&ch.corner_recvbuff[i * len], len, PVEC_REAL_MPI_TYPE, msg.proc, msg.tag,
+              BoutComm::get(), &ch.corner_request[i]);
+  }
+
+  ch.corner_sendreq.resize(nsends);
+  for (int i = 0; i < nsends; i++) {
+    const auto &msg = corner_sends[i];
+    pack_data(vars, msg.xge, msg.xlt, msg.yge, msg.ylt, &ch.corner_sendbuff[i * len]);
+    MPI_Isend(&ch.corner_sendbuff[i * len], len, PVEC_REAL_MPI_TYPE, msg.proc, msg.tag,
+              BoutComm::get(), &ch.corner_sendreq[i]);
+  }
+}
+
+void BoutMesh::wait_corners(CommHandle &ch) {
+  if (ch.corner_request.empty() && ch.corner_sendreq.empty())
+    return;
+
+  const auto &vars = ch.var_list.get();
+  const int len = msg_len(vars, 0, MXG, 0, MYG);
+
+  MPI_Waitall(ch.corner_request.size(), ch.corner_request.data(), MPI_STATUSES_IGNORE);
+  for (std::size_t i = 0; i < ch.corner_request.size(); i++) {
+    const auto &msg = corner_recvs[i];
+    unpack_data(vars, msg.xge, msg.xlt, msg.yge, msg.ylt, &ch.corner_recvbuff[i * len]);
+  }
+
+  MPI_Waitall(ch.corner_sendreq.size(), ch.corner_sendreq.data(), MPI_STATUSES_IGNORE);
+
+  ch.corner_request.clear();
+  ch.corner_sendreq.clear();
+}
+
 int BoutMesh::pack_data(const std::vector<FieldData *> &var_list, int xge, int xlt, int yge,
                         int ylt, BoutReal *buffer) {
 
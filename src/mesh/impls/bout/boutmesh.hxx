@@ -8,6 +8,8 @@
 #include "unused.hxx"
 
 #include <list>
+#include <map>
+#include <utility>
 #include <vector>
 #include <cmath>
 
@@ -252,6 +254,9 @@ private:
   // Communications
 
   bool async_send; ///< Switch to asyncronous sends (ISend, not Send)
+  bool persistent_comms; ///< Reuse persistent MPI requests for repeated communications
+  bool xguard_datatypes; ///< Send X guard cells directly from the fields (no pack/unpack)
+  bool communicate_corners; ///< Fill the X-Y corner guard cells from diagonal neighbours
 
   /// Communication handle
   /// Used to keep track of communications between send and receive
@@ -268,8 +273,29 @@ private:
     Array<BoutReal> umsg_sendbuff, dmsg_sendbuff, imsg_sendbuff, omsg_sendbuff;
     /// Receiving buffers
     Array<BoutReal> umsg_recvbuff, dmsg_recvbuff, imsg_recvbuff, omsg_recvbuff;
+    /// Requests for the corner guard cells, one for each entry in
+    /// corner_recvs and corner_sends. Never persistent
+    std::vector<MPI_Request> corner_request, corner_sendreq;
+    /// Buffers for the corner guard cells
+    Array<BoutReal> corner_sendbuff, corner_recvbuff;
     /// Is the communication still going?
     bool in_progress;
+    /// Are the requests persistent (see get_plan)? If so, they are
+    /// restarted for each communication rather than being created
+    bool persistent{false};
+    /// Are the X guard cells sent and received directly from the
+    /// fields, rather than through the buffers?
+    bool x_datatypes{false};
+    /// Datatypes for the X guard cells of the fields, relative to the
+    /// start of the first field's data, indexed by XGuardType. Kept
+    /// between communications, see update_xguard_types
+    MPI_Datatype xguard_types[4]{MPI_DATATYPE_NULL, MPI_DATATYPE_NULL, MPI_DATATYPE_NULL,
+                                 MPI_DATATYPE_NULL};
+    /// Layout of the fields that xguard_types were built for: the
+    /// address relative to the first field, and whether it is 3D
+    std::vector<std::pair<MPI_Aint, bool>> xguard_layout;
+    /// Start of the first field's data, which xguard_types are used with
+    BoutReal* xguard_base{nullptr};
     /// List of fields being communicated
     FieldGroup var_list;
   };
@@ -278,6 +304,27 @@ private:
   void clear_handles();
   std::list<CommHandle*> comm_list; // List of allocated communication handles
 
+  /// Get a communication plan for the fields in \p g: a handle whose
+  /// buffers and persistent MPI requests are created the first time a
+  /// group with the same number of 3D and 2D fields is sent, and then
+  /// reused. Returns nullptr if that plan is already in use
+  CommHandle* get_plan(const FieldGroup& g);
+  void clear_plans();
+  /// Communication plans, indexed by the number of 3D and 2D fields
+  std::map<std::pair<int, int>, CommHandle*> comm_plans;
+
+  /// A block of corner guard cells exchanged with a diagonal neighbour
+  struct CornerMessage {
+    int proc;             ///< Processor sent to or received from
+    int tag;              ///< Message tag
+    int xge, xlt, yge, ylt; ///< Range of local indices sent or received
+  };
+  std::vector<CornerMessage> corner_recvs; ///< Corner guard cells received
+  std::vector<CornerMessage> corner_sends; ///< Corners of the domain sent
+  /// Work out which processors own the corner guard cells, and tell
+  /// them to send them here. Collective
+  void setup_corners();
+
   //////////////////////////////////////////////////
   // X communicator
 
@@ -295,6 +342,34 @@ private:
 
   /// Create the MPI requests to receive data. Non-blocking call.
   void post_receive(CommHandle& ch);
+  /// Create the MPI requests to receive the X guard cells
+  void post_receive_x(CommHandle& ch);
+  /// Post the receives for the corner guard cells, and send the
+  /// corners of this domain
+  void send_corners(CommHandle& ch);
+  /// Wait for the corner guard cells, and copy them into the fields
+  void wait_corners(CommHandle& ch);
+
+  /// MPI datatypes describing the X guard cells (or the cells sent to
+  /// fill them) of a single Field3D and Field2D, starting at the first
+  /// guard cell. Created in load()
+  MPI_Datatype xguard_type3d{MPI_DATATYPE_NULL}, xguard_type2d{MPI_DATATYPE_NULL};
+
+  /// The X guard cells exchanged with each X neighbour
+  enum XGuardType {
+    XGUARD_RECV_INNER = 0, ///< Inner guard cells, received from the inner processor
+    XGUARD_RECV_OUTER = 1, ///< Outer guard cells, received from the outer processor
+    XGUARD_SEND_INNER = 2, ///< Inner edge of the domain, sent to the inner processor
+    XGUARD_SEND_OUTER = 3  ///< Outer edge of the domain, sent to the outer processor
+  };
+
+  /// Make sure the datatypes in \p ch describe the X guard cells of
+  /// the fields in its var_list, and set xguard_base. The datatypes
+  /// are only rebuilt if the fields are not at the same places
+  /// relative to each other as the last time
+  void update_xguard_types(CommHandle& ch);
+  /// Free the X guard datatypes of \p ch
+  void free_xguard_types(CommHandle& ch);
 
   /// Take data from objects and put into a buffer
   int pack_data(const std::vector<FieldData*>& var_list, int xge, int xlt, int yge,
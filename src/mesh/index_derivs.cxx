@@ -414,7 +414,7 @@ REGISTER_FLUX_DERIVATIVE_STAGGERED(FDDX_U2_stag, "U2", 2, DERIV::Flux) {
 class FFTDerivativeType {
 public:
   template <DIRECTION direction, STAGGER stagger, int nGuards, typename T>
-  void standard(const T& var, T& result, const std::string& region) const {
+  void standard(const T& var, T& result, RegionID region) const {
     AUTO_TRACE();
     ASSERT2(meta.derivType == DERIV::Standard)
     ASSERT2(var.getMesh()->getNguard(direction) >= nGuards);
@@ -423,8 +423,10 @@ public:
     ASSERT2(bout::utils::is_Field3D<T>::value); // Should never need to call this with Field2D
 
     // Only allow a whitelist of regions for now
-    ASSERT2(region == "RGN_ALL" || region == "RGN_NOBNDRY"
-            || region == "RGN_NOX" || region == "RGN_NOY");
+    ASSERT2(region == RegionID::fromName("RGN_ALL")
+            || region == RegionID::fromName("RGN_NOBNDRY")
+            || region == RegionID::fromName("RGN_NOX")
+            || region == RegionID::fromName("RGN_NOY"));
 
     auto* theMesh = var.getMesh();
 
@@ -439,39 +441,40 @@ public:
       kfilter = ncz / 2;
     const int kmax = ncz / 2 - kfilter; // Up to and including this wavenumber index
 
-    BOUT_OMP(parallel) {
-      Array<dcomplex> cv(ncz / 2 + 1);
-      const BoutReal kwaveFac = TWOPI / ncz;
-
-      // Note we lookup a 2D region here even though we're operating on a Field3D
-      // as we only want to loop over {x, y} and then handle z differently. The
-      // Region<Ind2D> blocks are constructed for elements contiguous assuming nz=1,
-      // as that isn't the case for Field3D (in general) this shouldn't be expected
-      // to vectorise (not that it would anyway) but it should still OpenMP parallelise
-      // ok.
-      // With this in mind we could perhaps avoid the use of the BOUT_FOR_INNER macro
-      // here,
-      // but should be ok for now.
-      BOUT_FOR_INNER(i, theMesh->getRegion2D(region)) {
-        auto i3D = theMesh->ind2Dto3D(i, 0);
-        rfft(&var[i3D], ncz, cv.begin()); // Forward FFT
+    const BoutReal kwaveFac = TWOPI / ncz;
+    const int nmodes = ncz / 2 + 1;
 
+    // Note we lookup a 2D region here even though we're operating on a Field3D
+    // as we only want to loop over {x, y} and then handle z differently. Each
+    // contiguous block of the Region<Ind2D> is a contiguous set of Z-lines in
+    // the Field3D, so is transformed with a single batched FFT
+    const auto& blocks = theMesh->getRegion2D(region).getBlocks();
+    BOUT_OMP(parallel for schedule(OPENMP_SCHEDULE))
+    for (auto block = blocks.cbegin(); block < blocks.cend(); ++block) {
+      const int nlines = block->second.ind - block->first.ind;
+      const auto i3D = theMesh->ind2Dto3D(block->first, 0);
+      Array<dcomplex> cv(nlines * nmodes);
+
+      rfft(&var[i3D], ncz, nlines, ncz, cv.begin()); // Forward FFT
+
+      for (int line = 0; line < nlines; line++) {
+        dcomplex* cvline = &cv[line * nmodes];
         for (int jz = 0; jz <= kmax; jz++) {
           const BoutReal kwave = jz * kwaveFac; // wave number is 1/[rad]
-          cv[jz] *= dcomplex(0, kwave);
+          cvline[jz] *= dcomplex(0, kwave);
         }
-        for (int jz = kmax + 1; jz <= ncz / 2; jz++) {
-          cv[jz] = 0.0;
+        for (int jz = kmax + 1; jz < nmodes; jz++) {
+          cvline[jz] = 0.0;
         }
-
-        irfft(cv.begin(), ncz, &result[i3D]); // Reverse FFT
       }
+
+      irfft(cv.begin(), ncz, nlines, ncz, &result[i3D]); // Reverse FFT
     }
   }
 
   template <DIRECTION direction, STAGGER stagger, int nGuards, typename T>
   void upwindOrFlux(const T& UNUSED(vel), const T& UNUSED(var), T& UNUSED(result),
-                    const std::string& UNUSED(region)) const {
+                    RegionID UNUSED(region)) const {
     AUTO_TRACE();
     throw BoutException("The FFT METHOD isn't available in upwind/Flux");
   }
@@ -481,7 +484,7 @@ public:
 class FFT2ndDerivativeType {
 public:
   template <DIRECTION direction, STAGGER stagger, int nGuards, typename T>
-  void standard(const T& var, T& result, const std::string& region) const {
+  void standard(const T& var, T& result, RegionID region) const {
     AUTO_TRACE();
     ASSERT2(meta.derivType == DERIV::StandardSecond);
     ASSERT2(var.getMesh()->getNguard(direction) >= nGuards);
@@ -490,8 +493,10 @@ public:
     ASSERT2(bout::utils::is_Field3D<T>::value); // Should never need to call this with Field2D
 
     // Only allow a whitelist of regions for now
-    ASSERT2(region == "RGN_ALL" || region == "RGN_NOBNDRY"
-            || region == "RGN_NOX" || region == "RGN_NOY");
+    ASSERT2(region == RegionID::fromName("RGN_ALL")
+            || region == RegionID::fromName("RGN_NOBNDRY")
+            || region == RegionID::fromName("RGN_NOX")
+            || region == RegionID::fromName("RGN_NOY"));
 
     auto* theMesh = var.getMesh();
 
@@ -499,39 +504,40 @@ public:
     const int ncz = theMesh->getNpoints(direction);
     const int kmax = ncz / 2;
 
-    BOUT_OMP(parallel) {
-      Array<dcomplex> cv(ncz / 2 + 1);
-      const BoutReal kwaveFac = TWOPI / ncz;
-
-      // Note we lookup a 2D region here even though we're operating on a Field3D
-      // as we only want to loop over {x, y} and then handle z differently. The
-      // Region<Ind2D> blocks are constructed for elements contiguous assuming nz=1,
-      // as that isn't the case for Field3D (in general) this shouldn't be expected
-      // to vectorise (not that it would anyway) but it should still OpenMP parallelise
-      // ok.
-      // With this in mind we could perhaps avoid the use of the BOUT_FOR_INNER macro
-      // here,
-      // but should be ok for now.
-      BOUT_FOR_INNER(i, theMesh->getRegion2D(region)) {
-        auto i3D = theMesh->ind2Dto3D(i, 0);
-        rfft(&var[i3D], ncz, cv.begin()); // Forward FFT
+    const BoutReal kwaveFac = TWOPI / ncz;
+    const int nmodes = ncz / 2 + 1;
 
+    // Note we lookup a 2D region here even though we're operating on a Field3D
+    // as we only want to loop over {x, y} and then handle z differently. Each
+    // contiguous block of the Region<Ind2D> is a contiguous set of Z-lines in
+    // the Field3D, so is transformed with a single batched FFT
+    const auto& blocks = theMesh->getRegion2D(region).getBlocks();
+    BOUT_OMP(parallel for schedule(OPENMP_SCHEDULE))
+    for (auto block = blocks.cbegin(); block < blocks.cend(); ++block) {
+      const int nlines = block->second.ind - block->first.ind;
+      const auto i3D = theMesh->ind2Dto3D(block->first, 0);
+      Array<dcomplex> cv(nlines * nmodes);
+
+      rfft(&var[i3D], ncz, nlines, ncz, cv.begin()); // Forward FFT
+
+      for (int line = 0; line < nlines; line++) {
+        dcomplex* cvline = &cv[line * nmodes];
         for (int jz = 0; jz <= kmax; jz++) {
           const BoutReal kwave = jz * kwaveFac; // wave number is 1/[rad]
-          cv[jz] *= -kwave * kwave;
+          cvline[jz] *= -kwave * kwave;
         }
-        for (int jz = kmax + 1; jz <= ncz / 2; jz++) {
-          cv[jz] = 0.0;
+        for (int jz = kmax + 1; jz < nmodes; jz++) {
+          cvline[jz] = 0.0;
         }
-
-        irfft(cv.begin(), ncz, &result[i3D]); // Reverse FFT
       }
+
+      irfft(cv.begin(), ncz, nlines, ncz, &result[i3D]); // Reverse FFT
     }
   }
 
   template <DIRECTION direction, STAGGER stagger, int nGuards, typename T>
   void upwindOrFlux(const T& UNUSED(vel), const T& UNUSED(var), T& UNUSED(result),
-                    const std::string& UNUSED(region)) const {
+                    RegionID UNUSED(region)) const {
     AUTO_TRACE();
     throw BoutException("The FFT METHOD isn't available in upwind/Flux");
   }
@@ -547,13 +553,13 @@ produceCombinations<Set<WRAP_ENUM(DIRECTION, Z)>, Set<WRAP_ENUM(STAGGER, None)>,
 class SplitFluxDerivativeType {
 public:
   template <DIRECTION direction, STAGGER stagger, int nGuards, typename T>
-  void standard(const T&, T&, const std::string) const {
+  void standard(const T&, T&, RegionID) const {
     AUTO_TRACE();
     throw BoutException("The SPLIT method isn't available for standard");
   }
 
   template <DIRECTION direction, STAGGER stagger, int nGuards, typename T>
-  void upwindOrFlux(const T& vel, const T& var, T& result, const std::string region) const {
+  void upwindOrFlux(const T& vel, const T& var, T& result, RegionID region) const {
     AUTO_TRACE();
     // Split into an upwind and a central differencing part
     // d/dx(v*f) = v*d/dx(f) + f*d/dx(v)
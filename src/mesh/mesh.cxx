@@ -247,15 +247,27 @@ void Mesh::communicateXZ(FieldGroup &g) {
 void Mesh::communicate(FieldGroup &g) {
   TRACE("Mesh::communicate(FieldGroup&)");
 
+  auto h = startCommunicate(g);
+  finishCommunicate(h);
+}
+
+Mesh::CommunicateHandle Mesh::startCommunicate(FieldGroup &g) {
+  TRACE("Mesh::startCommunicate(FieldGroup&)");
+
   // Send data
-  comm_handle h = send(g);
+  return {send(g), g};
+}
+
+void Mesh::finishCommunicate(CommunicateHandle &h) {
+  TRACE("Mesh::finishCommunicate(CommunicateHandle&)");
 
   // Wait for data from other processors
-  wait(h);
+  wait(h.handle);
+  h.handle = nullptr;
 
   // Calculate yup and ydown fields for 3D fields
   if (calcParallelSlices_on_communicate) {
-    for(const auto& fptr : g.field3d()) {
+    for(const auto& fptr : h.group.field3d()) {
       fptr->calcParallelSlices();
     }
   }
@@ -372,66 +384,94 @@ std::shared_ptr<Coordinates> Mesh::createDefaultCoordinates(const CELL_LOC locat
   }
 }
 
-const Region<>& Mesh::getRegion3D(const std::string& region_name) const {
-  const auto found = regionMap3D.find(region_name);
-  if (found == end(regionMap3D)) {
-    throw BoutException(_("Couldn't find region %s in regionMap3D"), region_name.c_str());
+namespace {
+/// Return the region with handle \p id from \p regions, or nullptr
+template <typename T>
+const Region<T>* findRegion(const std::vector<std::shared_ptr<Region<T>>>& regions,
+                            RegionID id) {
+  const auto index = static_cast<std::size_t>(id.value());
+  if (id.value() < 0 or index >= regions.size()) {
+    return nullptr;
+  }
+  return regions[index].get();
+}
+
+/// Store \p region in \p regions, at the index given by its handle.
+/// Returns false if there is already a region with that name
+template <typename T>
+bool storeRegion(std::vector<std::shared_ptr<Region<T>>>& regions,
+                 const std::string& region_name, const Region<T>& region) {
+  const auto index = static_cast<std::size_t>(Mesh::getRegionID(region_name).value());
+  if (index >= regions.size()) {
+    regions.resize(index + 1);
+  }
+  if (regions[index] != nullptr) {
+    return false;
+  }
+  regions[index] = std::make_shared<Region<T>>(region);
+  return true;
+}
+} // namespace
+
+const Region<>& Mesh::getRegion3D(RegionID region) const {
+  const auto* found = findRegion(regions3D, region);
+  if (found == nullptr) {
+    throw BoutException(_("Couldn't find region %s in regionMap3D"),
+                        region.name().c_str());
   }
-  return found->second;
+  return *found;
 }
 
-const Region<Ind2D>& Mesh::getRegion2D(const std::string& region_name) const {
-  const auto found = regionMap2D.find(region_name);
-  if (found == end(regionMap2D)) {
-    throw BoutException(_("Couldn't find region %s in regionMap2D"), region_name.c_str());
+const Region<Ind2D>& Mesh::getRegion2D(RegionID region) const {
+  const auto* found = findRegion(regions2D, region);
+  if (found == nullptr) {
+    throw BoutException(_("Couldn't find region %s in regionMap2D"),
+                        region.name().c_str());
   }
-  return found->second;
+  return *found;
 }
 
-const Region<IndPerp>& Mesh::getRegionPerp(const std::string& region_name) const {
-  const auto found = regionMapPerp.find(region_name);
-  if (found == end(regionMapPerp)) {
+const Region<IndPerp>& Mesh::getRegionPerp(RegionID region) const {
+  const auto* found = findRegion(regionsPerp, region);
+  if (found == nullptr) {
     throw BoutException(_("Couldn't find region %s in regionMapPerp"),
-                        region_name.c_str());
+                        region.name().c_str());
   }
-  return found->second;
+  return *found;
 }
 
 bool Mesh::hasRegion3D(const std::string& region_name) const {
-  return regionMap3D.find(region_name) != std::end(regionMap3D);
+  return findRegion(regions3D, getRegionID(region_name)) != nullptr;
 }
 
 bool Mesh::hasRegion2D(const std::string& region_name) const {
-  return regionMap2D.find(region_name) != std::end(regionMap2D);
+  return findRegion(regions2D, getRegionID(region_name)) != nullptr;
 }
 
 bool Mesh::hasRegionPerp(const std::string& region_name) const {
-  return regionMapPerp.find(region_name) != std::end(regionMapPerp);
+  return findRegion(regionsPerp, getRegionID(region_name)) != nullptr;
 }
 
 void Mesh::addRegion3D(const std::string &region_name, const Region<> &region) {
-  if (regionMap3D.count(region_name)) {
+  if (not storeRegion(regions3D, region_name, region)) {
     throw BoutException(_("Trying to add an already existing region %s to regionMap3D"), region_name.c_str());
   }
-  regionMap3D[region_name] = region;
   output_verbose.write(_("Registered region 3D %s"),region_name.c_str());
   output_verbose << "\n:\t" << region.getStats() << "\n";
 }
 
 void Mesh::addRegion2D(const std::string &region_name, const Region<Ind2D> &region) {
-  if (regionMap2D.count(region_name)) {
+  if (not storeRegion(regions2D, region_name, region)) {
     throw BoutException(_("Trying to add an already existing region %s to regionMap2D"), region_name.c_str());
   }
-  regionMap2D[region_name] = region;
   output_verbose.write(_("Registered region 2D %s"),region_name.c_str());
   output_verbose << "\n:\t" << region.getStats() << "\n";
 }
 
 void Mesh::addRegionPerp(const std::string &region_name, const Region<IndPerp> &region) {
-  if (regionMapPerp.count(region_name)) {
+  if (not storeRegion(regionsPerp, region_name, region)) {
     throw BoutException(_("Trying to add an already existing region %s to regionMapPerp"), region_name.c_str());
   }
-  regionMapPerp[region_name] = region;
   output_verbose.write(_("Registered region Perp %s"),region_name.c_str());
   output_verbose << "\n:\t" << region.getStats() << "\n";
 }
@@ -464,6 +504,13 @@ void Mesh::createDefaultRegions(){
   addRegion3D("RGN_NOCORNERS",
       (getRegion3D("RGN_NOBNDRY") + getRegion3D("RGN_XGUARDS") +
         getRegion3D("RGN_YGUARDS") + getRegion3D("RGN_ZGUARDS")).unique());
+  // Points whose X and Y stencils don't reach into the guard cells, which
+  // can be calculated while the guard cells are being communicated
+  addRegion3D("RGN_INTERIOR", Region<Ind3D>(2 * xstart, xend - xstart, 2 * ystart,
+                                            yend - ystart, zstart, zend, LocalNy, LocalNz,
+                                            maxregionblocksize));
+  addRegion3D("RGN_INTERIOR_EDGE",
+              mask(getRegion3D("RGN_NOBNDRY"), getRegion3D("RGN_INTERIOR")));
 
   //2D regions
   addRegion2D("RGN_ALL", Region<Ind2D>(0, LocalNx - 1, 0, LocalNy - 1, 0, 0, LocalNy, 1,
@@ -492,6 +539,11 @@ void Mesh::createDefaultRegions(){
   addRegion2D("RGN_NOCORNERS",
       (getRegion2D("RGN_NOBNDRY") + getRegion2D("RGN_XGUARDS") +
         getRegion2D("RGN_YGUARDS") + getRegion2D("RGN_ZGUARDS")).unique());
+  addRegion2D("RGN_INTERIOR", Region<Ind2D>(2 * xstart, xend - xstart, 2 * ystart,
+                                            yend - ystart, 0, 0, LocalNy, 1,
+                                            maxregionblocksize));
+  addRegion2D("RGN_INTERIOR_EDGE",
+              mask(getRegion2D("RGN_NOBNDRY"), getRegion2D("RGN_INTERIOR")));
 
   // Perp regions
   addRegionPerp("RGN_ALL", Region<IndPerp>(0, LocalNx - 1, 0, 0, 0, LocalNz - 1, 1,
@@ -164,8 +164,14 @@ const Field3D ShiftedMetric::shiftZ(const Field3D& f, const Tensor<dcomplex>& ph
 
   Field3D result{emptyFrom(f).setDirectionY(y_direction_out)};
 
-  BOUT_FOR(i, mesh.getRegion2D(toString(region))) {
-    shiftZ(&f(i, 0), &phs(i.x(), i.y(), 0), &result(i, 0));
+  // Each contiguous block of the 2D region is a contiguous set of
+  // Z-lines in both the Field3D and the phases, so can be shifted
+  // with a single batched FFT
+  const auto& blocks = mesh.getRegion2D(toString(region)).getBlocks();
+  BOUT_OMP(parallel for schedule(OPENMP_SCHEDULE))
+  for (auto block = blocks.cbegin(); block < blocks.cend(); ++block) {
+    const auto i = block->first;
+    shiftZ(&f(i, 0), &phs(i.x(), i.y(), 0), &result(i, 0), block->second.ind - i.ind);
   }
 
   return result;
@@ -186,30 +192,44 @@ const FieldPerp ShiftedMetric::shiftZ(const FieldPerp& f, const Tensor<dcomplex>
   FieldPerp result{emptyFrom(f).setDirectionY(y_direction_out)};
 
   int y = f.getIndex();
-  // Note that this loop is essentially hardcoded to be RGN_NOX
-  for (int i=mesh.xstart; i<=mesh.xend; ++i) {
-    shiftZ(&f(i, 0), &phs(i, y, 0), &result(i, 0));
+  // Note that this is essentially hardcoded to be RGN_NOX. The Z-lines
+  // of a FieldPerp are contiguous, but the phases are not, so
+  // transform all the lines at once and apply the phases separately
+  const int nx = mesh.xend - mesh.xstart + 1;
+  Matrix<dcomplex> cmplx(nx, nmodes);
+
+  rfft(&f(mesh.xstart, 0), mesh.LocalNz, nx, mesh.LocalNz, cmplx.begin());
+
+  for (int i = 0; i < nx; ++i) {
+    for (int jz = 1; jz < nmodes; jz++) {
+      cmplx(i, jz) *= phs(i + mesh.xstart, y, jz);
+    }
   }
 
+  irfft(cmplx.begin(), mesh.LocalNz, nx, mesh.LocalNz, &result(mesh.xstart, 0));
+
   return result;
 }
 
-void ShiftedMetric::shiftZ(const BoutReal* in, const dcomplex* phs, BoutReal* out) const {
-  Array<dcomplex> cmplx(nmodes);
+void ShiftedMetric::shiftZ(const BoutReal* in, const dcomplex* phs, BoutReal* out,
+                           int nlines) const {
+  Array<dcomplex> cmplx(nmodes * nlines);
 
-  // Take forward FFT
-  rfft(in, mesh.LocalNz, &cmplx[0]);
+  // Take forward FFT of all lines at once
+  rfft(in, mesh.LocalNz, nlines, mesh.LocalNz, cmplx.begin());
 
   // Following is an algorithm approach to write a = a*b where a and b are
   // vectors of dcomplex.
   //  std::transform(cmplxOneOff.begin(),cmplxOneOff.end(), ptr.begin(),
   //		 cmplxOneOff.begin(), std::multiplies<dcomplex>());
 
-  for (int jz = 1; jz < nmodes; jz++) {
-    cmplx[jz] *= phs[jz];
+  for (int line = 0; line < nlines; line++) {
+    for (int jz = 1; jz < nmodes; jz++) {
+      cmplx[line * nmodes + jz] *= phs[line * nmodes + jz];
+    }
   }
 
-  irfft(&cmplx[0], mesh.LocalNz, out); // Reverse FFT
+  irfft(cmplx.begin(), mesh.LocalNz, nlines, mesh.LocalNz, out); // Reverse FFT
 }
 
 void ShiftedMetric::calcParallelSlices(Field3D& f) {
@@ -224,12 +244,14 @@ void ShiftedMetric::calcParallelSlices(Field3D& f) {
   for (const auto& phase : parallel_slice_phases) {
     auto& f_slice = f.ynext(phase.y_offset);
     f_slice.allocate();
-    BOUT_FOR(i, mesh.getRegion2D("RGN_NOY")) {
-      const int ix = i.x();
-      const int iy = i.y();
+    const auto& blocks = mesh.getRegion2D("RGN_NOY").getBlocks();
+    BOUT_OMP(parallel for schedule(OPENMP_SCHEDULE))
+    for (auto block = blocks.cbegin(); block < blocks.cend(); ++block) {
+      const int ix = block->first.x();
+      const int iy = block->first.y();
       const int iy_offset = iy + phase.y_offset;
       shiftZ(&(f(ix, iy_offset, 0)), &(phase.phase_shift(ix, iy, 0)),
-             &(f_slice(ix, iy_offset, 0)));
+             &(f_slice(ix, iy_offset, 0)), block->second.ind - block->first.ind);
     }
   }
 }
@@ -243,16 +265,12 @@ ShiftedMetric::shiftZ(const Field3D& f,
 
   const int nmodes = mesh.LocalNz / 2 + 1;
 
-  // FFT in Z of input field at each (x, y) point
-  Matrix<Array<dcomplex>> f_fft(mesh.LocalNx, mesh.LocalNy);
-  f_fft = Array<dcomplex>(nmodes);
+  // FFT in Z of input field at each (x, y) point, in one batched call
+  Tensor<dcomplex> f_fft(mesh.LocalNx, mesh.LocalNy, nmodes);
+  rfft(&f(0, 0, 0), mesh.LocalNz, mesh.LocalNx * mesh.LocalNy, mesh.LocalNz,
+       f_fft.begin());
 
-  BOUT_FOR(i, mesh.getRegion2D("RGN_ALL")) {
-    int ix = i.x();
-    int iy = i.y();
-    f_fft(ix, iy).ensureUnique();
-    rfft(&f(i, 0), mesh.LocalNz, f_fft(ix, iy).begin());
-  }
+  const auto& blocks = mesh.getRegion2D("RGN_NOY").getBlocks();
 
   std::vector<Field3D> results{};
 
@@ -264,19 +282,28 @@ ShiftedMetric::shiftZ(const Field3D& f,
     current_result.allocate();
     current_result.setLocation(f.getLocation());
 
-    BOUT_FOR(i, mesh.getRegion2D("RGN_NOY")) {
-      // Deep copy the FFT'd field
-      int ix = i.x();
-      int iy = i.y();
-
-      Array<dcomplex> shifted_temp(f_fft(ix, iy + phase.y_offset));
-      shifted_temp.ensureUnique();
+    BOUT_OMP(parallel for schedule(OPENMP_SCHEDULE))
+    for (auto block = blocks.cbegin(); block < blocks.cend(); ++block) {
+      const auto i = block->first;
+      const int nlines = block->second.ind - i.ind;
+      const int ix = i.x();
+      const int iy = i.y();
 
-      for (int jz = 1; jz < nmodes; ++jz) {
-        shifted_temp[jz] *= phase.phase_shift(ix, iy, jz);
+      // Copy the FFT'd field for this block of Z-lines
+      const dcomplex* f_fft_block = &f_fft(ix, iy + phase.y_offset, 0);
+      const dcomplex* phs_block = &phase.phase_shift(ix, iy, 0);
+      Array<dcomplex> shifted_temp(nlines * nmodes);
+
+      for (int line = 0; line < nlines; ++line) {
+        shifted_temp[line * nmodes] = f_fft_block[line * nmodes];
+        for (int jz = 1; jz < nmodes; ++jz) {
+          shifted_temp[line * nmodes + jz] =
+              f_fft_block[line * nmodes + jz] * phs_block[line * nmodes + jz];
+        }
       }
 
-      irfft(shifted_temp.begin(), mesh.LocalNz, &current_result(i.yp(phase.y_offset), 0));
+      irfft(shifted_temp.begin(), mesh.LocalNz, nlines, mesh.LocalNz,
+            &current_result(i.yp(phase.y_offset), 0));
     }
   }
 
@@ -412,6 +412,10 @@ int ArkodeSolver::init(int nout, BoutReal tstep) {
 
     if (!have_user_precon()) {
       output.write("\tUsing BBD preconditioner\n");
+      if (field_major) {
+        throw BoutException("The BBD preconditioner uses the interleaved state "
+                            "ordering, so needs solver:field_major = false");
+      }
 
       /// Get options
       // Compute band_width_default from actually added fields, to allow for multiple
@@ -292,6 +292,11 @@ int CvodeSolver::init(int nout, BoutReal tstep) {
 
       if (!have_user_precon()) {
         output_info.write("\tUsing BBD preconditioner\n");
+        if (field_major) {
+          // The bandwidths below assume the variables at each point are together
+          throw BoutException("The BBD preconditioner uses the interleaved state "
+                              "ordering, so needs solver:field_major = false");
+        }
 
         /// Get options
         // Compute band_width_default from actually added fields, to allow for multiple
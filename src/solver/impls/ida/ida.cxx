@@ -196,6 +196,10 @@ int IdaSolver::init(int nout, BoutReal tstep) {
   if (use_precon) {
     if (!have_user_precon()) {
       output.write("\tUsing BBD preconditioner\n");
+      if (field_major) {
+        throw BoutException("The BBD preconditioner uses the interleaved state "
+                            "ordering, so needs solver:field_major = false");
+      }
       /// Get options
       // Compute band_width_default from actually added fields, to allow for multiple Mesh
       // objects
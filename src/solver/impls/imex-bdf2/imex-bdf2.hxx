@@ -180,6 +180,11 @@ class IMEXBDF2 : public Solver {
 
   MatFDColoring fdcoloring; ///< Matrix coloring context, used for finite difference Jacobian evaluation
 
+  /// Sparsity of the implicit part's Jacobian, found once and shared
+  /// by snes and snesAlt
+  JacobianPattern jacobian_pattern;
+  bool have_jacobian_pattern{false}; ///< Has jacobian_pattern been found?
+
   template< class Op >
   void loopVars(BoutReal *u);
 
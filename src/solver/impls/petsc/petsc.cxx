@@ -34,6 +34,7 @@
 #include <boutcomm.hxx>
 
 #include <cstdlib>
+#include <vector>
 
 #include <interpolation.hxx> // Cell interpolation
 #include <msg_stack.hxx>
@@ -380,39 +381,46 @@ int PetscSolver::init(int NOUT, BoutReal TIMESTEP) {
     ierr = PetscViewerDestroy(&fd);CHKERRQ(ierr);
   } else { // create Jacobian matrix
 
-    /* number of degrees (variables) at each grid point */
-    PetscInt dof = n3Dvars();
-
-    // Maximum allowable size of stencil in x is the number of guard cells
-    PetscInt stencil_width_estimate = options->operator[]("stencil_width_estimate").withDefault(bout::globals::mesh->xstart);
-    // This is the stencil in each direction (*2) along each dimension
-    // (*3), plus the point itself. Not sure if this is correct
-    // though, on several levels:
-    //   1. Ignores corner points used in e.g. brackets
-    //   2. Could have different stencil widths in each dimension
-    //   3. FFTs couple every single point together
-    PetscInt cols = stencil_width_estimate*2*3+1;
-    PetscInt prealloc; // = cols*dof;
-
-    ierr = MatCreate(comm,&J);CHKERRQ(ierr);
-    ierr = MatSetType(J, MATBAIJ);CHKERRQ(ierr);
-    ierr = MatSetSizes(J,local_N, local_N, neq,neq);CHKERRQ(ierr);
-    ierr = MatSetFromOptions(J);CHKERRQ(ierr);
-
-    // Get nonzero pattern of J - color_none !!!
-    prealloc = cols*dof*dof;
-    ierr = MatSeqAIJSetPreallocation(J,prealloc,PETSC_NULL);CHKERRQ(ierr);
-    ierr = MatMPIAIJSetPreallocation(J,prealloc,PETSC_NULL,prealloc,PETSC_NULL);CHKERRQ(ierr);
+    if (field_major) {
+      throw BoutException("The PETSc Jacobian uses the interleaved state ordering, "
+                          "so needs solver:field_major = false");
+    }
 
-    prealloc = cols; // why nonzeros=295900, allocated nonzeros=2816000/12800000 (*dof*dof), number of mallocs used during MatSetValues calls =256?
-    ierr = MatSeqBAIJSetPreallocation(J,dof,prealloc,PETSC_NULL);CHKERRQ(ierr);
-    ierr = MatMPIBAIJSetPreallocation(J,dof,prealloc,PETSC_NULL,prealloc,PETSC_NULL);CHKERRQ(ierr);
 #if PETSC_VERSION_GE(3,7,0)
     ierr = PetscOptionsHasName(PETSC_NULL, PETSC_NULL,"-J_slowfd",&J_slowfd);CHKERRQ(ierr);
 #else
     ierr = PetscOptionsHasName(PETSC_NULL,"-J_slowfd",&J_slowfd);CHKERRQ(ierr);
 #endif
     if (J_slowfd) { // create Jacobian matrix by slow fd
+
+      /* number of degrees (variables) at each grid point */
+      PetscInt dof = n3Dvars();
+
+      // Maximum allowable size of stencil in x is the number of guard cells
+      PetscInt stencil_width_estimate = options->operator[]("stencil_width_estimate").withDefault(bout::globals::mesh->xstart);
+      // This is the stencil in each direction (*2) along each dimension
+      // (*3), plus the point itself. Not sure if this is correct
+      // though, on several levels:
+      //   1. Ignores corner points used in e.g. brackets
+      //   2. Could have different stencil widths in each dimension
+      //   3. FFTs couple every single point together
+      PetscInt cols = stencil_width_estimate*2*3+1;
+      PetscInt prealloc; // = cols*dof;
+
+      ierr = MatCreate(comm,&J);CHKERRQ(ierr);
+      ierr = MatSetType(J, MATBAIJ);CHKERRQ(ierr);
+      ierr = MatSetSizes(J,local_N, local_N, neq,neq);CHKERRQ(ierr);
+      ierr = MatSetFromOptions(J);CHKERRQ(ierr);
+
+      // Get nonzero pattern of J - color_none !!!
+      prealloc = cols*dof*dof;
+      ierr = MatSeqAIJSetPreallocation(J,prealloc,PETSC_NULL);CHKERRQ(ierr);
+      ierr = MatMPIAIJSetPreallocation(J,prealloc,PETSC_NULL,prealloc,PETSC_NULL);CHKERRQ(ierr);
+
+      prealloc = cols; // why nonzeros=295900, allocated nonzeros=2816000/12800000 (*dof*dof), number of mallocs used during MatSetValues calls =256?
+      ierr = MatSeqBAIJSetPreallocation(J,dof,prealloc,PETSC_NULL);CHKERRQ(ierr);
+      ierr = MatMPIBAIJSetPreallocation(J,dof,prealloc,PETSC_NULL,prealloc,PETSC_NULL);CHKERRQ(ierr);
+
       ierr = SNESSetJacobian(snes,J,J,SNESComputeJacobianDefault,PETSC_NULL);CHKERRQ(ierr);
       output_info << "SNESComputeJacobian J by slow fd...\n";
 
@@ -423,12 +431,29 @@ int PetscSolver::init(int NOUT, BoutReal TIMESTEP) {
       ierr = TSComputeRHSJacobian(ts,simtime,u,&J,&J,&flg);CHKERRQ(ierr);
 #endif
       output_info << "compute J by slow fd is done.\n";
-    } else { // get sparse pattern of the Jacobian
-      throw BoutException("Sorry, unimplemented way of setting PETSc preconditioner. "
-                          "Either set a preconditioner function with 'setPrecon' "
-                          "in your code, or load a matrix with '-Jload' on the "
-                          "command line, or calculate with finite differences "
-                          "with '-J_slowfd' (on command line)");
+    } else { // get sparse pattern of the Jacobian by probing the RHS function
+      output_info << " Find Jacobian sparsity ...\n";
+      const auto pattern = jacobianPattern(jacobianStencil());
+
+      ierr = MatCreate(comm,&J);CHKERRQ(ierr);
+      ierr = MatSetType(J, MATAIJ);CHKERRQ(ierr);
+      ierr = MatSetSizes(J,local_N, local_N, neq,neq);CHKERRQ(ierr);
+      ierr = MatSetFromOptions(J);CHKERRQ(ierr);
+
+      std::vector<PetscInt> d_nnz(begin(pattern.d_nnz), end(pattern.d_nnz));
+      std::vector<PetscInt> o_nnz(begin(pattern.o_nnz), end(pattern.o_nnz));
+      ierr = MatSeqAIJSetPreallocation(J,0,d_nnz.data());CHKERRQ(ierr);
+      ierr = MatMPIAIJSetPreallocation(J,0,d_nnz.data(),0,o_nnz.data());CHKERRQ(ierr);
+
+      for (int i = 0; i < local_N; i++) {
+        PetscInt row = pattern.first_row + i;
+        const std::vector<PetscInt> cols(begin(pattern.columns[i]),
+                                         end(pattern.columns[i]));
+        const std::vector<PetscScalar> vals(cols.size(), 1.0);
+        ierr = MatSetValues(J,1,&row,cols.size(),cols.data(),vals.data(),INSERT_VALUES);CHKERRQ(ierr);
+      }
+      ierr = MatAssemblyBegin(J,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+      ierr = MatAssemblyEnd(J,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
     }
   }
 
@@ -439,7 +464,7 @@ int PetscSolver::init(int NOUT, BoutReal TIMESTEP) {
   ISColoring iscoloring;
 #if PETSC_VERSION_GE(3,5,0)
   MatColoring coloring;
-  MatColoringCreate(Jmf, &coloring);
+  MatColoringCreate(J, &coloring);
   MatColoringSetType(coloring, MATCOLORINGSL);
   MatColoringSetFromOptions(coloring);
   // Calculate index sets
@@ -17,8 +17,8 @@ void RK4Solver::setMaxTimestep(BoutReal dt) {
   if (dt > timestep)
     return; // Already less than this
   
-  if (adaptive)
-    timestep = dt; // Won't be used this time, but next
+  if (adaptive && controller)
+    controller->limitTimestep(dt); // Won't be used this time, but next
 }
 
 int RK4Solver::init(int nout, BoutReal tstep) {
@@ -71,6 +71,9 @@ int RK4Solver::init(int nout, BoutReal tstep) {
   mxstep = (*options)["mxstep"].doc("Maximum number of steps between outputs").withDefault(500);
   adaptive = (*options)["adaptive"].doc("Adapt internal timestep using ATOL and RTOL.").withDefault(false);
 
+  // Error of the full step ~ dt^5
+  controller = bout::utils::make_unique<TimestepController>(options, 4, rtol);
+
   return 0;
 }
 
@@ -108,26 +111,18 @@ int RK4Solver::run() {
             local_err += fabs(f2[i] - f1[i]) / ( fabs(f1[i]) + fabs(f2[i]) + atol );
           }
         
-          // Average over all processors
-          BoutReal err;
-          if(MPI_Allreduce(&local_err, &err, 1, MPI_DOUBLE, MPI_SUM, BoutComm::get())) {
-            throw BoutException("MPI_Allreduce failed");
-          }
-
-          err /= static_cast<BoutReal>(neq);
+          // Average over all processors, in one reduction with any timestep limits
+          BoutReal err = controller->reduce(local_err, neq);
 
           internal_steps++;
           if(internal_steps > mxstep)
             throw BoutException("ERROR: MXSTEP exceeded. timestep = %e, err=%e\n", timestep, err);
 
-          if((err > rtol) || (err < 0.1*rtol)) {
-            // Need to change timestep. Error ~ dt^5
-            timestep /= pow(err / (0.5*rtol), 0.2);
-            
-            if((max_timestep > 0) && (timestep > max_timestep))
-              timestep = max_timestep;
-          }
-          if(err < rtol) {
+          timestep = controller->nextTimestep(timestep, err);
+          if((max_timestep > 0) && (timestep > max_timestep))
+            timestep = max_timestep;
+
+          if(controller->accept(err)) {
             break; // Acceptable accuracy
           }
         }else {
@@ -168,6 +163,10 @@ void RK4Solver::resetInternalFields(){
   
   //Copy fields into current step
   save_vars(std::begin(f0));
+
+  //Previous errors are no guide to the new state
+  if(controller)
+    controller->reset();
 }
 
 void RK4Solver::take_step(BoutReal curtime, BoutReal dt, Array<BoutReal> &start,
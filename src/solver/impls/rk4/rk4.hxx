@@ -34,6 +34,9 @@ class RK4Solver;
 
 #include <bout_types.hxx>
 #include <bout/solver.hxx>
+#include <bout/timestepcontroller.hxx>
+
+#include <memory>
 
 #include <bout/solverfactory.hxx>
 namespace {
@@ -71,6 +74,8 @@ class RK4Solver : public Solver {
                  Array<BoutReal> &start, Array<BoutReal> &result); // Take a single step to calculate f1
   
   Array<BoutReal> k1, k2, k3, k4, k5; // Time-stepping arrays
+
+  std::unique_ptr<TimestepController> controller; // Chooses the timestep if adaptive
   
 };
 
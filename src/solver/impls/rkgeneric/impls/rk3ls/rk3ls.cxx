@@ -0,0 +1,41 @@
+#include "rk3ls.hxx"
+
+//Williamson's three stage, third order 2N scheme
+//(J. Comput. Phys. 35, 48 (1980)), with an embedded second order
+//solution made from the first two stages.
+RK3LSScheme::RK3LSScheme(Options *options):LowStorageRKScheme(options){
+  //Set characteristics of scheme
+  numStages = 3;
+  numOrders = 2;
+  order = 2;
+  label = "rk3ls";
+  followHighOrder = true; //The in place solution is the high order one
+
+  dtfac = 0.9;
+
+  //Allocate coefficient arrays
+  lowStorageA.reallocate(numStages);
+  lowStorageB.reallocate(numStages);
+  embeddedCoeffs.reallocate(numStages);
+
+  //////////////////////////////////
+  //Set coefficients : 2N form
+  //////////////////////////////////
+  lowStorageA[0] = 0.0;
+  lowStorageA[1] = -5.0 / 9.0;
+  lowStorageA[2] = -153.0 / 128.0;
+
+  lowStorageB[0] = 1.0 / 3.0;
+  lowStorageB[1] = 15.0 / 16.0;
+  lowStorageB[2] = 8.0 / 15.0;
+
+  //////////////////////////////////
+  //Set coefficients : embedded
+  //////////////////////////////////
+  //Second order with the stage at t + dt/3
+  embeddedCoeffs[0] = -1.0 / 2.0;
+  embeddedCoeffs[1] = 3.0 / 2.0;
+  embeddedCoeffs[2] = 0.0;
+
+  setButcherTableau();
+}
@@ -0,0 +1,14 @@
+class RK3LSScheme;
+
+#ifndef __RK3LS_SCHEME_H__
+#define __RK3LS_SCHEME_H__
+
+#include <bout/rkscheme.hxx>
+#include <utils.hxx>
+
+class RK3LSScheme : public LowStorageRKScheme {
+public:
+  RK3LSScheme(Options* options);
+};
+
+#endif // __RK3LS_SCHEME_H__
@@ -0,0 +1,47 @@
+#include "rk4ls.hxx"
+
+//Carpenter and Kennedy's five stage, fourth order 2N scheme
+//RK4(3)5[2N] (NASA TM-109112, 1994). The embedded third order
+//solution uses the first four stages.
+RK4LSScheme::RK4LSScheme(Options *options):LowStorageRKScheme(options){
+  //Set characteristics of scheme
+  numStages = 5;
+  numOrders = 2;
+  order = 3;
+  label = "rk4ls";
+  followHighOrder = true; //The in place solution is the high order one
+
+  dtfac = 0.9;
+
+  //Allocate coefficient arrays
+  lowStorageA.reallocate(numStages);
+  lowStorageB.reallocate(numStages);
+  embeddedCoeffs.reallocate(numStages);
+
+  //////////////////////////////////
+  //Set coefficients : 2N form
+  //////////////////////////////////
+  lowStorageA[0] = 0.0;
+  lowStorageA[1] = -567301805773.0 / 1357537059087.0;
+  lowStorageA[2] = -2404267990393.0 / 2016746695238.0;
+  lowStorageA[3] = -3550918686646.0 / 2091501179385.0;
+  lowStorageA[4] = -1275806237668.0 / 842570457699.0;
+
+  lowStorageB[0] = 1432997174477.0 / 9575080441755.0;
+  lowStorageB[1] = 5161836677717.0 / 13612068292357.0;
+  lowStorageB[2] = 1720146321549.0 / 2090206949498.0;
+  lowStorageB[3] = 3134564353537.0 / 4481467310338.0;
+  lowStorageB[4] = 2277821191437.0 / 14882151754819.0;
+
+  //////////////////////////////////
+  //Set coefficients : embedded
+  //////////////////////////////////
+  //Satisfies the third order conditions using stages 0 to 3
+  embeddedCoeffs[0] = 4.901017765016105;
+  embeddedCoeffs[1] = -10.181155805021426;
+  embeddedCoeffs[2] = 7.481097143688198;
+  embeddedCoeffs[3] = -1.2009591036828773;
+  embeddedCoeffs[4] = 0.0;
+
+  setButcherTableau();
+}
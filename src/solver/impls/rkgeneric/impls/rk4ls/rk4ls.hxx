@@ -0,0 +1,14 @@
+class RK4LSScheme;
+
+#ifndef __RK4LS_SCHEME_H__
+#define __RK4LS_SCHEME_H__
+
+#include <bout/rkscheme.hxx>
+#include <utils.hxx>
+
+class RK4LSScheme : public LowStorageRKScheme {
+public:
+  RK4LSScheme(Options* options);
+};
+
+#endif // __RK4LS_SCHEME_H__
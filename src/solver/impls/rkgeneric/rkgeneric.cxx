@@ -26,8 +26,8 @@ void RKGenericSolver::setMaxTimestep(BoutReal dt) {
   if(dt > timestep)
     return; // Already less than this
   
-  if(adaptive)
-    timestep = dt; // Won't be used this time, but next
+  if(adaptive && controller)
+    controller->limitTimestep(dt); // Won't be used this time, but next
 }
 
 int RKGenericSolver::init(int nout, BoutReal tstep) {
@@ -67,8 +67,7 @@ int RKGenericSolver::init(int nout, BoutReal tstep) {
 
   // Allocate memory
   f0.reallocate(nlocal); // Input
-  f2.reallocate(nlocal); // Result--follow order
-  tmpState.reallocate(nlocal);
+  f2.reallocate(nlocal); // Result--follow order, and stage states
 
   // Put starting values into f0
   save_vars(std::begin(f0));
@@ -76,6 +75,9 @@ int RKGenericSolver::init(int nout, BoutReal tstep) {
   //Initialise scheme
   scheme->init(nlocal,neq,adaptive,atol,rtol,options);
 
+  controller = bout::utils::make_unique<TimestepController>(
+      options, scheme->getOrder(), rtol, scheme->getTimestepFactor());
+
   return 0;
 }
 
@@ -83,11 +85,15 @@ void RKGenericSolver::resetInternalFields(){
   //Zero out history
   BOUT_OMP(parallel for)
   for(int i=0;i<nlocal;i++){
-    tmpState[i]=0; f2[i]=0;
+    f2[i]=0;
   }
   
   //Copy fields into current step
   save_vars(std::begin(f0));
+
+  //Previous errors are no guide to the new state
+  if(controller)
+    controller->reset();
 }
 
 int RKGenericSolver::run() {
@@ -118,6 +124,9 @@ int RKGenericSolver::run() {
 
 	//Calculate and check error if adaptive
         if(adaptive) {
+	  //Sum the error over processors, in one reduction with any timestep limits
+	  err = controller->reduce(err, neq);
+
 	  //Really the following should apply to both adaptive and non-adaptive
 	  //approaches, but the non-adaptive can be determined without needing
 	  //to do any solves so could perhaps be check during init instead.
@@ -125,12 +134,12 @@ int RKGenericSolver::run() {
           if(internal_steps > mxstep)
             throw BoutException("ERROR: MXSTEP exceeded. timestep = %e, err=%e\n", timestep, err);
 
-	  //Update the time step if required, note we ignore increases to the timestep
-	  //when on the last internal step as here we may have an artificially small dt
-	  if((err > rtol) || ((err < 0.1*rtol) && running)) {
+	  //Update the time step, note we ignore accepted steps when on the last
+	  //internal step as here we may have an artificially small dt
+	  if(!controller->accept(err) || running) {
 	    
 	    //Get new timestep
-	    timestep=scheme->updateTimestep(dt,err);
+	    timestep=controller->nextTimestep(dt,err);
 
 	    //Limit timestep to specified maximum
             if((max_timestep > 0) && (timestep > max_timestep))
@@ -138,7 +147,7 @@ int RKGenericSolver::run() {
           }
 
 	  //If accuracy ok then break
-          if(err < rtol) break;
+          if(controller->accept(err)) break;
 
         }else {
           // No adaptive timestepping so just accept step
@@ -168,7 +177,7 @@ int RKGenericSolver::run() {
   return 0;
 }
 
-//Returns the evolved state vector along with an error estimate
+//Returns the evolved state vector along with the local part of the error estimate
 BoutReal RKGenericSolver::take_step(const BoutReal timeIn, const BoutReal dt,
                                     const Array<BoutReal> &start,
                                     Array<BoutReal> &resultFollow) {
@@ -177,12 +186,15 @@ BoutReal RKGenericSolver::take_step(const BoutReal timeIn, const BoutReal dt,
   for(int curStage=0;curStage<scheme->getStageCount();curStage++){
     //Use scheme to get this stage's time and state
     BoutReal curTime=scheme->setCurTime(timeIn,dt,curStage);
-    scheme->setCurState(start, tmpState, curStage, dt);
+    scheme->setCurState(start, resultFollow, curStage, dt);
 
     //Get derivs for this stage
-    load_vars(std::begin(tmpState));
+    load_vars(std::begin(resultFollow));
     run_rhs(curTime);
-    save_derivs(&(scheme->steps(curStage,0)));
+    save_derivs(scheme->getStageDerivs(curStage));
+
+    //Let low-storage schemes update their registers
+    scheme->finishStage(resultFollow, curStage, dt);
   }
 
   return scheme->setOutputStates(start, dt, resultFollow);
@@ -33,6 +33,9 @@ class RKGenericSolver;
 #include <bout_types.hxx>
 #include <bout/solver.hxx>
 #include <bout/rkscheme.hxx>
+#include <bout/timestepcontroller.hxx>
+
+#include <memory>
 
 #include <bout/solverfactory.hxx>
 namespace {
@@ -61,8 +64,9 @@ class RKGenericSolver : public Solver {
   BoutReal take_step(BoutReal timeIn,BoutReal dt, const Array<BoutReal> &start, 
 		     Array<BoutReal> &resultFollow);
 
-  //Used for storing current state and next step
-  Array<BoutReal> f0, f2, tmpState;
+  //Used for storing current state and next step. The stage states
+  //are built in f2, which is then overwritten by the result.
+  Array<BoutReal> f0, f2;
 
   //Inputs
   BoutReal atol, rtol;   // Tolerances for adaptive timestepping
@@ -79,6 +83,9 @@ class RKGenericSolver : public Solver {
   //Pointer to the actual scheme used
   RKScheme *scheme;
 
+  //Chooses the timestep if adaptive
+  std::unique_ptr<TimestepController> controller;
+
 };
 
 #endif // __RKGENERIC_SOLVER_H__
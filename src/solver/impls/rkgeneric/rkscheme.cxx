@@ -33,7 +33,7 @@ void RKScheme::init(const int nlocalIn, const int neqIn, const bool adaptiveIn,
   adaptive = adaptiveIn;
 
   //Allocate storage for stages
-  steps.reallocate(getStageCount(), nlocal);
+  steps.reallocate(getStorageCount(), nlocal);
   zeroSteps();
 
   //Allocate array for storing alternative order result
@@ -116,20 +116,14 @@ BoutReal RKScheme::setOutputStates(const Array<BoutReal> &start, const BoutReal
   return getErr(resultFollow, resultAlt);
 }
 
-BoutReal RKScheme::updateTimestep(const BoutReal dt, const BoutReal err){
-  return dtfac*dt*pow(rtol/(2.0*err),1.0/(order+1.0));
-}
-
 ////////////////////
 // PRIVATE
 ////////////////////
 
-//Estimate the error, given two solutions
+//Estimate the local part of the error, given two solutions
 BoutReal RKScheme::getErr(Array<BoutReal> &solA, Array<BoutReal> &solB) {
-  BoutReal err=0.;
-
   //If not adaptive don't care about the error
-  if(!adaptive){return err;}
+  if(!adaptive){return 0.;}
 
   //Get local part of relative error
   BoutReal local_err = 0.;
@@ -143,14 +137,10 @@ BoutReal RKScheme::getErr(Array<BoutReal> &solA, Array<BoutReal> &solB) {
     local_err +=
         std::abs(solA[i] - solB[i]) / (std::abs(solA[i]) + std::abs(solB[i]) + atol);
   }
-  //Reduce over procs
-  if(MPI_Allreduce(&local_err, &err, 1, MPI_DOUBLE, MPI_SUM, BoutComm::get())) {
-    throw BoutException("MPI_Allreduce failed");
-  }
-  //Normalise by number of values
-  err /= static_cast<BoutReal>(neq);
 
-  return err;
+  //The sum over processors and normalisation are done by the solver,
+  //together with its other reductions
+  return local_err;
 }
 
 void RKScheme::constructOutput(const Array<BoutReal> &start, const BoutReal dt,
@@ -287,10 +277,124 @@ void RKScheme::printButcherTableau(){
 }
 
 void RKScheme::zeroSteps(){
-  for(int i=0;i<getStageCount();i++){
+  for(int i=0;i<getStorageCount();i++){
     for(int j=0;j<nlocal;j++){
       steps(i, j) = 0.;
     }
   }
 }
 
+
+////////////////////
+// LOW STORAGE
+////////////////////
+
+void LowStorageRKScheme::setButcherTableau(){
+  //Allocate coefficient arrays
+  stageCoeffs.reallocate(numStages, numStages);
+  resultCoeffs.reallocate(numStages, numOrders);
+  timeCoeffs.reallocate(numStages);
+  errCoeffs.reallocate(numStages);
+
+  //The increment dq of stage m is dt*sum_j g(m,j)*k_j, with k_j the
+  //derivatives at stage j, g(m,m)=1 and g(m,j)=A[m]*g(m-1,j).
+  Matrix<BoutReal> g(numStages, numStages);
+  for(int m=0;m<numStages;m++){
+    for(int j=0;j<numStages;j++){
+      g(m, j) = 0.;
+    }
+    g(m, m) = 1.0;
+    for(int j=0;j<m;j++){
+      g(m, j) = lowStorageA[m] * g(m - 1, j);
+    }
+  }
+
+  //Stage i starts from q after stage i-1, which has the increments of
+  //stages 0 to i-1 added to it.
+  for(int i=0;i<numStages;i++){
+    timeCoeffs[i]=0.;
+    for(int j=0;j<numStages;j++){
+      stageCoeffs(i, j) = 0.;
+      for(int m=j;m<i;m++){
+        stageCoeffs(i, j) += lowStorageB[m] * g(m, j);
+      }
+      timeCoeffs[i] += stageCoeffs(i, j);
+    }
+  }
+
+  //The result is q after the last stage
+  for(int j=0;j<numStages;j++){
+    resultCoeffs(j, 0) = 0.;
+    for(int m=j;m<numStages;m++){
+      resultCoeffs(j, 0) += lowStorageB[m] * g(m, j);
+    }
+    if(numOrders > 1){
+      resultCoeffs(j, 1) = embeddedCoeffs[j];
+      errCoeffs[j] = resultCoeffs(j, 0) - embeddedCoeffs[j];
+    }else{
+      errCoeffs[j] = 0.;
+    }
+  }
+}
+
+void LowStorageRKScheme::setCurState(const Array<BoutReal> &start, Array<BoutReal> &out,
+                                     const int curStage, const BoutReal UNUSED(dt)) {
+  //Later stages update out in place in finishStage
+  if(curStage > 0) return;
+
+  if(adaptive && (numOrders < 2)){
+    throw BoutException("The %s scheme has no error estimate so can't be adaptive",
+                        label.c_str());
+  }
+
+  BOUT_OMP(parallel for)
+  for(int i=0;i<nlocal;i++){
+    out[i] = start[i];
+  }
+}
+
+void LowStorageRKScheme::finishStage(Array<BoutReal> &state, const int curStage,
+                                     const BoutReal dt) {
+  //On the first stage dq doesn't hold anything yet
+  const BoutReal facA = (curStage == 0) ? 0.0 : lowStorageA[curStage];
+  const BoutReal facB = lowStorageB[curStage];
+  const BoutReal facErr = dt * errCoeffs[curStage];
+
+  BoutReal *dq = &steps(0, 0);
+  const BoutReal *k = &steps(1, 0);
+
+  if(adaptive){
+    //Accumulate the difference between the two solutions in resultAlt
+    const BoutReal facOld = (curStage == 0) ? 0.0 : 1.0;
+    BOUT_OMP(parallel for)
+    for(int i=0;i<nlocal;i++){
+      dq[i] = facA * dq[i] + dt * k[i];
+      state[i] += facB * dq[i];
+      resultAlt[i] = facOld * resultAlt[i] + facErr * k[i];
+    }
+  }else{
+    BOUT_OMP(parallel for)
+    for(int i=0;i<nlocal;i++){
+      dq[i] = facA * dq[i] + dt * k[i];
+      state[i] += facB * dq[i];
+    }
+  }
+}
+
+BoutReal LowStorageRKScheme::setOutputStates(const Array<BoutReal> &UNUSED(start),
+                                             const BoutReal UNUSED(dt),
+                                             Array<BoutReal> &resultFollow) {
+  //The stages have already left the result in resultFollow
+  if(!adaptive) return 0.;
+
+  //Same measure as getErr, with the embedded solution resultFollow - resultAlt
+  BoutReal local_err = 0.;
+  BOUT_OMP(parallel for reduction(+:local_err))
+  for(int i=0;i<nlocal;i++) {
+    local_err += std::abs(resultAlt[i])
+                 / (std::abs(resultFollow[i]) + std::abs(resultFollow[i] - resultAlt[i])
+                    + atol);
+  }
+
+  return local_err;
+}
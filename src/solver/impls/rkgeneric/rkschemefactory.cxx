@@ -4,6 +4,8 @@
 #include "impls/cashkarp/cashkarp.hxx"
 #include "impls/rk4simple/rk4simple.hxx"
 #include "impls/rkf34/rkf34.hxx"
+#include "impls/rk3ls/rk3ls.hxx"
+#include "impls/rk4ls/rk4ls.hxx"
 
 #include <boutexception.hxx>
 
@@ -49,6 +51,10 @@ RKScheme* RKSchemeFactory::createRKScheme(RKSchemeType &type, Options *options)
     return new RK4SIMPLEScheme(options);
   }else if(!strcasecmp(type, RKSCHEME_RKF34)) {
     return new RKF34Scheme(options);
+  }else if(!strcasecmp(type, RKSCHEME_RK3LS)) {
+    return new RK3LSScheme(options);
+  }else if(!strcasecmp(type, RKSCHEME_RK4LS)) {
+    return new RK4LSScheme(options);
   };
 
   // Need to throw an error saying 'Supplied option "type"' was not found
@@ -9,6 +9,7 @@
 #include <msg_stack.hxx>
 
 #include <cmath>
+#include <vector>
 
 #include <output.hxx>
 
@@ -25,6 +26,12 @@ static PetscErrorCode FormFunction(SNES UNUSED(snes), Vec x, Vec f, void *ctx) {
   return static_cast<SNESSolver*>(ctx)->snes_function(x, f);
 }
 
+SNESSolver::~SNESSolver() {
+  if (fdcoloring != nullptr) {
+    MatFDColoringDestroy(&fdcoloring);
+  }
+}
+
 int SNESSolver::init(int nout, BoutReal tstep) {
 
   TRACE("Initialising SNES solver");
@@ -76,20 +83,76 @@ int SNESSolver::init(int nout, BoutReal tstep) {
   // Set up the Jacobian
   //MatCreateSNESMF(snes,&Jmf);
   //SNESSetJacobian(snes,Jmf,Jmf,SNESComputeJacobianDefault,this);
-  MatCreateAIJ(BoutComm::get(),
-               nlocal,nlocal,  // Local sizes
-               PETSC_DETERMINE, PETSC_DETERMINE, // Global sizes
-               3,   // Number of nonzero entries in diagonal portion of local submatrix
-               PETSC_NULL,
-               0,   // Number of nonzeros per row in off-diagonal portion of local submatrix
-               PETSC_NULL, 
-               &Jmf);
+  bool use_coloring = (*options)["use_coloring"]
+                          .doc("Use matrix colouring to calculate the Jacobian?")
+                          .withDefault(false);
+  if (use_coloring) {
+    // Find the non-zero entries by probing the RHS function. Columns
+    // which share no rows are then differenced together
+    const auto pattern = jacobianPattern(jacobianStencil());
+
+    MatCreate(BoutComm::get(), &Jmf);
+    MatSetSizes(Jmf, nlocal, nlocal, PETSC_DETERMINE, PETSC_DETERMINE);
+    MatSetFromOptions(Jmf);
+
+    std::vector<PetscInt> d_nnz(begin(pattern.d_nnz), end(pattern.d_nnz));
+    std::vector<PetscInt> o_nnz(begin(pattern.o_nnz), end(pattern.o_nnz));
+    MatSeqAIJSetPreallocation(Jmf, 0, d_nnz.data());
+    MatMPIAIJSetPreallocation(Jmf, 0, d_nnz.data(), 0, o_nnz.data());
+    MatSetUp(Jmf);
+
+    for (int i = 0; i < nlocal; i++) {
+      PetscInt row = pattern.first_row + i;
+      const std::vector<PetscInt> cols(begin(pattern.columns[i]),
+                                       end(pattern.columns[i]));
+      const std::vector<PetscScalar> vals(cols.size(), 1.0);
+      MatSetValues(Jmf, 1, &row, cols.size(), cols.data(), vals.data(), INSERT_VALUES);
+    }
+    MatAssemblyBegin(Jmf, MAT_FINAL_ASSEMBLY);
+    MatAssemblyEnd(Jmf, MAT_FINAL_ASSEMBLY);
+
+    ISColoring iscoloring;
+#if PETSC_VERSION_GE(3,5,0)
+    MatColoring coloring;
+    MatColoringCreate(Jmf, &coloring);
+    MatColoringSetType(coloring, MATCOLORINGSL);
+    MatColoringSetFromOptions(coloring);
+    MatColoringApply(coloring, &iscoloring);
+    MatColoringDestroy(&coloring);
+#else
+    MatGetColoring(Jmf, MATCOLORINGSL, &iscoloring);
+#endif
+    MatFDColoringCreate(Jmf, iscoloring, &fdcoloring);
+    MatFDColoringSetFunction(fdcoloring, (PetscErrorCode (*)())FormFunction, this);
+    MatFDColoringSetFromOptions(fdcoloring);
+#if PETSC_VERSION_GE(3,5,0)
+    MatFDColoringSetUp(Jmf, iscoloring, fdcoloring);
+#endif
+    ISColoringDestroy(&iscoloring);
+
 #if PETSC_VERSION_GE(3,4,0)
-  SNESSetJacobian(snes,Jmf,Jmf,SNESComputeJacobianDefault,this);
+    SNESSetJacobian(snes,Jmf,Jmf,SNESComputeJacobianDefaultColor,fdcoloring);
 #else
-  // Before 3.4
-  SNESSetJacobian(snes,Jmf,Jmf,SNESDefaultComputeJacobian,this);
+    // Before 3.4
+    SNESSetJacobian(snes,Jmf,Jmf,SNESDefaultComputeJacobianColor,fdcoloring);
 #endif
+  } else {
+    // Difference each column separately: one RHS call per unknown
+    MatCreateAIJ(BoutComm::get(),
+                 nlocal,nlocal,  // Local sizes
+                 PETSC_DETERMINE, PETSC_DETERMINE, // Global sizes
+                 3,   // Number of nonzero entries in diagonal portion of local submatrix
+                 PETSC_NULL,
+                 0,   // Number of nonzeros per row in off-diagonal portion of local submatrix
+                 PETSC_NULL, 
+                 &Jmf);
+#if PETSC_VERSION_GE(3,4,0)
+    SNESSetJacobian(snes,Jmf,Jmf,SNESComputeJacobianDefault,this);
+#else
+    // Before 3.4
+    SNESSetJacobian(snes,Jmf,Jmf,SNESDefaultComputeJacobian,this);
+#endif
+  }
   MatSetOption(Jmf,MAT_NEW_NONZERO_ALLOCATION_ERR,PETSC_FALSE);
 
   // Set tolerances
@@ -52,7 +52,7 @@ RegisterSolver<SNESSolver> registersolversnes("snes");
 class SNESSolver : public Solver {
  public:
   SNESSolver(Options *opt = nullptr) : Solver(opt) {}
-  ~SNESSolver() {}
+  ~SNESSolver();
   
   int init(int nout, BoutReal tstep) override;
   
@@ -69,7 +69,8 @@ class SNESSolver : public Solver {
   Vec      snes_f;  ///< Used by SNES to store function
   Vec      snes_x;  ///< Result of SNES
   SNES     snes;    ///< SNES context
-  Mat      Jmf;     ///< Matrix-free Jacobian
+  Mat      Jmf;     ///< Jacobian
+  MatFDColoring fdcoloring{nullptr}; ///< Matrix colouring of the Jacobian
   
 };
 
@@ -28,15 +28,19 @@
 #include "interpolation.hxx"
 #include "msg_stack.hxx"
 #include "output.hxx"
+#include "utils.hxx"
 #include "bout/array.hxx"
 #include "bout/assert.hxx"
+#include "bout/openmpwrap.hxx"
 #include "bout/region.hxx"
 #include "bout/solverfactory.hxx"
 #include "bout/sys/timer.hxx"
 
+#include <algorithm>
 #include <cmath>
 #include <cstring>
 #include <ctime>
+#include <iterator>
 #include <numeric>
 
 // Static member variables
@@ -51,6 +55,10 @@ char ***Solver::pargv = nullptr;
 Solver::Solver(Options* opts)
     : options(opts == nullptr ? &Options::root()["solver"] : opts),
       monitor_timestep((*options)["monitor_timestep"].withDefault(false)),
+      field_major((*options)["field_major"]
+                      .doc("Order the state vector field by field, rather than "
+                           "interleaving the variables at each point?")
+                      .withDefault(false)),
       is_nonsplit_model_diffusive(
           (*options)["is_nonsplit_model_diffusive"]
               .doc("If not a split operator, treat RHS as diffusive?")
@@ -449,6 +457,18 @@ int Solver::solve(int NOUT, BoutReal TIMESTEP) {
     throw BoutException(_("Failed to initialise solver-> Aborting\n"));
   }
 
+  // Arrays released while setting up, for example while reading the
+  // grid or probing the Jacobian, are mostly not the sizes used in the
+  // run, so give them back rather than keep them in the stores
+  if (globaloptions["memory"]["trim_after_init"]
+          .doc("Free the memory in the Array stores once the solver is initialised?")
+          .withDefault(true)) {
+    const std::size_t freed = Array<BoutReal>::trimStore() + Array<dcomplex>::trimStore()
+                              + Array<float>::trimStore();
+    output_info.write(_("Freed %.1f MiB of cached Array memory\n"),
+                      static_cast<BoutReal>(freed) / (1024 * 1024));
+  }
+
   /// Run the solver
   output_info.write(_("Running simulation\n\n"));
 
@@ -764,7 +784,6 @@ int Solver::getLocalN() {
 
   // Cache the value, so this is not repeatedly called.
   // This value should not change after initialisation
-  static int cacheLocalN{-1};
   if (cacheLocalN != -1) {
     return cacheLocalN;
   }
@@ -792,162 +811,162 @@ Solver* Solver::create(const SolverType& type, Options* opts) {
 /**************************************************************************
  * Looping over variables
  *
- * NOTE: This part is very inefficient, and should be replaced ASAP
- * Is the interleaving of variables needed or helpful to the solver?
+ * By default the solver state interleaves the variables: at each
+ * (x,y) point come the 2D variables, then for each z the 3D
+ * variables. Points in the boundary regions come first, and only
+ * contain variables with evolve_bndry set.
+ *
+ * With solver:field_major the state holds each variable in turn (2D
+ * then 3D), each with its boundary points (if evolving) followed by
+ * its bulk points.
  **************************************************************************/
 
-/// Perform an operation at a given Ind2D (jx,jy) location, moving data between BOUT++ and CVODE
-void Solver::loop_vars_op(Ind2D i2d, BoutReal *udata, int &p, SOLVER_VAR_OP op, bool bndry) {
-  // Use global mesh: FIX THIS!
-  Mesh* mesh = bout::globals::mesh;
-
-  int nz = mesh->LocalNz;
-  
-  switch(op) {
-    case SOLVER_VAR_OP::LOAD_VARS: {
-    /// Load variables from IDA into BOUT++
-    
-    // Loop over 2D variables
-    for(const auto& f : f2d) {
-      if(bndry && !f.evolve_bndry)
-        continue;
-      (*f.var)[i2d] = udata[p];
-      p++;
-    }
-    
-    for (int jz=0; jz < nz; jz++) {
-      
-      // Loop over 3D variables
-      for(const auto& f : f3d) {
-        if(bndry && !f.evolve_bndry)
-          continue;
-        (*f.var)[f.var->getMesh()->ind2Dto3D(i2d, jz)] = udata[p];
-        p++;
-      }  
-    }
-    break;
-  }
-  case SOLVER_VAR_OP::LOAD_DERIVS: {
-    /// Load derivatives from IDA into BOUT++
-    /// Used for preconditioner
-    
-    // Loop over 2D variables
-    for(const auto& f : f2d) {
-      if(bndry && !f.evolve_bndry)
-        continue;
-      (*f.F_var)[i2d] = udata[p];
-      p++;
-    }
-    
-    for (int jz=0; jz < nz; jz++) {
-      
-      // Loop over 3D variables
-      for(const auto& f : f3d) {
-        if(bndry && !f.evolve_bndry)
-          continue;
-        (*f.F_var)[f.F_var->getMesh()->ind2Dto3D(i2d, jz)] = udata[p];
-        p++;
-      }  
-    }
-    
+namespace {
+/// The data of one evolving field in one region of the state, used
+/// by Solver::loop_vars. The value at z index jz of the k'th point
+/// in the region is at start + k * point_stride + jz * z_stride in
+/// the state
+struct LoopVar {
+  BoutReal* data; ///< Start of the field data, or nullptr if not needed
+  BoutReal id;    ///< 1 for differential variables, 0 for constraints
+  int start;
+  int point_stride;
+  int z_stride;
+};
+
+/// The variables in one region of the state
+struct StateRegion {
+  const Region<Ind2D>::RegionIndices& indices;
+  std::vector<LoopVar> vars2d{}, vars3d{};
+};
+
+BoutReal* fieldData(Field2D& f) { return &f(0, 0); }
+BoutReal* fieldData(Field3D& f) { return &f(0, 0, 0); }
+
+/// The field data in \p f needed for \p op
+template <class VarStrT>
+BoutReal* opData(const VarStrT& f, SOLVER_VAR_OP op) {
+  switch (op) {
+  case SOLVER_VAR_OP::LOAD_VARS:
+  case SOLVER_VAR_OP::SAVE_VARS:
+    return fieldData(*f.var);
+  case SOLVER_VAR_OP::LOAD_DERIVS:
+  case SOLVER_VAR_OP::SAVE_DERIVS:
+    return fieldData(*f.F_var);
+  case SOLVER_VAR_OP::SET_ID:
     break;
   }
-  case SOLVER_VAR_OP::SET_ID: {
-    /// Set the type of equation (Differential or Algebraic)
-    
-    // Loop over 2D variables
-    for(const auto& f : f2d) {
-      if(bndry && !f.evolve_bndry)
-	continue;
-      if(f.constraint) {
-	udata[p] = 0;
-      }else {
-	udata[p] = 1;
-      }
-      p++;
-    }
-    
-    for (int jz=0; jz < nz; jz++) {
-      
-      // Loop over 3D variables
-      for(const auto& f : f3d) {
-        if(bndry && !f.evolve_bndry)
-	  continue;
-	if(f.constraint) {
-	  udata[p] = 0;
-	}else {
-	  udata[p] = 1;
-	}
-	p++;
-      }
-    }
-    
-    break;
-  }
-  case SOLVER_VAR_OP::SAVE_VARS: {
-    /// Save variables from BOUT++ into IDA (only used at start of simulation)
-    
-    // Loop over 2D variables
-    for(const auto& f : f2d) {
-      if(bndry && !f.evolve_bndry)
-        continue;
-      udata[p] = (*f.var)[i2d];
-      p++;
-    }
-    
-    for (int jz=0; jz < nz; jz++) {
-      
-      // Loop over 3D variables
-      for(const auto& f : f3d) {
-        if(bndry && !f.evolve_bndry)
-          continue;
-        udata[p] = (*f.var)[f.var->getMesh()->ind2Dto3D(i2d, jz)];
-        p++;
-      }  
-    }
-    break;
-  }
-    /// Save time-derivatives from BOUT++ into CVODE (returning RHS result)
-  case SOLVER_VAR_OP::SAVE_DERIVS: {
-    
-    // Loop over 2D variables
-    for(const auto& f : f2d) {
-      if(bndry && !f.evolve_bndry)
-        continue;
-      udata[p] = (*f.F_var)[i2d];
-      p++;
+  return nullptr;
+}
+
+/// Call \p move(var, index into var.data, state value) for every
+/// value of the variables in \p region. Points are independent, so
+/// are shared between threads
+template <typename MoveFunc>
+void moveRegion(const StateRegion& region, int nz, BoutReal* udata, MoveFunc move) {
+  const int npoints = region.indices.size();
+
+  BOUT_OMP(parallel for)
+  for (int k = 0; k < npoints; ++k) {
+    const int ind2d = region.indices[k].ind;
+    for (const auto& f : region.vars2d) {
+      move(f, ind2d, udata[f.start + k * f.point_stride]);
     }
-    
-    for (int jz=0; jz < nz; jz++) {
-      
-      // Loop over 3D variables
-      for(const auto& f : f3d) {
-        if(bndry && !f.evolve_bndry)
-          continue;
-        udata[p] = (*f.F_var)[f.F_var->getMesh()->ind2Dto3D(i2d, jz)];
-        p++;
+    const int ind3d = ind2d * nz;
+    for (const auto& f : region.vars3d) {
+      BoutReal* u = udata + f.start + k * f.point_stride;
+      for (int jz = 0; jz < nz; ++jz) {
+        move(f, ind3d + jz, u[jz * f.z_stride]);
       }
     }
-    break;
-  }
   }
 }
+} // namespace
 
 /// Loop over variables and domain. Used for all data operations for consistency
 void Solver::loop_vars(BoutReal *udata, SOLVER_VAR_OP op) {
   // Use global mesh: FIX THIS!
   Mesh* mesh = bout::globals::mesh;
-
-  int p = 0; // Counter for location in udata array
-  
-  // All boundaries
-  for(const auto &i2d : mesh->getRegion2D("RGN_BNDRY")) {
-    loop_vars_op(i2d, udata, p, op, true);
+  const int nz = mesh->LocalNz;
+
+  StateRegion bndry{mesh->getRegion2D("RGN_BNDRY").getIndices()};
+  StateRegion bulk{mesh->getRegion2D("RGN_NOBNDRY").getIndices()};
+  const int nbndry = bndry.indices.size();
+  const int nbulk = bulk.indices.size();
+
+  // Offset tables: where each variable starts in each region of the state
+  int offset = 0;
+  if (field_major) {
+    for (const auto& f : f2d) {
+      const BoutReal id = f.constraint ? 0.0 : 1.0;
+      if (f.evolve_bndry) {
+        bndry.vars2d.push_back({opData(f, op), id, offset, 1, 0});
+        offset += nbndry;
+      }
+      bulk.vars2d.push_back({opData(f, op), id, offset, 1, 0});
+      offset += nbulk;
+    }
+    for (const auto& f : f3d) {
+      const BoutReal id = f.constraint ? 0.0 : 1.0;
+      if (f.evolve_bndry) {
+        bndry.vars3d.push_back({opData(f, op), id, offset, nz, 1});
+        offset += nbndry * nz;
+      }
+      bulk.vars3d.push_back({opData(f, op), id, offset, nz, 1});
+      offset += nbulk * nz;
+    }
+  } else {
+    for (auto* region : {&bndry, &bulk}) {
+      const bool is_bndry = region == &bndry;
+      // Only variables which evolve their boundaries are in the boundary regions
+      const auto inRegion = [is_bndry](bool evolve_bndry) {
+        return evolve_bndry or not is_bndry;
+      };
+      const auto n2d = std::count_if(begin(f2d), end(f2d), [&](const VarStr<Field2D>& f) {
+        return inRegion(f.evolve_bndry);
+      });
+      const auto n3d = std::count_if(begin(f3d), end(f3d), [&](const VarStr<Field3D>& f) {
+        return inRegion(f.evolve_bndry);
+      });
+      const int point_stride = n2d + n3d * nz;
+
+      int start = offset;
+      for (const auto& f : f2d) {
+        if (inRegion(f.evolve_bndry)) {
+          region->vars2d.push_back(
+              {opData(f, op), f.constraint ? 0.0 : 1.0, start++, point_stride, 0});
+        }
+      }
+      for (const auto& f : f3d) {
+        if (inRegion(f.evolve_bndry)) {
+          region->vars3d.push_back({opData(f, op), f.constraint ? 0.0 : 1.0, start++,
+                                    point_stride, static_cast<int>(n3d)});
+        }
+      }
+      offset += static_cast<int>(region->indices.size()) * point_stride;
+    }
   }
-  
-  // Bulk of points
-  for(const auto &i2d : mesh->getRegion2D("RGN_NOBNDRY")) {
-    loop_vars_op(i2d, udata, p, op, false);
+
+  for (const auto* region : {&bndry, &bulk}) {
+    switch (op) {
+    case SOLVER_VAR_OP::LOAD_VARS:
+    case SOLVER_VAR_OP::LOAD_DERIVS:
+      /// Load variables or derivatives from the solver into BOUT++
+      moveRegion(*region, nz, udata,
+                 [](const LoopVar& f, int ind, BoutReal u) { f.data[ind] = u; });
+      break;
+    case SOLVER_VAR_OP::SAVE_VARS:
+    case SOLVER_VAR_OP::SAVE_DERIVS:
+      /// Save variables or time-derivatives from BOUT++ into the solver
+      moveRegion(*region, nz, udata,
+                 [](const LoopVar& f, int ind, BoutReal& u) { u = f.data[ind]; });
+      break;
+    case SOLVER_VAR_OP::SET_ID:
+      /// Set the type of equation (Differential or Algebraic)
+      moveRegion(*region, nz, udata,
+                 [](const LoopVar& f, int, BoutReal& u) { u = f.id; });
+      break;
+    }
   }
 }
 
@@ -1052,6 +1071,12 @@ Field3D Solver::globalIndex(int localStart) {
   // Use global mesh: FIX THIS!
   Mesh* mesh = bout::globals::mesh;
 
+  if (field_major) {
+    // There is no single index for all the variables at a point
+    throw BoutException(_("Solver::globalIndex needs the interleaved state ordering: "
+                          "set solver:field_major = false"));
+  }
+
   Field3D index(-1, mesh); // Set to -1, indicating out of domain
 
   int n2d = f2d.size();
@@ -1109,6 +1134,291 @@ Field3D Solver::globalIndex(int localStart) {
   return index;
 }
 
+Solver::JacobianStencil Solver::jacobianStencil(bool implicit_only) {
+  TRACE("Solver::jacobianStencil");
+
+  // Use global mesh: FIX THIS!
+  Mesh* mesh = bout::globals::mesh;
+
+  const int n2d = f2d.size();
+  const int nvars = n2d + f3d.size();
+  const int nz = mesh->LocalNz;
+
+  // Perturbed points are more than twice the widest stencil apart in
+  // x and y, so each change has only one possible source. All z
+  // offsets are found by perturbing only z = 0
+  const int width_x = (*options)["jacobian_width_x"]
+                          .doc("Widest stencil in x, for finding the Jacobian sparsity")
+                          .withDefault(mesh->xstart);
+  const int width_y = (*options)["jacobian_width_y"]
+                          .doc("Widest stencil in y, for finding the Jacobian sparsity")
+                          .withDefault(mesh->ystart);
+  // Couplings which are zero in the current state, such as a
+  // coefficient which starts at zero, can't be found by probing, so by
+  // default every variable is also assumed to depend on every other
+  // in a star pattern, as the solvers did before the stencil was probed
+  const bool star = (*options)["jacobian_star"]
+                        .doc("Add a nearest-neighbour star pattern coupling every "
+                             "variable to the probed Jacobian sparsity?")
+                        .withDefault(true);
+  const int spacing_x = 2 * width_x + 1;
+  const int spacing_y = 2 * width_y + 1;
+
+  // Offset from global index \p i to the nearest perturbed point. Using
+  // global indices means that all processors perturb the same points
+  const auto nearest = [](int i, int width) {
+    const int r = i % (2 * width + 1);
+    return r <= width ? -r : 2 * width + 1 - r;
+  };
+
+  // Relative size of the perturbations
+  constexpr BoutReal perturbation = 1e-3;
+
+  // Probe the function whose Jacobian is wanted. For models which are
+  // not split, run_diffusive is the whole RHS (or zero)
+  const auto probe = [&]() {
+    if (implicit_only) {
+      run_diffusive(simtime, true);
+    } else {
+      run_rhs(simtime);
+    }
+  };
+
+  // Global indices of each point, with the guard cells filled from the
+  // neighbouring points. Where the grid wraps round a periodic
+  // direction, or crosses a branch cut, the global index of a
+  // neighbour jumps, so a change can't be traced back to one
+  // perturbed point. Points whose neighbourhood contains such a jump
+  // are not perturbed
+  Field2D global_x{mesh}, global_y{mesh};
+  global_x.allocate();
+  global_y.allocate();
+  for (int x = 0; x < mesh->LocalNx; ++x) {
+    for (int y = 0; y < mesh->LocalNy; ++y) {
+      global_x(x, y) = mesh->getGlobalXIndex(x);
+      global_y(x, y) = mesh->getGlobalYIndex(y);
+    }
+  }
+  mesh->communicate(global_x, global_y);
+
+  const auto isPerturbed = [&](int x, int y) {
+    const int gx = mesh->getGlobalXIndex(x);
+    const int gy = mesh->getGlobalYIndex(y);
+    if (nearest(gx, width_x) != 0 or nearest(gy, width_y) != 0) {
+      return false;
+    }
+    for (int i = std::max(x - width_x, 0); i <= std::min(x + width_x, mesh->LocalNx - 1);
+         ++i) {
+      for (int j = std::max(y - width_y, 0);
+           j <= std::min(y + width_y, mesh->LocalNy - 1); ++j) {
+        if (ROUND(global_x(i, j)) != gx + i - x or ROUND(global_y(i, j)) != gy + j - y) {
+          return false;
+        }
+      }
+    }
+    return true;
+  };
+
+  const int nlocal = getLocalN();
+  Array<BoutReal> state(nlocal), derivs(nlocal);
+  save_vars(std::begin(state));
+  probe();
+  save_derivs(std::begin(derivs));
+
+  std::vector<Field2D> ddt2d;
+  std::vector<Field3D> ddt3d;
+  for (const auto& f : f2d) {
+    ddt2d.push_back(copy(*f.F_var));
+  }
+  for (const auto& f : f3d) {
+    ddt3d.push_back(copy(*f.F_var));
+  }
+
+  // The offsets found, in a dense table so that all processors can be combined
+  std::vector<int> found(nvars * nvars * spacing_x * spacing_y * nz, 0);
+  const auto offsetIndex = [&](int row, int col, int dx, int dy, int dz) {
+    return (((row * nvars + col) * spacing_x + dx + width_x) * spacing_y + dy + width_y)
+               * nz
+           + dz;
+  };
+
+  for (int col = 0; col < nvars; ++col) {
+    load_vars(std::begin(state));
+    for (int x = mesh->xstart; x <= mesh->xend; ++x) {
+      for (int y = mesh->ystart; y <= mesh->yend; ++y) {
+        if (not isPerturbed(x, y)) {
+          continue;
+        }
+        BoutReal& value =
+            col < n2d ? (*f2d[col].var)(x, y) : (*f3d[col - n2d].var)(x, y, 0);
+        value += perturbation * (1. + std::abs(value));
+      }
+    }
+
+    probe();
+
+    for (int x = mesh->xstart; x <= mesh->xend; ++x) {
+      for (int y = mesh->ystart; y <= mesh->yend; ++y) {
+        const int dx = nearest(mesh->getGlobalXIndex(x), width_x);
+        const int dy = nearest(mesh->getGlobalYIndex(y), width_y);
+        for (int row = 0; row < n2d; ++row) {
+          if ((*f2d[row].F_var)(x, y) != ddt2d[row](x, y)) {
+            found[offsetIndex(row, col, dx, dy, 0)] = 1;
+          }
+        }
+        for (int row = n2d; row < nvars; ++row) {
+          for (int z = 0; z < nz; ++z) {
+            if ((*f3d[row - n2d].F_var)(x, y, z) != ddt3d[row - n2d](x, y, z)) {
+              const int dz = col < n2d ? 0 : (nz - z) % nz;
+              found[offsetIndex(row, col, dx, dy, dz)] = 1;
+            }
+          }
+        }
+      }
+    }
+  }
+
+  // Leave the variables and time derivatives as they were
+  load_vars(std::begin(state));
+  load_derivs(std::begin(derivs));
+
+  MPI_Allreduce(MPI_IN_PLACE, found.data(), found.size(), MPI_INT, MPI_MAX,
+                BoutComm::get());
+
+  JacobianStencil stencil(nvars, std::vector<StencilOffsets>(nvars));
+  for (int row = 0; row < nvars; ++row) {
+    for (int col = 0; col < nvars; ++col) {
+      for (int dx = -width_x; dx <= width_x; ++dx) {
+        for (int dy = -width_y; dy <= width_y; ++dy) {
+          for (int dz = 0; dz < nz; ++dz) {
+            if (found[offsetIndex(row, col, dx, dy, dz)] != 0) {
+              stencil[row][col].insert({dx, dy, dz});
+            }
+          }
+        }
+      }
+      if (star) {
+        stencil[row][col].insert({{0, 0, 0}, {-1, 0, 0}, {1, 0, 0}, {0, -1, 0}, {0, 1, 0}});
+        if (row >= n2d and col >= n2d and nz > 1) {
+          stencil[row][col].insert({{0, 0, 1}, {0, 0, nz - 1}});
+        }
+      }
+    }
+  }
+  return stencil;
+}
+
+Solver::JacobianPattern Solver::jacobianPattern(const JacobianStencil& stencil) {
+  TRACE("Solver::jacobianPattern");
+
+  // Use global mesh: FIX THIS!
+  Mesh* mesh = bout::globals::mesh;
+
+  const int n2d = f2d.size();
+  const int nvars = n2d + f3d.size();
+  const int nz = mesh->LocalNz;
+  ASSERT1(static_cast<int>(stencil.size()) == nvars);
+
+  const int nlocal = getLocalN();
+
+  JacobianPattern pattern;
+  MPI_Scan(&nlocal, &pattern.first_row, 1, MPI_INT, MPI_SUM, BoutComm::get());
+  pattern.first_row -= nlocal;
+
+  const Field3D index = globalIndex(pattern.first_row);
+
+  // Boundary points only hold the variables which evolve their
+  // boundaries, so the position of each variable within a point
+  // depends on the region
+  Field2D in_bndry{0., mesh};
+  for (const auto& i : mesh->getRegion2D("RGN_BNDRY")) {
+    in_bndry[i] = 1.;
+  }
+  std::vector<int> position_bulk(nvars), position_bndry(nvars, -1);
+  int n2d_bndry = 0;
+  int n3d_bndry = 0;
+  for (int var = 0; var < nvars; ++var) {
+    const bool is_2d = var < n2d;
+    position_bulk[var] = is_2d ? var : var - n2d;
+    if (is_2d ? f2d[var].evolve_bndry : f3d[var - n2d].evolve_bndry) {
+      position_bndry[var] = is_2d ? n2d_bndry++ : n3d_bndry++;
+    }
+  }
+
+  // Global index of \p var at (x, y, z), or -1 if it is not evolved
+  const auto globalRow = [&](int var, int x, int y, int z) {
+    if (x < 0 or x >= mesh->LocalNx or y < 0 or y >= mesh->LocalNy) {
+      return -1;
+    }
+    const bool is_2d = var < n2d;
+    if (is_2d) {
+      z = 0;
+    }
+    const BoutReal start = index(x, y, z);
+    const bool bndry = in_bndry(x, y) != 0.;
+    const int position = bndry ? position_bndry[var] : position_bulk[var];
+    if (start < 0 or position < 0) {
+      return -1;
+    }
+    // The 2D variables come first at z = 0
+    const int shift = (not is_2d and z == 0) ? (bndry ? n2d_bndry : n2d) : 0;
+    return ROUND(start) + shift + position;
+  };
+
+  pattern.columns.resize(nlocal);
+  for (const auto& region : {"RGN_BNDRY", "RGN_NOBNDRY"}) {
+    for (const auto& i : mesh->getRegion2D(region)) {
+      const int x = i.x();
+      const int y = i.y();
+      for (int z = 0; z < nz; ++z) {
+        for (int row_var = 0; row_var < nvars; ++row_var) {
+          if (row_var < n2d and z > 0) {
+            continue;
+          }
+          const int row = globalRow(row_var, x, y, z);
+          if (row < 0) {
+            continue;
+          }
+          auto& columns = pattern.columns[row - pattern.first_row];
+          columns.push_back(row);
+
+          for (int col_var = 0; col_var < nvars; ++col_var) {
+            for (const auto& offset : stencil[row_var][col_var]) {
+              const int xc = x + offset[0];
+              const int yc = y + offset[1];
+              if (row_var < n2d and col_var >= n2d) {
+                // Depends on the whole z column
+                for (int zc = 0; zc < nz; ++zc) {
+                  columns.push_back(globalRow(col_var, xc, yc, zc));
+                }
+              } else {
+                columns.push_back(globalRow(col_var, xc, yc, (z + offset[2]) % nz));
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+
+  // Remove points which are not evolved, and duplicates
+  pattern.d_nnz.resize(nlocal);
+  pattern.o_nnz.resize(nlocal);
+  for (int row = 0; row < nlocal; ++row) {
+    auto& columns = pattern.columns[row];
+    columns.erase(std::remove(begin(columns), end(columns), -1), end(columns));
+    std::sort(begin(columns), end(columns));
+    columns.erase(std::unique(begin(columns), end(columns)), end(columns));
+
+    pattern.d_nnz[row] = std::count_if(begin(columns), end(columns), [&](int col) {
+      return col >= pattern.first_row and col < pattern.first_row + nlocal;
+    });
+    pattern.o_nnz[row] = columns.size() - pattern.d_nnz[row];
+  }
+
+  return pattern;
+}
+
 /**************************************************************************
  * Running user-supplied functions
  **************************************************************************/
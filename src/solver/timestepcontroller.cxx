@@ -0,0 +1,141 @@
+#include <bout/timestepcontroller.hxx>
+
+#include <boutcomm.hxx>
+#include <boutexception.hxx>
+#include <options.hxx>
+#include <unused.hxx>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+
+#include <mpi.h>
+#include <strings.h>
+
+namespace {
+/// Reduction used by TimestepController::reduce, on elements of the
+/// type from getSumMaxType. The first value of each element is
+/// summed, the second takes the maximum
+void sumMaxPairs(void* invec, void* inoutvec, int* len, MPI_Datatype* UNUSED(datatype)) {
+  auto* in = static_cast<BoutReal*>(invec);
+  auto* inout = static_cast<BoutReal*>(inoutvec);
+  for (int i = 0; i < *len; ++i) {
+    inout[2 * i] += in[2 * i];
+    inout[2 * i + 1] = std::max(inout[2 * i + 1], in[2 * i + 1]);
+  }
+}
+
+/// A (sum, max) pair as a single MPI element, so that the reduction
+/// is always applied to whole pairs
+MPI_Datatype getSumMaxType() {
+  // Created once, and cleaned up by MPI_Finalize
+  static MPI_Datatype type = []() {
+    MPI_Datatype new_type;
+    MPI_Type_contiguous(2, MPI_DOUBLE, &new_type);
+    MPI_Type_commit(&new_type);
+    return new_type;
+  }();
+  return type;
+}
+
+MPI_Op getSumMaxOp() {
+  // Created once, and cleaned up by MPI_Finalize
+  static MPI_Op op = []() {
+    MPI_Op new_op;
+    MPI_Op_create(sumMaxPairs, 1, &new_op);
+    return new_op;
+  }();
+  return op;
+}
+} // namespace
+
+TimestepController::TimestepController(Options* options, int order, BoutReal rtol,
+                                       BoutReal safety)
+    : rtol(rtol), safety(safety), exponent(1.0 / (order + 1.0)) {
+
+  std::string type = (*options)["controller"]
+                         .doc("Timestep controller: I, PI, PID or Gustafsson")
+                         .withDefault(std::string{"I"});
+
+  if (strcasecmp(type.c_str(), "I") == 0) {
+    k1 = 1.0;
+  } else if (strcasecmp(type.c_str(), "PI") == 0) {
+    k1 = 0.8;
+    k2 = 0.31;
+    deadband = false;
+  } else if (strcasecmp(type.c_str(), "PID") == 0) {
+    k1 = 0.58;
+    k2 = 0.21;
+    k3 = 0.1;
+    deadband = false;
+  } else if (strcasecmp(type.c_str(), "Gustafsson") == 0) {
+    k1 = 0.635;
+    k2 = 0.268;
+    deadband = false;
+  } else {
+    throw BoutException("Unknown timestep controller '%s'", type.c_str());
+  }
+
+  k1 = (*options)["controller_k1"].doc("Gain on the current error").withDefault(k1);
+  k2 = (*options)["controller_k2"].doc("Gain on the previous error").withDefault(k2);
+  k3 = (*options)["controller_k3"].doc("Gain on the error two steps back").withDefault(k3);
+}
+
+BoutReal TimestepController::reduce(BoutReal local_err, int neq) {
+  // Negate the limit so that the maximum gives the smallest limit
+  BoutReal local[2] = {local_err, (local_limit > 0.0)
+                                      ? -local_limit
+                                      : std::numeric_limits<BoutReal>::lowest()};
+  BoutReal global[2];
+
+  if (MPI_Allreduce(local, global, 1, getSumMaxType(), getSumMaxOp(),
+                    BoutComm::get())) {
+    throw BoutException("MPI_Allreduce failed");
+  }
+
+  if (global[1] > std::numeric_limits<BoutReal>::lowest()) {
+    global_limit = -global[1];
+  }
+  local_limit = -1.0;
+
+  return global[0] / static_cast<BoutReal>(neq);
+}
+
+void TimestepController::limitTimestep(BoutReal dt) {
+  if ((local_limit < 0.0) || (dt < local_limit)) {
+    local_limit = dt;
+  }
+}
+
+BoutReal TimestepController::nextTimestep(BoutReal dt, BoutReal err) {
+  // Avoid dividing by zero if the solution is exact
+  const BoutReal ratio = 0.5 * rtol / std::max(err, 1e-10 * rtol);
+
+  BoutReal result;
+  if (!accept(err)) {
+    // Rejected, so the previous errors aren't a good guide
+    result = safety * dt * std::pow(ratio, exponent);
+  } else {
+    if (deadband && (err >= 0.1 * rtol)) {
+      result = dt;
+    } else {
+      result = safety * dt * std::pow(ratio, k1 * exponent)
+               * std::pow(ratio_prev1, -k2 * exponent)
+               * std::pow(ratio_prev2, k3 * exponent);
+    }
+    ratio_prev2 = ratio_prev1;
+    ratio_prev1 = ratio;
+  }
+
+  if (global_limit > 0.0) {
+    result = std::min(result, global_limit);
+    global_limit = -1.0;
+  }
+  return result;
+}
+
+void TimestepController::reset() {
+  ratio_prev1 = 1.0;
+  ratio_prev2 = 1.0;
+}
@@ -0,0 +1,257 @@
+/*
+ * Test the different ways BoutMesh can exchange guard cells
+ *
+ * Creates a reference mesh which packs everything through buffers
+ * and posts new MPI requests for every communication, then meshes
+ * with the other communication options. The interior of the fields
+ * on every mesh is set to the same function of the global indices,
+ * and after each of several communications all cells, including the
+ * guard and boundary cells, must be identical to the reference.
+ *
+ * Meshes with communicate_corners also fill the X-Y corner guard
+ * cells, which are checked against the diagonal neighbours' values.
+ * Corners in a boundary region, or whose columns are on both sides of
+ * a separatrix, must be left unset.
+ */
+
+#include <bout.hxx>
+#include <bout/mesh.hxx>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+/// Value of the cells which haven't been set by communications
+constexpr BoutReal unset = -1.0;
+
+/// Value in cell (\p x, \p y) at a given \p iteration. Guard cells
+/// in Y are wrapped, so this is the value the guard cells should get
+BoutReal globalValue(Mesh* mesh, int x, int y, int iteration) {
+  const int ny = mesh->GlobalNy - 2 * mesh->ystart;
+  const int gy = (mesh->getGlobalYIndexNoBoundaries(y) + ny) % ny;
+  return 1e4 * iteration + 100. * mesh->getGlobalXIndex(x) + gy;
+}
+
+/// Set the interior of \p f3d and \p f2d, and set all the other
+/// cells to unset
+void fill(Mesh* mesh, Field3D& f3d, Field2D& f2d, int iteration) {
+  for (int x = 0; x < mesh->LocalNx; x++) {
+    for (int y = 0; y < mesh->LocalNy; y++) {
+      const bool interior = (x >= mesh->xstart) && (x <= mesh->xend)
+                            && (y >= mesh->ystart) && (y <= mesh->yend);
+      const BoutReal value = interior ? globalValue(mesh, x, y, iteration) : unset;
+      f2d(x, y) = value;
+      for (int z = 0; z < mesh->LocalNz; z++) {
+        f3d(x, y, z) = interior ? value + 0.01 * z : unset;
+      }
+    }
+  }
+}
+
+/// Is (\p x, \p y) an X-Y corner guard cell?
+bool isCorner(Mesh* mesh, int x, int y) {
+  return ((x < mesh->xstart) || (x > mesh->xend))
+         && ((y < mesh->ystart) || (y > mesh->yend));
+}
+
+/// Should the corner guard cell (\p x, \p y) be filled by corner
+/// communications? Not in an X boundary, and not across the ends of
+/// the grid in Y unless all of the corner's columns are on closed
+/// flux surfaces: if only some are, the columns are split between
+/// processors in Y
+bool cornerFilled(Mesh* mesh, int x, int y) {
+  if ((mesh->firstX() && (x < mesh->xstart)) || (mesh->lastX() && (x > mesh->xend))) {
+    return false;
+  }
+  const int gy = mesh->getGlobalYIndexNoBoundaries(y);
+  if ((gy >= 0) && (gy < mesh->GlobalNy - 2 * mesh->ystart)) {
+    return true;
+  }
+  const int xge = (x < mesh->xstart) ? 0 : mesh->xend + 1;
+  const int xlt = (x < mesh->xstart) ? mesh->xstart : mesh->LocalNx;
+  for (int i = xge; i < xlt; i++) {
+    if (!mesh->periodicY(i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// Check the corner guard cells of \p f3d and \p f2d against the
+/// global function, or unset where they shouldn't be filled. Returns
+/// the number of wrong cells
+int checkCorners(Mesh* mesh, const Field3D& f3d, const Field2D& f2d, int iteration) {
+  int nwrong = 0;
+  for (int x = 0; x < mesh->LocalNx; x++) {
+    for (int y = 0; y < mesh->LocalNy; y++) {
+      if (!isCorner(mesh, x, y)) {
+        continue;
+      }
+      const bool filled = cornerFilled(mesh, x, y);
+      const BoutReal value = filled ? globalValue(mesh, x, y, iteration) : unset;
+      if (f2d(x, y) != value) {
+        if (nwrong < 10) {
+          output.write("	corner (%d, %d): %e, expected %e\n", x, y, f2d(x, y), value);
+        }
+        nwrong++;
+      }
+      for (int z = 0; z < mesh->LocalNz; z++) {
+        const BoutReal expected = filled ? value + 0.01 * z : unset;
+        if (f3d(x, y, z) != expected) {
+          if (nwrong < 10) {
+            output.write("	corner (%d, %d, %d): %e, expected %e\n", x, y, z,
+                         f3d(x, y, z), expected);
+          }
+          nwrong++;
+        }
+      }
+    }
+  }
+  return nwrong;
+}
+
+/// Check the X and Y guard cells of \p f against the global function,
+/// skipping the corners. Returns the number of wrong cells
+int checkGuards(Mesh* mesh, const Field3D& f, int iteration) {
+  int nwrong = 0;
+  for (int x = 0; x < mesh->LocalNx; x++) {
+    const bool xboundary = (mesh->firstX() && (x < mesh->xstart))
+                           || (mesh->lastX() && (x > mesh->xend));
+    for (int y = 0; y < mesh->LocalNy; y++) {
+      if (isCorner(mesh, x, y)) {
+        continue;
+      }
+      const int gy = mesh->getGlobalYIndexNoBoundaries(y);
+      if (!mesh->periodicY(x) && ((gy < 0) || (gy >= mesh->GlobalNy - 2 * mesh->ystart))) {
+        continue; // Y boundary
+      }
+      for (int z = 0; z < mesh->LocalNz; z++) {
+        const BoutReal expected =
+            xboundary ? unset : globalValue(mesh, x, y, iteration) + 0.01 * z;
+        if (f(x, y, z) != expected) {
+          if (nwrong < 10) {
+            output.write("\t(%d, %d, %d): %e, expected %e\n", x, y, z, f(x, y, z),
+                         expected);
+          }
+          nwrong++;
+        }
+      }
+    }
+  }
+  return nwrong;
+}
+
+/// Number of cells in which \p f differs from \p reference, not
+/// counting the corner guard cells if \p skip_corners
+template <typename T>
+int compare(const T& f, const T& reference, bool skip_corners) {
+  int nwrong = 0;
+  for (const auto& i : f.getRegion("RGN_ALL")) {
+    if (skip_corners && isCorner(f.getMesh(), i.x(), i.y())) {
+      continue;
+    }
+    if (f[i] != reference[i]) {
+      if (nwrong < 10) {
+        output.write("\t%s: %e, reference %e\n", toString(i).c_str(), f[i],
+                     reference[i]);
+      }
+      nwrong++;
+    }
+  }
+  return nwrong;
+}
+
+/// A mesh with some communication options, and fields on it
+struct CommCase {
+  CommCase(std::string name, bool persistent, bool datatypes, bool corners = false)
+      : name(std::move(name)), corners(corners) {
+    auto& options = Options::root();
+    options["persistent_comms"].force(persistent);
+    options["xguard_datatypes"].force(datatypes);
+    options["communicate_corners"].force(corners);
+
+    mesh.reset(Mesh::create());
+    mesh->load();
+
+    // Two sets of fields of the same shape, so that persistent
+    // requests are reused with different fields
+    for (int i = 0; i < 2; i++) {
+      f3d.emplace_back(mesh.get());
+      f3d.back().allocate();
+      f2d.emplace_back(mesh.get());
+      f2d.back().allocate();
+    }
+  }
+
+  std::string name;
+  bool corners;
+  std::unique_ptr<Mesh> mesh;
+  std::vector<Field3D> f3d;
+  std::vector<Field2D> f2d;
+};
+} // namespace
+
+int main(int argc, char** argv) {
+  BoutInitialise(argc, argv);
+
+  const int niterations = Options::root()["niterations"].withDefault(4);
+
+  int passed = 1;
+  {
+    std::vector<CommCase> cases;
+    cases.emplace_back("reference", false, false);
+    cases.emplace_back("persistent", true, false);
+    cases.emplace_back("datatypes", false, true);
+    cases.emplace_back("persistent+datatypes", true, true);
+    cases.emplace_back("corners", false, false, true);
+    cases.emplace_back("corners+persistent+datatypes", true, true, true);
+
+    for (int iteration = 0; iteration < niterations; iteration++) {
+      const int set = iteration % 2;
+
+      for (auto& c : cases) {
+        fill(c.mesh.get(), c.f3d[set], c.f2d[set], iteration);
+        c.mesh->communicate(c.f3d[set], c.f2d[set]);
+      }
+
+      const auto& reference = cases.front();
+      output.write("Iteration %d: reference\n", iteration);
+      if (checkGuards(reference.mesh.get(), reference.f3d[set], iteration) != 0) {
+        passed = 0;
+      }
+
+      for (const auto& c : cases) {
+        output.write("Iteration %d: %s\n", iteration, c.name.c_str());
+        if ((compare(c.f3d[set], reference.f3d[set], c.corners) != 0)
+            || (compare(c.f2d[set], reference.f2d[set], c.corners) != 0)) {
+          passed = 0;
+        }
+        if (c.corners
+            && (checkCorners(c.mesh.get(), c.f3d[set], c.f2d[set], iteration) != 0)) {
+          passed = 0;
+        }
+      }
+    }
+  }
+
+  int allpassed;
+  MPI_Allreduce(&passed, &allpassed, 1, MPI_INT, MPI_MIN, BoutComm::get());
+
+  SAVE_ONCE(allpassed);
+
+  output << "******* BoutMesh communications test: ";
+  if (allpassed) {
+    output << "PASSED" << endl;
+  } else {
+    output << "FAILED" << endl;
+  }
+
+  dump.write();
+  dump.close();
+
+  MPI_Barrier(BoutComm::get());
+
+  BoutFinalise();
+  return 0;
+}
@@ -0,0 +1,246 @@
+/*
+ * Test the Jacobian sparsity found by probing the RHS
+ *
+ * The Jacobian of a nonlinear RHS is calculated twice with PETSc:
+ * once by colouring, using the pattern from Solver::jacobianPattern
+ * to difference groups of columns together, as the SNES and
+ * IMEX-BDF2 solvers do, and once by differencing every column on its
+ * own. If the pattern misses a coupling, colouring puts it in the
+ * wrong place or drops it, and the two Jacobians differ.
+ *
+ * jacobian_star is switched off, so that only the probed stencil is
+ * tested. Run with periodic X and Y, with sizes which are not a
+ * multiple of the probing lattice, to test that the lattice doesn't
+ * wrap round.
+ */
+
+#include <bout.hxx>
+#include <bout/mesh.hxx>
+#include <bout/petsclib.hxx>
+#include <bout/solver.hxx>
+#include <derivs.hxx>
+
+#include <cmath>
+#include <vector>
+
+#include <petscmat.h>
+
+namespace {
+Field3D n;
+Field2D T;
+
+/// Nonlinear RHS which couples the variables in x, y and z
+int rhs(BoutReal UNUSED(time)) {
+  bout::globals::mesh->communicate(n, T);
+  ddt(n) = D2DX2(n * n) + D2DY2(n) + T * DDZ(n) + n * T;
+  ddt(T) = DDX(T * T) + DDY(T) + DC(n);
+  return 0;
+}
+
+/// Gives access to the Jacobian pattern and the state
+class ColoringSolver : public Solver {
+public:
+  ColoringSolver(Options* opts) : Solver(opts) {}
+
+  int run() override { return 0; }
+
+  /// Relative difference between the coloured and brute force Jacobians
+  BoutReal compare();
+
+  /// Put \p x into the variables, run the RHS, and put the time
+  /// derivatives into \p f
+  PetscErrorCode function(Vec x, Vec f) {
+    const BoutReal* xdata;
+    BoutReal* fdata;
+    VecGetArrayRead(x, &xdata);
+    load_vars(const_cast<BoutReal*>(xdata));
+    VecRestoreArrayRead(x, &xdata);
+
+    run_rhs(simtime);
+
+    VecGetArray(f, &fdata);
+    save_derivs(fdata);
+    VecRestoreArray(f, &fdata);
+    return 0;
+  }
+
+private:
+  PetscLib lib;
+};
+
+PetscErrorCode formFunction(void* UNUSED(sctx), Vec x, Vec f, void* ctx) {
+  return static_cast<ColoringSolver*>(ctx)->function(x, f);
+}
+
+BoutReal ColoringSolver::compare() {
+  const int nlocal = getLocalN();
+
+  Vec x, f0, xp, fp;
+  VecCreateMPI(BoutComm::get(), nlocal, PETSC_DETERMINE, &x);
+  VecDuplicate(x, &f0);
+  VecDuplicate(x, &xp);
+  VecDuplicate(x, &fp);
+
+  BoutReal* xdata;
+  VecGetArray(x, &xdata);
+  save_vars(xdata);
+  VecRestoreArray(x, &xdata);
+
+  ////////////////////////////////////////
+  // Coloured, as in the SNES solver
+
+  const auto pattern = jacobianPattern(jacobianStencil());
+
+  Mat coloured;
+  MatCreate(BoutComm::get(), &coloured);
+  MatSetSizes(coloured, nlocal, nlocal, PETSC_DETERMINE, PETSC_DETERMINE);
+  MatSetType(coloured, MATAIJ);
+  std::vector<PetscInt> d_nnz(begin(pattern.d_nnz), end(pattern.d_nnz));
+  std::vector<PetscInt> o_nnz(begin(pattern.o_nnz), end(pattern.o_nnz));
+  MatSeqAIJSetPreallocation(coloured, 0, d_nnz.data());
+  MatMPIAIJSetPreallocation(coloured, 0, d_nnz.data(), 0, o_nnz.data());
+  MatSetUp(coloured);
+  for (int i = 0; i < nlocal; i++) {
+    PetscInt row = pattern.first_row + i;
+    const std::vector<PetscInt> cols(begin(pattern.columns[i]), end(pattern.columns[i]));
+    const std::vector<PetscScalar> vals(cols.size(), 1.0);
+    MatSetValues(coloured, 1, &row, cols.size(), cols.data(), vals.data(),
+                 INSERT_VALUES);
+  }
+  MatAssemblyBegin(coloured, MAT_FINAL_ASSEMBLY);
+  MatAssemblyEnd(coloured, MAT_FINAL_ASSEMBLY);
+
+  ISColoring iscoloring;
+  MatColoring coloring;
+  MatColoringCreate(coloured, &coloring);
+  MatColoringSetType(coloring, MATCOLORINGSL);
+  MatColoringApply(coloring, &iscoloring);
+  MatColoringDestroy(&coloring);
+
+  // Step for each column relative to its value ("ds"), rather than
+  // one step for all, so both Jacobians difference the same points
+  constexpr BoutReal epsilon = 1e-7;
+  constexpr BoutReal umin = 1e-6;
+
+  MatFDColoring fdcoloring;
+  MatFDColoringCreate(coloured, iscoloring, &fdcoloring);
+  MatFDColoringSetFunction(fdcoloring, (PetscErrorCode(*)())formFunction, this);
+  MatFDColoringSetType(fdcoloring, MATMFFD_DS);
+  MatFDColoringSetParameters(fdcoloring, epsilon, umin);
+  MatFDColoringSetUp(coloured, iscoloring, fdcoloring);
+  ISColoringDestroy(&iscoloring);
+
+  MatFDColoringApply(coloured, fdcoloring, x, nullptr);
+  MatFDColoringDestroy(&fdcoloring);
+
+  ////////////////////////////////////////
+  // Brute force, one column at a time
+
+  PetscInt nglobal, low, high;
+  VecGetSize(x, &nglobal);
+  VecGetOwnershipRange(x, &low, &high);
+
+  Mat brute;
+  MatCreateAIJ(BoutComm::get(), nlocal, nlocal, PETSC_DETERMINE, PETSC_DETERMINE, 0,
+               nullptr, 0, nullptr, &brute);
+  MatSetOption(brute, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_FALSE);
+
+  function(x, f0);
+  for (PetscInt col = 0; col < nglobal; col++) {
+    VecCopy(x, xp);
+
+    // Same step as MatFDColoringApply with MATMFFD_DS
+    BoutReal step = 0.0;
+    if ((col >= low) && (col < high)) {
+      BoutReal* xpdata;
+      VecGetArray(xp, &xpdata);
+      BoutReal dx = xpdata[col - low];
+      if (dx == 0.0) {
+        dx = 1.0;
+      }
+      if ((dx < umin) && (dx >= 0.0)) {
+        dx = umin;
+      } else if ((dx < 0.0) && (dx > -umin)) {
+        dx = -umin;
+      }
+      step = epsilon * dx;
+      xpdata[col - low] += step;
+      VecRestoreArray(xp, &xpdata);
+    }
+    MPI_Allreduce(MPI_IN_PLACE, &step, 1, MPI_DOUBLE, MPI_SUM, BoutComm::get());
+
+    function(xp, fp);
+
+    const BoutReal *fpdata, *f0data;
+    VecGetArrayRead(fp, &fpdata);
+    VecGetArrayRead(f0, &f0data);
+    for (int i = 0; i < nlocal; i++) {
+      const BoutReal value = (fpdata[i] - f0data[i]) / step;
+      if (value != 0.0) {
+        MatSetValue(brute, low + i, col, value, INSERT_VALUES);
+      }
+    }
+    VecRestoreArrayRead(f0, &f0data);
+    VecRestoreArrayRead(fp, &fpdata);
+  }
+  MatAssemblyBegin(brute, MAT_FINAL_ASSEMBLY);
+  MatAssemblyEnd(brute, MAT_FINAL_ASSEMBLY);
+
+  // Leave the state as it was
+  VecGetArray(x, &xdata);
+  load_vars(xdata);
+  VecRestoreArray(x, &xdata);
+
+  PetscReal norm, difference;
+  MatNorm(brute, NORM_FROBENIUS, &norm);
+  MatAXPY(brute, -1.0, coloured, DIFFERENT_NONZERO_PATTERN);
+  MatNorm(brute, NORM_FROBENIUS, &difference);
+
+  output.write("Jacobian norm %e, difference %e\n", norm, difference);
+
+  MatDestroy(&brute);
+  MatDestroy(&coloured);
+  VecDestroy(&fp);
+  VecDestroy(&xp);
+  VecDestroy(&f0);
+  VecDestroy(&x);
+
+  return difference / norm;
+}
+} // namespace
+
+int main(int argc, char** argv) {
+  BoutInitialise(argc, argv);
+
+  const BoutReal tolerance = Options::root()["tolerance"].withDefault(1e-4);
+
+  BoutReal error;
+  {
+    ColoringSolver solver(&Options::root()["solver"]);
+    solver.add(n, "n");
+    solver.add(T, "T");
+    solver.setRHS(rhs);
+    solver.init(0, 0);
+
+    error = solver.compare();
+  }
+
+  int allpassed = error < tolerance ? 1 : 0;
+
+  SAVE_ONCE(allpassed);
+
+  output << "******* Jacobian colouring test: ";
+  if (allpassed) {
+    output << "PASSED" << endl;
+  } else {
+    output << "FAILED" << endl;
+  }
+
+  dump.write();
+  dump.close();
+
+  MPI_Barrier(BoutComm::get());
+
+  BoutFinalise();
+  return 0;
+}
@@ -0,0 +1,104 @@
+#include "gtest/gtest.h"
+
+#include "bout/field_expr.hxx"
+#include "field3d.hxx"
+#include "field3d_float.hxx"
+#include "test_extras.hxx"
+
+#include <cmath>
+
+/// Global mesh
+namespace bout {
+namespace globals {
+extern Mesh* mesh;
+} // namespace globals
+} // namespace bout
+
+// The unit tests use the global mesh
+using namespace bout::globals;
+
+using bout::expr::lazy;
+
+class Field3DFloatTest : public FakeMeshFixture {
+public:
+  Field3DFloatTest()
+      : FakeMeshFixture(),
+        a(makeField<Field3D>([](Ind3D& i) { return std::sin(0.1 + i.ind); }, mesh)),
+        b(makeField<Field3D>([](Ind3D& i) { return 2.0 - 0.5 * i.ind; }, mesh)) {}
+
+  Field3D a, b;
+
+  /// Relative precision of float
+  static constexpr BoutReal tolerance = 1e-6;
+};
+
+TEST_F(Field3DFloatTest, IsAllocated) {
+  Field3DF field{mesh};
+  EXPECT_FALSE(field.isAllocated());
+
+  field.allocate();
+  EXPECT_TRUE(field.isAllocated());
+  EXPECT_EQ(field.getNx(), Field3DFloatTest::nx);
+  EXPECT_EQ(field.getNy(), Field3DFloatTest::ny);
+  EXPECT_EQ(field.getNz(), Field3DFloatTest::nz);
+}
+
+TEST_F(Field3DFloatTest, FromField3D) {
+  a.setDirectionY(YDirectionType::Aligned);
+  const Field3DF field{a};
+
+  EXPECT_EQ(field.getMesh(), a.getMesh());
+  EXPECT_EQ(field.getLocation(), a.getLocation());
+  EXPECT_EQ(field.getDirectionY(), YDirectionType::Aligned);
+
+  for (const auto& i : a.getRegion("RGN_ALL")) {
+    EXPECT_EQ(field[i], static_cast<float>(a[i]));
+  }
+  EXPECT_DOUBLE_EQ(field(1, 2, 3), static_cast<float>(a(1, 2, 3)));
+
+  EXPECT_TRUE(IsFieldEqual(field.toField3D(), a, "RGN_ALL", tolerance));
+}
+
+TEST_F(Field3DFloatTest, AssignUnallocated) {
+  Field3DF field{a};
+
+  Field3D empty{mesh_staggered, CELL_XLOW, {YDirectionType::Aligned, ZDirectionType::Standard}};
+  field = empty;
+
+  EXPECT_FALSE(field.isAllocated());
+  EXPECT_EQ(field.getMesh(), mesh_staggered);
+  EXPECT_EQ(field.getLocation(), CELL_XLOW);
+  EXPECT_EQ(field.getDirectionY(), YDirectionType::Aligned);
+  EXPECT_EQ(field.getNx(), empty.getNx());
+}
+
+TEST_F(Field3DFloatTest, AssignValue) {
+  Field3DF field{mesh};
+  field = 1.5;
+
+  EXPECT_TRUE(IsFieldEqual(field.toField3D(), 1.5));
+
+  field(1, 1, 1) = 2.0;
+  EXPECT_DOUBLE_EQ(field(1, 1, 1), 2.0);
+}
+
+TEST_F(Field3DFloatTest, CopyIsUnique) {
+  Field3DF field{a};
+  Field3DF copy = field;
+  copy.allocate();
+  copy(0, 0, 0) = 10.0;
+
+  EXPECT_DOUBLE_EQ(field(0, 0, 0), static_cast<float>(a(0, 0, 0)));
+}
+
+TEST_F(Field3DFloatTest, LazyExpression) {
+  const Field3DF coef{b};
+
+  const Field3D result = lazy(a) * lazy(coef) + 1.0;
+  EXPECT_TRUE(IsFieldEqual(result, a * b + 1.0, "RGN_ALL", tolerance));
+
+  // Only single precision fields
+  const Field3D only_float = 2.0 * lazy(coef);
+  EXPECT_TRUE(IsFieldEqual(only_float, 2.0 * b, "RGN_ALL", tolerance));
+  EXPECT_EQ(only_float.getMesh(), mesh);
+}
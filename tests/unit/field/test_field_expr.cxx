@@ -0,0 +1,113 @@
+#include "gtest/gtest.h"
+
+#include "bout/field_expr.hxx"
+#include "field2d.hxx"
+#include "field3d.hxx"
+#include "test_extras.hxx"
+
+#include <type_traits>
+
+/// Global mesh
+namespace bout {
+namespace globals {
+extern Mesh* mesh;
+} // namespace globals
+} // namespace bout
+
+// The unit tests use the global mesh
+using namespace bout::globals;
+
+using bout::expr::evaluate;
+using bout::expr::lazy;
+
+// Reuse the "standard" fixture for FakeMesh
+class FieldExprTest : public FakeMeshFixture {
+public:
+  FieldExprTest()
+      : FakeMeshFixture(),
+        a(makeField<Field3D>([](Ind3D& i) { return 1.0 + i.ind; }, mesh)),
+        b(makeField<Field3D>([](Ind3D& i) { return 2.0 - 0.5 * i.ind; }, mesh)),
+        c(makeField<Field3D>([](Ind3D& i) { return 0.25 * i.ind * i.ind; }, mesh)),
+        d(makeField<Field2D>([](Ind2D& i) { return 3.0 + i.ind; }, mesh)),
+        e(makeField<Field2D>([](Ind2D& i) { return -1.0 + 2.0 * i.ind; }, mesh)) {}
+
+  Field3D a, b, c;
+  Field2D d, e;
+};
+
+TEST_F(FieldExprTest, ResultType) {
+  using Mixed = decltype(lazy(a) * d);
+  using Only2D = decltype(lazy(d) * e + 1.0);
+  using Only3D = decltype(2.0 * lazy(a) - b);
+
+  EXPECT_TRUE((std::is_same<Mixed::result_type, Field3D>::value));
+  EXPECT_TRUE((std::is_same<Only2D::result_type, Field2D>::value));
+  EXPECT_TRUE((std::is_same<Only3D::result_type, Field3D>::value));
+}
+
+TEST_F(FieldExprTest, Field3DOnly) {
+  Field3D result = lazy(a) * b + lazy(c) * a - lazy(b) / c;
+
+  EXPECT_TRUE(IsFieldEqual(result, a * b + c * a - b / c));
+}
+
+TEST_F(FieldExprTest, Field2DOnly) {
+  Field2D result = lazy(d) * e - d / e;
+
+  EXPECT_TRUE(IsFieldEqual(result, d * e - d / e));
+}
+
+TEST_F(FieldExprTest, Mixed) {
+  Field3D result = lazy(a) * d + e / lazy(b) - lazy(d) * e;
+
+  EXPECT_TRUE(IsFieldEqual(result, a * d + e / b - d * e));
+}
+
+TEST_F(FieldExprTest, BoutReal) {
+  Field3D result = 2.0 * lazy(a) + 3.0 - lazy(b) / 4.0 + 1.0 / lazy(c + 1.0);
+
+  EXPECT_TRUE(IsFieldEqual(result, 2.0 * a + 3.0 - b / 4.0 + 1.0 / (c + 1.0)));
+}
+
+TEST_F(FieldExprTest, UnaryMinus) {
+  Field3D result = -(lazy(a) * d) + b;
+
+  EXPECT_TRUE(IsFieldEqual(result, -(a * d) + b));
+}
+
+TEST_F(FieldExprTest, AssignToExisting) {
+  Field3D result = 1.0;
+  result = lazy(a) * b;
+
+  EXPECT_TRUE(IsFieldEqual(result, a * b));
+
+  // Using the target field in the expression is safe, as each point
+  // only depends on the same point of its operands
+  const Field3D expected = a * a + c;
+  a = lazy(a) * a + c;
+
+  EXPECT_TRUE(IsFieldEqual(a, expected));
+}
+
+TEST_F(FieldExprTest, Field2DIntoField3D) {
+  Field3D result;
+  result = lazy(d) + e;
+
+  EXPECT_TRUE(IsFieldEqual(result, Field3D{d + e}));
+}
+
+TEST_F(FieldExprTest, Evaluate) {
+  const auto result = evaluate(lazy(a) * d);
+
+  EXPECT_TRUE((std::is_same<std::remove_const<decltype(result)>::type, Field3D>::value));
+  EXPECT_TRUE(IsFieldEqual(result, a * d));
+  EXPECT_TRUE(IsFieldEqual((lazy(a) + b).eval(), a + b));
+}
+
+TEST_F(FieldExprTest, Metadata) {
+  Field3D result = lazy(a) * 2.0;
+
+  EXPECT_EQ(result.getMesh(), a.getMesh());
+  EXPECT_EQ(result.getLocation(), a.getLocation());
+  EXPECT_TRUE(areDirectionsCompatible(result.getDirections(), a.getDirections()));
+}
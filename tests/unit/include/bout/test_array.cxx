@@ -3,6 +3,9 @@
 #include "bout/array.hxx"
 #include "boutexception.hxx"
 
+#include <algorithm>
+#include <complex>
+#include <cstdint>
 #include <iostream>
 #include <numeric>
 
@@ -25,6 +28,14 @@ TEST_F(ArrayTest, ArraySize) {
   EXPECT_TRUE(a.unique());
 }
 
+TEST_F(ArrayTest, Aligned) {
+  for (int len : {1, 3, 17, 1000}) {
+    Array<double> a(len);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(a.begin()) % ArrayData<double>::alignment,
+              0);
+  }
+}
+
 TEST_F(ArrayTest, ArrayValues) {
   Array<double> a(10);
 
@@ -227,6 +238,139 @@ TEST_F(ArrayTest, RetrieveData) {
   EXPECT_TRUE(a.unique());
 }
 
+TEST_F(ArrayTest, FirstTouch) {
+  Array<double>::setFirstTouch(true);
+  EXPECT_TRUE(Array<double>::firstTouch());
+
+  // Spans several region-sized blocks, including a partial one
+  const int len = 3 * MAXREGIONBLOCKSIZE + 5;
+  Array<double> a(len);
+
+  EXPECT_TRUE(std::all_of(a.begin(), a.end(), [](double x) { return x == 0.0; }));
+
+  std::iota(a.begin(), a.end(), 0);
+  a.clear();
+
+  // Blocks from the store are not touched again
+  a = Array<double>(len);
+  EXPECT_EQ(a[len - 1], len - 1);
+
+  Array<double>::setFirstTouch(false);
+  EXPECT_FALSE(Array<double>::firstTouch());
+}
+
+TEST_F(ArrayTest, FirstTouchComplex) {
+  // Elements are constructed by the threads which touch them
+  using Complex = std::complex<double>;
+  Array<Complex>::setFirstTouch(true);
+
+  const int len = 2 * MAXREGIONBLOCKSIZE + 7;
+  Array<Complex> a(len);
+
+  EXPECT_TRUE(std::all_of(a.begin(), a.end(), [](Complex x) { return x == 0.0; }));
+
+  Array<Complex>::setFirstTouch(false);
+}
+
+TEST_F(ArrayTest, StoreStatistics) {
+  const int len = 41;
+  const auto allocated = Array<double>::allocatedBytes();
+
+  Array<double> a(len);
+  Array<double> b(len);
+
+  EXPECT_EQ(Array<double>::allocatedBytes(), allocated + 2 * len * sizeof(double));
+  EXPECT_GE(Array<double>::peakAllocatedBytes(), Array<double>::allocatedBytes());
+
+  a.clear();
+  b = Array<double>(len); // Releases one block, then reuses it
+
+  const auto stats = Array<double>::storeStatistics();
+  ASSERT_FALSE(stats.empty());
+  const auto& size_stats = stats[0].at(len);
+
+  EXPECT_EQ(size_stats.misses, 2);
+  EXPECT_EQ(size_stats.hits, 1);
+  EXPECT_EQ(size_stats.cached, 1);
+  EXPECT_EQ(size_stats.freed, 0);
+}
+
+TEST_F(ArrayTest, StoreLimit) {
+  const int len = 43;
+  const auto limit = Array<double>::storeLimit();
+
+  Array<double> a(len);
+  Array<double> b(len);
+
+  // Only room for one more block in the store
+  Array<double>::setStoreLimit(Array<double>::cachedBytes() + len * sizeof(double));
+  const auto allocated = Array<double>::allocatedBytes();
+
+  a.clear();
+  b.clear();
+
+  EXPECT_EQ(Array<double>::allocatedBytes(), allocated - len * sizeof(double));
+  const auto& size_stats = Array<double>::storeStatistics()[0].at(len);
+  EXPECT_EQ(size_stats.cached, 1);
+  EXPECT_EQ(size_stats.freed, 1);
+
+  Array<double>::setStoreLimit(limit);
+}
+
+TEST_F(ArrayTest, TrimStore) {
+  const int len = 47;
+
+  Array<double> a(len);
+  Array<double> b(len);
+  a.clear();
+
+  const auto cached = Array<double>::cachedBytes();
+  const auto allocated = Array<double>::allocatedBytes();
+  ASSERT_GE(cached, len * sizeof(double));
+
+  EXPECT_EQ(Array<double>::trimStore(), cached);
+  EXPECT_EQ(Array<double>::cachedBytes(), 0);
+  EXPECT_EQ(Array<double>::allocatedBytes(), allocated - cached);
+  EXPECT_EQ(Array<double>::storeStatistics()[0].at(len).cached, 0);
+
+  // Blocks still in use are not affected
+  EXPECT_EQ(b.size(), len);
+  EXPECT_TRUE(b.unique());
+}
+
+TEST_F(ArrayTest, StoreLimitNotExceeded) {
+  const int len = 51;
+  const auto limit = Array<double>::storeLimit();
+
+  // Room for exactly two more blocks, released from several threads
+  Array<double>::setStoreLimit(Array<double>::cachedBytes() + 2 * len * sizeof(double));
+  const auto max_cached = Array<double>::storeLimit();
+
+  BOUT_OMP(parallel for)
+  for (int i = 0; i < 8; ++i) {
+    Array<double> a(len);
+    a.clear();
+  }
+
+  EXPECT_LE(Array<double>::cachedBytes(), max_cached);
+
+  Array<double>::setStoreLimit(limit);
+}
+
+TEST_F(ArrayTest, ReleaseAfterCleanup) {
+  // Uses a type not used elsewhere, as cleanup() disables the store
+  Array<short> a(53);
+  const auto allocated = Array<short>::allocatedBytes();
+  const auto frees = Array<short>::unstoredFrees();
+
+  Array<short>::cleanup();
+  a.clear();
+
+  EXPECT_EQ(Array<short>::allocatedBytes(), allocated - 53 * sizeof(short));
+  EXPECT_EQ(Array<short>::unstoredFrees(), frees + 1);
+  EXPECT_EQ(Array<short>::cachedBytes(), 0);
+}
+
 TEST_F(ArrayTest, Assignment) {
   Array<double> a(35);
   Array<double> b(35);
@@ -14,12 +14,12 @@ using standardType = DerivativeStore<FieldType>::standardFunc;
 using flowType = DerivativeStore<FieldType>::upwindFunc;
 
 void standardReturnTenSetToOne(const FieldType& UNUSED(inp), FieldType& out,
-                               const std::string& = "RGN_ALL") {
+                               RegionID = RegionID::fromName("RGN_ALL")) {
   out.resize(10, 1.0);
 }
 
 void flowReturnSixSetToTwo(const FieldType& UNUSED(vel), const FieldType& UNUSED(inp),
-                           FieldType& out, const std::string& = "RGN_ALL") {
+                           FieldType& out, RegionID = RegionID::fromName("RGN_ALL")) {
   out.resize(6, 2.0);
 }
 
@@ -250,7 +250,7 @@ TEST_F(DerivativeStoreTest, RegisterStandardAndGetBack) {
   standardReturnTenSetToOne({}, outOrig);
 
   FieldType outRet;
-  returned(inOrig, outRet, "RGN_ALL");
+  returned(inOrig, outRet, RegionID::fromName("RGN_ALL"));
 
   EXPECT_EQ(outOrig.size(), 10);
   ASSERT_EQ(outRet.size(), outOrig.size());
@@ -278,7 +278,7 @@ TEST_F(DerivativeStoreTest, RegisterFlowAndGetBack) {
   flowReturnSixSetToTwo(inOrig, inOrig, outOrig);
 
   FieldType outRet;
-  returned(inOrig, inOrig, outRet, "RGN_ALL");
+  returned(inOrig, inOrig, outRet, RegionID::fromName("RGN_ALL"));
 
   EXPECT_EQ(outOrig.size(), 6);
   ASSERT_EQ(outRet.size(), outOrig.size());
@@ -332,3 +332,43 @@ TEST_F(DerivativeStoreTest, GetStandardFromFlowDerivative) {
       store.getFlowDerivative("bad type", DIRECTION::X, STAGGER::None, DERIV::Standard),
       BoutException);
 }
+
+TEST_F(DerivativeStoreTest, GetDefaultStandardDerivative) {
+  store.forceDefaultMethod("FIRST", DERIV::Standard, DIRECTION::X);
+
+  // Nothing registered for the default method yet
+  EXPECT_THROW(store.getStandardDerivative("DEFAULT", DIRECTION::X), BoutException);
+
+  store.registerDerivative(standardReturnTenSetToOne, DERIV::Standard, DIRECTION::X,
+                           STAGGER::None, "FIRST");
+  store.registerDerivative(standardType{}, DERIV::Standard, DIRECTION::X, STAGGER::None,
+                           "SECOND");
+
+  FieldType out;
+  store.getStandardDerivative("DEFAULT", DIRECTION::X)({}, out,
+                                                       RegionID::fromName("RGN_ALL"));
+  EXPECT_EQ(out.size(), 10);
+
+  // Changing the default method changes the function returned
+  store.forceDefaultMethod("second", DERIV::Standard, DIRECTION::X);
+  EXPECT_EQ(&store.getStandardDerivative("DEFAULT", DIRECTION::X),
+            &store.getStandardDerivative("SECOND", DIRECTION::X));
+
+  // Clearing the store also forgets the default methods
+  store.clear();
+  EXPECT_ANY_THROW(store.getStandardDerivative("DEFAULT", DIRECTION::X));
+}
+
+TEST_F(DerivativeStoreTest, GetDefaultFlowDerivative) {
+  store.forceDefaultMethod("FIRST", DERIV::Upwind, DIRECTION::Z, STAGGER::C2L);
+  store.registerDerivative(flowReturnSixSetToTwo, DERIV::Upwind, DIRECTION::Z,
+                           STAGGER::C2L, "FIRST");
+
+  EXPECT_EQ(&store.getUpwindDerivative("DEFAULT", DIRECTION::Z, STAGGER::C2L),
+            &store.getUpwindDerivative("FIRST", DIRECTION::Z, STAGGER::C2L));
+  EXPECT_THROW(store.getFluxDerivative("DEFAULT", DIRECTION::Z, STAGGER::C2L),
+               BoutException);
+  EXPECT_THROW(store.getStandardDerivative("DEFAULT", DIRECTION::Z, STAGGER::C2L,
+                                           DERIV::Upwind),
+               BoutException);
+}
@@ -0,0 +1,122 @@
+#include "gtest/gtest.h"
+
+#include "bout/index_derivs.hxx"
+#include "field3d.hxx"
+#include "test_extras.hxx"
+
+/// Global mesh
+namespace bout {
+namespace globals {
+extern Mesh* mesh;
+} // namespace globals
+} // namespace bout
+
+// The unit tests use the global mesh
+using namespace bout::globals;
+
+namespace {
+/// A "derivative" that depends on every point of the stencil
+/// differently, so that any mix-up in the stencil shows up
+struct WeightedSum {
+  BoutReal operator()(const stencil& f) const {
+    return f.mm + 2. * f.m + 4. * f.c + 8. * f.p + 16. * f.pp;
+  }
+  BoutReal operator()(BoutReal vc, const stencil& f) const { return vc * (*this)(f); }
+  BoutReal operator()(const stencil& v, const stencil& f) const {
+    return (*this)(v) - 3. * (*this)(f);
+  }
+  const metaData meta = {"WEIGHTEDSUM", 2, DERIV::Standard};
+};
+
+struct WeightedSumUpwind : public WeightedSum {
+  const metaData meta = {"WEIGHTEDSUM", 2, DERIV::Upwind};
+};
+
+struct WeightedSumFlux : public WeightedSum {
+  const metaData meta = {"WEIGHTEDSUM", 2, DERIV::Flux};
+};
+
+/// The expected result, always going through populateStencil
+template <STAGGER stagger>
+Field3D expectedStandard(const Field3D& f, const Region<Ind3D>& region) {
+  Field3D result{0.0};
+  BOUT_FOR_SERIAL(i, region) {
+    result[i] = WeightedSum{}(populateStencil<DIRECTION::Z, stagger, 2>(f, i));
+  }
+  return result;
+}
+} // namespace
+
+class IndexDerivsPeriodicZTest : public FakeMeshFixture {
+public:
+  IndexDerivsPeriodicZTest()
+      : FakeMeshFixture(),
+        f(makeField<Field3D>([](Ind3D& i) { return std::sin(1.0 + i.ind); }, mesh)),
+        v(makeField<Field3D>([](Ind3D& i) { return std::cos(2.0 * i.ind); }, mesh)) {
+    // A region that starts and stops in the middle of Z lines
+    if (not mesh->hasRegion3D("RGN_PARTIAL_Z")) {
+      std::vector<Ind3D> indices;
+      for (int i = 3; i < mesh->LocalNx * mesh->LocalNy * mesh->LocalNz - 4; i += 2) {
+        indices.emplace_back(i, mesh->LocalNy, mesh->LocalNz);
+      }
+      mesh->addRegion3D("RGN_PARTIAL_Z", Region<Ind3D>(indices));
+    }
+  }
+
+  Field3D f, v;
+};
+
+TEST_F(IndexDerivsPeriodicZTest, Standard) {
+  for (const auto& name : {"RGN_ALL", "RGN_NOBNDRY", "RGN_PARTIAL_Z"}) {
+    const auto region = Mesh::getRegionID(name);
+    const DerivativeType<WeightedSum> deriv{};
+
+    Field3D result{0.0};
+    deriv.standard<DIRECTION::Z, STAGGER::None, 2>(f, result, region);
+    EXPECT_TRUE(IsFieldEqual(result, expectedStandard<STAGGER::None>(
+                                         f, mesh->getRegion3D(region))))
+        << "in region " << name;
+
+    result = 0.0;
+    deriv.standard<DIRECTION::Z, STAGGER::C2L, 2>(f, result, region);
+    EXPECT_TRUE(IsFieldEqual(result, expectedStandard<STAGGER::C2L>(
+                                         f, mesh->getRegion3D(region))))
+        << "in region " << name;
+
+    result = 0.0;
+    deriv.standard<DIRECTION::Z, STAGGER::L2C, 2>(f, result, region);
+    EXPECT_TRUE(IsFieldEqual(result, expectedStandard<STAGGER::L2C>(
+                                         f, mesh->getRegion3D(region))))
+        << "in region " << name;
+  }
+}
+
+TEST_F(IndexDerivsPeriodicZTest, Upwind) {
+  const auto region = Mesh::getRegionID("RGN_PARTIAL_Z");
+  const DerivativeType<WeightedSumUpwind> deriv{};
+
+  Field3D expected{0.0};
+  BOUT_FOR_SERIAL(i, mesh->getRegion3D(region)) {
+    expected[i] =
+        WeightedSum{}(v[i], populateStencil<DIRECTION::Z, STAGGER::None, 2>(f, i));
+  }
+
+  Field3D result{0.0};
+  deriv.upwindOrFlux<DIRECTION::Z, STAGGER::None, 2>(v, f, result, region);
+  EXPECT_TRUE(IsFieldEqual(result, expected));
+}
+
+TEST_F(IndexDerivsPeriodicZTest, Flux) {
+  const auto region = Mesh::getRegionID("RGN_PARTIAL_Z");
+  const DerivativeType<WeightedSumFlux> deriv{};
+
+  Field3D expected{0.0};
+  BOUT_FOR_SERIAL(i, mesh->getRegion3D(region)) {
+    expected[i] = WeightedSum{}(populateStencil<DIRECTION::Z, STAGGER::C2L, 2>(v, i),
+                                populateStencil<DIRECTION::Z, STAGGER::None, 2>(f, i));
+  }
+
+  Field3D result{0.0};
+  deriv.upwindOrFlux<DIRECTION::Z, STAGGER::C2L, 2>(v, f, result, region);
+  EXPECT_TRUE(IsFieldEqual(result, expected));
+}
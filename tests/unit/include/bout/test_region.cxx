@@ -170,6 +170,81 @@ TEST_F(RegionTest, contiguousBlockSize) {
   }
 }
 
+TEST_F(RegionTest, boxRegion) {
+  Region<Ind3D> region(1, 2, 1, 3, 2, 5, mesh->LocalNy, mesh->LocalNz);
+
+  EXPECT_TRUE(region.isBox());
+  EXPECT_EQ(region.size(), 2 * 3 * 4);
+  EXPECT_EQ(region.getBox().ystart, 1);
+  EXPECT_EQ(region.getBox().zend, 5);
+
+  // Blocks should be the same as for the explicit indices
+  auto indices = region.getIndices();
+  EXPECT_EQ(indices.size(), region.size());
+  Region<Ind3D> explicitRegion(indices);
+  EXPECT_FALSE(explicitRegion.isBox());
+
+  const auto& blocks = region.getBlocks();
+  const auto& explicitBlocks = explicitRegion.getBlocks();
+  ASSERT_EQ(blocks.size(), explicitBlocks.size());
+  for (unsigned int i = 0; i < blocks.size(); ++i) {
+    EXPECT_EQ(blocks[i].first, explicitBlocks[i].first);
+    EXPECT_EQ(blocks[i].second, explicitBlocks[i].second);
+  }
+}
+
+TEST_F(RegionTest, boxRegionBlocks) {
+  // Contiguous across y and x, with a small block size so that
+  // blocks are split within rows
+  for (const int maxBlockSize : {1, 3, 5, 64, 1000}) {
+    Region<Ind3D> region(0, mesh->LocalNx - 1, 1, mesh->LocalNy - 1, 0,
+                         mesh->LocalNz - 1, mesh->LocalNy, mesh->LocalNz, maxBlockSize);
+    auto indices = region.getIndices();
+    Region<Ind3D> explicitRegion(indices, maxBlockSize);
+
+    const auto& blocks = region.getBlocks();
+    const auto& explicitBlocks = explicitRegion.getBlocks();
+    ASSERT_EQ(blocks.size(), explicitBlocks.size());
+    for (unsigned int i = 0; i < blocks.size(); ++i) {
+      EXPECT_EQ(blocks[i].first, explicitBlocks[i].first);
+      EXPECT_EQ(blocks[i].second, explicitBlocks[i].second);
+    }
+  }
+}
+
+TEST_F(RegionTest, boxRegionCopy) {
+  Region<Ind3D> region(0, 1, 0, 1, 0, 1, mesh->LocalNy, mesh->LocalNz);
+  const Region<Ind3D> copy = region;
+
+  EXPECT_TRUE(copy.isBox());
+  // Copies share the indices of a box region
+  EXPECT_EQ(&region.getIndices(), &copy.getIndices());
+
+  // Changing the region makes it explicit, and doesn't affect the copy
+  region.offset(1);
+  EXPECT_FALSE(region.isBox());
+  EXPECT_TRUE(copy.isBox());
+  EXPECT_EQ(copy.getIndices()[0].ind, 0);
+  EXPECT_EQ(region.getIndices()[0].ind, 1);
+
+  // Non-const iteration may change the indices
+  Region<Ind3D> region2 = copy;
+  for (auto& i : region2) {
+    i = i + 2;
+  }
+  EXPECT_FALSE(region2.isBox());
+  EXPECT_EQ(copy.getIndices()[0].ind, 0);
+}
+
+TEST_F(RegionTest, boxRegionEmpty) {
+  Region<Ind3D> region(0, -1, 0, 0, 0, 0, 1, 1);
+
+  EXPECT_TRUE(region.isBox());
+  EXPECT_EQ(region.size(), 0);
+  EXPECT_TRUE(region.getBlocks().empty());
+  EXPECT_TRUE(region.getIndices().empty());
+}
+
 TEST_F(RegionTest, defaultRegions) {
   const int nmesh = RegionTest::nx * RegionTest::ny * RegionTest::nz;
   EXPECT_EQ(mesh->getRegion("RGN_ALL").getIndices().size(), nmesh);
@@ -107,3 +107,42 @@ TEST(CyclicReduction, SerialSolveDoubleMatrix) {
   EXPECT_NEAR(x(1, 3), 0.8, CyclicReduceTolerance);
   EXPECT_NEAR(x(1, 4), 6.6, CyclicReduceTolerance);
 }
+
+TEST(CyclicReduction, SerialStartFinishInFlight) {
+  using namespace bout::testing;
+  CyclicReduce<BoutReal> first{BoutComm::get(), reduction_size};
+  CyclicReduce<BoutReal> second{BoutComm::get(), reduction_size};
+
+  first.setCoefs(makeMatrixFromVector({{0., 1., 1., 1., 1.}}),
+                 makeMatrixFromVector({{5., 4., 3., 2., 1.}}),
+                 makeMatrixFromVector({{2., 2., 2., 2., 0.}}));
+  second.setCoefs(makeMatrixFromVector({{0., -2., -2., -2., -2.}}),
+                  makeMatrixFromVector({{1., 1., 1., 1., 1.}}),
+                  makeMatrixFromVector({{2., 2., 2., 2., 0.}}));
+
+  Matrix<BoutReal> x_first{1, reduction_size};
+  Matrix<BoutReal> x_second{1, reduction_size};
+
+  // Both solves in flight at once
+  first.start(makeMatrixFromVector({{0., 1., 2., 2., 3.}}));
+  second.start(makeMatrixFromVector({{5., 4., 5., 4., 5.}}));
+
+  EXPECT_THROW(first.start(makeMatrixFromVector({{0., 1., 2., 2., 3.}})),
+               BoutException);
+
+  first.finish(x_first);
+  second.finish(x_second);
+
+  EXPECT_THROW(first.finish(x_first), BoutException);
+
+  EXPECT_NEAR(x_first(0, 0), -1., CyclicReduceTolerance);
+  EXPECT_NEAR(x_first(0, 1), 2.5, CyclicReduceTolerance);
+  EXPECT_NEAR(x_first(0, 2), -4., CyclicReduceTolerance);
+  EXPECT_NEAR(x_first(0, 3), 5.75, CyclicReduceTolerance);
+  EXPECT_NEAR(x_first(0, 4), -2.75, CyclicReduceTolerance);
+  EXPECT_NEAR(x_second(0, 0), 3.4, CyclicReduceTolerance);
+  EXPECT_NEAR(x_second(0, 1), 0.8, CyclicReduceTolerance);
+  EXPECT_NEAR(x_second(0, 2), 5., CyclicReduceTolerance);
+  EXPECT_NEAR(x_second(0, 3), 0.8, CyclicReduceTolerance);
+  EXPECT_NEAR(x_second(0, 4), 6.6, CyclicReduceTolerance);
+}
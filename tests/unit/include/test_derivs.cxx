@@ -278,7 +278,7 @@ TEST_P(DerivativesTest, Sanity) {
 
   Field3D result{mesh};
   result.allocate();
-  derivative(input, result, region);
+  derivative(input, result, RegionID::fromName(region));
 
   EXPECT_TRUE(IsFieldEqual(result, expected, "RGN_NOBNDRY", derivatives_tolerance));
 }
@@ -292,7 +292,7 @@ TEST_P(DerivativesTestAdvection, Sanity) {
 
   Field3D result{mesh};
   result.allocate();
-  derivative(velocity, input, result, region);
+  derivative(velocity, input, result, RegionID::fromName(region));
 
   EXPECT_TRUE(
       IsFieldEqual(result, expected, "RGN_NOBNDRY", derivatives_tolerance));
@@ -2,11 +2,14 @@
 
 #include "dcomplex.hxx"
 #include "fft.hxx"
+#include "options.hxx"
 #include "test_extras.hxx"
 #include "bout/array.hxx"
 #include "bout/constants.hxx"
 
 #include <algorithm>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
 #include <numeric>
 
@@ -109,4 +112,122 @@ TEST_P(FFTTest, RoundTrip) {
     EXPECT_NEAR(output[i], real_signal[i], FFTTolerance);
   }
 }
+
+TEST_P(FFTTest, rfftBatched) {
+  constexpr int howmany = 3;
+  // Pad each signal to check the stride is respected
+  const int stride = size + 2;
+
+  Array<BoutReal> input{howmany * stride};
+  for (int j = 0; j < howmany; ++j) {
+    for (int i = 0; i < stride; ++i) {
+      input[j * stride + i] = (i < size) ? (j + 1) * real_signal[i] : -1.0;
+    }
+  }
+
+  Array<dcomplex> output{howmany * nmodes};
+
+  rfft(input.begin(), size, howmany, stride, output.begin());
+
+  for (int j = 0; j < howmany; ++j) {
+    for (int i = 0; i < nmodes; ++i) {
+      EXPECT_NEAR(real(output[j * nmodes + i]), (j + 1) * real(fft_signal[i]),
+                  FFTTolerance);
+      EXPECT_NEAR(imag(output[j * nmodes + i]), (j + 1) * imag(fft_signal[i]),
+                  FFTTolerance);
+    }
+  }
+}
+
+TEST_P(FFTTest, irfftBatched) {
+  constexpr int howmany = 3;
+  const int stride = size + 2;
+
+  Array<dcomplex> input{howmany * nmodes};
+  for (int j = 0; j < howmany; ++j) {
+    for (int i = 0; i < nmodes; ++i) {
+      input[j * nmodes + i] = static_cast<BoutReal>(j + 1) * fft_signal[i];
+    }
+  }
+
+  Array<BoutReal> output{howmany * stride};
+  std::fill(output.begin(), output.end(), -1.0);
+
+  irfft(input.begin(), size, howmany, stride, output.begin());
+
+  for (int j = 0; j < howmany; ++j) {
+    for (int i = 0; i < size; ++i) {
+      EXPECT_NEAR(output[j * stride + i], (j + 1) * real_signal[i], FFTTolerance);
+    }
+    // Padding should be untouched
+    for (int i = size; i < stride; ++i) {
+      EXPECT_DOUBLE_EQ(output[j * stride + i], -1.0);
+    }
+  }
+}
+
+TEST_P(FFTTest, rfftAlternatingLengths) {
+
+  // Interleave transforms of a different length, which shouldn't
+  // disturb the cached plans for this one
+  const int other_size = size + 3;
+  Array<BoutReal> other_signal{other_size};
+  std::fill(other_signal.begin(), other_signal.end(), 1.0);
+  Array<dcomplex> other_output{(other_size / 2) + 1};
+
+  Array<dcomplex> output{nmodes};
+
+  for (int repeat = 0; repeat < 3; ++repeat) {
+    rfft(other_signal.begin(), other_size, other_output.begin());
+    EXPECT_NEAR(real(other_output[0]), 1.0, FFTTolerance);
+
+    rfft(real_signal.begin(), size, output.begin());
+    for (int i = 0; i < nmodes; ++i) {
+      EXPECT_NEAR(real(output[i]), real(fft_signal[i]), FFTTolerance);
+      EXPECT_NEAR(imag(output[i]), imag(fft_signal[i]), FFTTolerance);
+    }
+  }
+}
+
+TEST(FFTWisdomTest, SaveAndLoad) {
+  WithQuietOutput quiet_info{output_info};
+  WithQuietOutput quiet_warn{output_warn};
+
+  // A fixed name in the directory the tests are run from, which only
+  // this test uses
+  const std::string filename{"test_fft_wisdom.tmp"};
+  std::remove(filename.c_str());
+  Options options;
+  options["wisdom_file"] = filename;
+
+  // The file doesn't exist yet, which isn't an error
+  EXPECT_FALSE(bout::fft::fft_load_wisdom(&options));
+
+  // Nothing has been measured, so there is nothing to save
+  EXPECT_FALSE(bout::fft::fft_save_wisdom());
+
+  // Measure a new plan
+  bout::fft::fft_cleanup();
+  bout::fft::fft_init(true);
+  Array<BoutReal> signal{37};
+  std::fill(signal.begin(), signal.end(), 1.0);
+  Array<dcomplex> output{(37 / 2) + 1};
+  rfft(signal.begin(), 37, output.begin());
+  bout::fft::fft_init(false);
+
+  EXPECT_TRUE(bout::fft::fft_save_wisdom());
+  EXPECT_TRUE(std::ifstream(filename).good());
+
+  // The saved wisdom can be read back in
+  EXPECT_TRUE(bout::fft::fft_load_wisdom(&options));
+
+  // Stop using the file
+  Options no_file;
+  no_file["wisdom_file"] = "";
+  EXPECT_FALSE(bout::fft::fft_load_wisdom(&no_file));
+  EXPECT_FALSE(bout::fft::fft_save_wisdom());
+
+  bout::fft::fft_cleanup();
+  std::remove(filename.c_str());
+}
 #endif
@@ -1,11 +1,19 @@
 #include "gtest/gtest.h"
 
 #include "bout/coordinates.hxx"
+#include "bout/deriv_store.hxx"
+#include "bout/index_derivs_interface.hxx"
 #include "bout/mesh.hxx"
+#include "derivs.hxx"
+#include "invert_laplace.hxx"
 #include "output.hxx"
 
 #include "test_extras.hxx"
 
+#include <string>
+#include <utility>
+#include <vector>
+
 /// Global mesh
 namespace bout {
 namespace globals {
@@ -77,3 +85,123 @@ TEST_F(CoordinatesTest, CalcCovariant) {
   EXPECT_TRUE(IsFieldEqual(coords.g13, 0.0));
   EXPECT_TRUE(IsFieldEqual(coords.g23, 0.0));
 }
+
+/// Restores the default derivative methods which Delp2 looks at, so
+/// that tests can force other methods
+class CoordinatesDelp2Test : public FakeMeshFixture {
+public:
+  CoordinatesDelp2Test() {
+    for (const auto& d : derivs) {
+      saved.push_back(store.getDefaultMethod(d.first, d.second));
+    }
+  }
+  ~CoordinatesDelp2Test() override {
+    for (std::size_t i = 0; i < derivs.size(); ++i) {
+      store.forceDefaultMethod(saved[i], derivs[i].first, derivs[i].second);
+    }
+  }
+
+  DerivativeStore<Field3D>& store{DerivativeStore<Field3D>::getInstance()};
+  const std::vector<std::pair<DERIV, DIRECTION>> derivs{
+      {DERIV::Standard, DIRECTION::X},
+      {DERIV::Standard, DIRECTION::Z},
+      {DERIV::StandardSecond, DIRECTION::X},
+      {DERIV::StandardSecond, DIRECTION::Z}};
+  std::vector<std::string> saved;
+};
+
+TEST_F(CoordinatesDelp2Test, Delp2NonFFT) {
+  // Give all the terms different, non-trivial coefficients
+  test_coords->G1 = makeField<Field2D>([](Ind2D& i) { return 0.5 + 0.1 * i.ind; });
+  test_coords->G3 = makeField<Field2D>([](Ind2D& i) { return -0.3 + 0.2 * i.ind; });
+  test_coords->g11 = makeField<Field2D>([](Ind2D& i) { return 1.5 + 0.01 * i.ind; });
+  test_coords->g33 = makeField<Field2D>([](Ind2D& i) { return 2.0 - 0.03 * i.ind; });
+  test_coords->g13 = makeField<Field2D>([](Ind2D& i) { return 0.25 * i.ind; });
+  test_coords->dx = makeField<Field2D>([](Ind2D& i) { return 0.1 + 0.05 * i.ind; });
+  test_coords->dz = 0.3;
+  test_coords->non_uniform = false;
+
+  const Field3D f = makeField<Field3D>(
+      [](Ind3D& i) { return std::sin(0.3 * i.x() + 0.9 * i.z()) + i.y(); });
+
+  const Field3D expected = test_coords->G1 * DDX(f) + test_coords->G3 * DDZ(f)
+                           + test_coords->g11 * D2DX2(f) + test_coords->g33 * D2DZ2(f)
+                           + 2 * test_coords->g13 * D2DXDZ(f);
+
+  // The single pass version adds the terms up in a different order
+  constexpr BoutReal tolerance = 1e-12;
+
+  EXPECT_TRUE(IsFieldEqual(test_coords->Delp2(f, CELL_DEFAULT, false), expected,
+                           "RGN_NOBNDRY", tolerance));
+
+  // Non-uniform correction
+  test_coords->non_uniform = true;
+  test_coords->d1_dx = makeField<Field2D>([](Ind2D& i) { return 0.7 - 0.1 * i.ind; });
+
+  const Field3D expected_non_uniform = expected + test_coords->g11 * test_coords->d1_dx
+                                                      * bout::derivatives::index::DDX(f)
+                                                      / test_coords->dx;
+
+  EXPECT_TRUE(IsFieldEqual(test_coords->Delp2(f, CELL_DEFAULT, false),
+                           expected_non_uniform, "RGN_NOBNDRY", tolerance));
+
+  // Other methods don't use the single pass version. The methods are
+  // looked up by geometry(), which also recalculates G1 and G3
+  test_coords->non_uniform = false;
+  store.forceDefaultMethod("C4", DERIV::StandardSecond, DIRECTION::Z);
+  {
+    WithQuietOutput quiet_progress{output_progress};
+    test_coords->geometry();
+  }
+  test_coords->G1 = makeField<Field2D>([](Ind2D& i) { return 0.5 + 0.1 * i.ind; });
+  test_coords->G3 = makeField<Field2D>([](Ind2D& i) { return -0.3 + 0.2 * i.ind; });
+
+  const Field3D expected_C4 = test_coords->G1 * DDX(f) + test_coords->G3 * DDZ(f)
+                              + test_coords->g11 * D2DX2(f) + test_coords->g33 * D2DZ2(f)
+                              + 2 * test_coords->g13 * D2DXDZ(f);
+
+  EXPECT_TRUE(IsFieldEqual(test_coords->Delp2(f, CELL_DEFAULT, false), expected_C4,
+                           "RGN_NOBNDRY"));
+  EXPECT_FALSE(IsFieldEqual(expected_C4, expected, "RGN_NOBNDRY"));
+}
+
+TEST_F(CoordinatesTest, Delp2FFT) {
+  // The coefficients come from the default Laplacian, so use a serial solver
+  WithQuietOutput quiet_info{output_info}, quiet_progress{output_progress},
+      quiet_warn{output_warn};
+  Options::root()["laplace"]["type"] = "tri";
+
+  test_coords->G1 = makeField<Field2D>([](Ind2D& i) { return 0.5 + 0.1 * i.ind; });
+  test_coords->G3 = 0.0;
+  test_coords->g11 = makeField<Field2D>([](Ind2D& i) { return 1.5 + 0.01 * i.ind; });
+  test_coords->non_uniform = false;
+
+  // Only the kz = 0 mode, for which the FFT version should match finite differences
+  const Field3D f =
+      makeField<Field3D>([](Ind3D& i) { return std::sin(0.3 * i.x()) + i.y(); });
+
+  const Field3D expected = test_coords->G1 * DDX(f) + test_coords->g11 * D2DX2(f);
+
+  // Round trip through the FFT
+  constexpr BoutReal tolerance = 1e-12;
+
+  const Field3D result = test_coords->Delp2(f);
+  EXPECT_TRUE(IsFieldEqual(result, expected, "RGN_NOX", tolerance));
+
+  // Each slice of the Field3D result matches the FieldPerp version
+  for (int jy = 0; jy < mesh->LocalNy; ++jy) {
+    EXPECT_TRUE(IsFieldEqual(test_coords->Delp2(sliceXZ(f, jy)), sliceXZ(result, jy),
+                             "RGN_NOX"));
+  }
+
+  // Changing the metric and recalculating the geometry updates the coefficients
+  test_coords->g11 = 2.0;
+  test_coords->geometry();
+
+  EXPECT_TRUE(IsFieldEqual(test_coords->Delp2(f),
+                           test_coords->G1 * DDX(f) + 2.0 * D2DX2(f), "RGN_NOX",
+                           tolerance));
+
+  Laplacian::cleanup();
+  Options::cleanup();
+}
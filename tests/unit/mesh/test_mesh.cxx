@@ -54,6 +54,53 @@ TEST_F(MeshTest, GetRegionPerpFromMesh) {
   EXPECT_THROW(localmesh.getRegionPerp("SOME_MADE_UP_REGION_NAME"), BoutException);
 }
 
+TEST_F(MeshTest, GetRegionID) {
+  const auto all = Mesh::getRegionID("RGN_ALL");
+  const auto nobndry = Mesh::getRegionID("RGN_NOBNDRY");
+
+  EXPECT_EQ(all, Mesh::getRegionID("RGN_ALL"));
+  EXPECT_NE(all, nobndry);
+  EXPECT_EQ(all.name(), "RGN_ALL");
+  EXPECT_EQ(nobndry.name(), "RGN_NOBNDRY");
+  EXPECT_EQ(RegionID{}.name(), "<invalid region>");
+}
+
+TEST_F(MeshTest, GetRegionIDAfterNewNames) {
+  const auto all = Mesh::getRegionID("RGN_ALL");
+  const std::string& all_name = all.name();
+
+  // Registering names publishes new snapshots of the registry, which
+  // must not change the existing handles or invalidate their names
+  std::vector<RegionID> new_ids;
+  for (int i = 0; i < 10; i++) {
+    new_ids.push_back(Mesh::getRegionID("RGN_ID_TEST_" + std::to_string(i)));
+  }
+
+  EXPECT_EQ(all, Mesh::getRegionID("RGN_ALL"));
+  EXPECT_EQ(all_name, "RGN_ALL");
+  for (int i = 0; i < 10; i++) {
+    EXPECT_EQ(new_ids[i], Mesh::getRegionID("RGN_ID_TEST_" + std::to_string(i)));
+    EXPECT_EQ(new_ids[i].name(), "RGN_ID_TEST_" + std::to_string(i));
+  }
+}
+
+TEST_F(MeshTest, GetRegionFromMeshByID) {
+  localmesh.createDefaultRegions();
+  const auto all = Mesh::getRegionID("RGN_ALL");
+  const auto nobndry = Mesh::getRegionID("RGN_NOBNDRY");
+
+  EXPECT_EQ(&localmesh.getRegion(all), &localmesh.getRegion("RGN_ALL"));
+  EXPECT_EQ(&localmesh.getRegion3D(nobndry), &localmesh.getRegion3D("RGN_NOBNDRY"));
+  EXPECT_EQ(&localmesh.getRegion2D(all), &localmesh.getRegion2D("RGN_ALL"));
+  EXPECT_EQ(&localmesh.getRegionPerp(nobndry), &localmesh.getRegionPerp("RGN_NOBNDRY"));
+
+  const auto made_up = Mesh::getRegionID("SOME_MADE_UP_REGION_NAME");
+  EXPECT_THROW(localmesh.getRegion3D(made_up), BoutException);
+  EXPECT_THROW(localmesh.getRegion2D(made_up), BoutException);
+  EXPECT_THROW(localmesh.getRegionPerp(made_up), BoutException);
+  EXPECT_THROW(localmesh.getRegion3D(RegionID{}), BoutException);
+}
+
 TEST_F(MeshTest, AddRegionToMesh) {
   Region<Ind3D> junk(0, 0, 0, 0, 0, 0, 1, 1);
   EXPECT_NO_THROW(localmesh.addRegion("RGN_JUNK", junk));
@@ -82,6 +129,38 @@ TEST_F(MeshTest, AddRegionPerpToMesh) {
   EXPECT_THROW(localmesh.addRegionPerp("RGN_JUNK_Perp", junk), BoutException);
 }
 
+TEST_F(MeshTest, InteriorRegions) {
+  // Large enough to have some points away from the guard cells
+  FakeMesh mesh{7, 8, 3};
+  mesh.createDefaultRegions();
+
+  const auto& interior = mesh.getRegion3D("RGN_INTERIOR");
+  const auto& edge = mesh.getRegion3D("RGN_INTERIOR_EDGE");
+
+  EXPECT_EQ(interior.size(), 3u * 4u * 3u);
+  EXPECT_EQ(edge.size(), mesh.getRegion3D("RGN_NOBNDRY").size() - interior.size());
+  EXPECT_EQ((interior + edge).unique().size(), mesh.getRegion3D("RGN_NOBNDRY").size());
+
+  for (const auto& i : interior) {
+    EXPECT_GE(i.x(), 2 * mesh.xstart);
+    EXPECT_LE(i.x(), mesh.xend - mesh.xstart);
+    EXPECT_GE(i.y(), 2 * mesh.ystart);
+    EXPECT_LE(i.y(), mesh.yend - mesh.ystart);
+  }
+
+  EXPECT_EQ(mesh.getRegion2D("RGN_INTERIOR").size(), 3u * 4u);
+  EXPECT_EQ(mesh.getRegion2D("RGN_INTERIOR_EDGE").size(), 5u * 6u - 3u * 4u);
+}
+
+TEST_F(MeshTest, StartFinishCommunicate) {
+  FieldGroup group;
+
+  auto handle = localmesh.startCommunicate(group);
+  EXPECT_TRUE(handle.group.empty());
+  EXPECT_NO_THROW(localmesh.finishCommunicate(handle));
+  EXPECT_EQ(handle.handle, nullptr);
+}
+
 TEST_F(MeshTest, Ind2DTo3D) {
   Ind2D index2d_0(0);
   Ind2D index2d_7(7);
@@ -66,11 +66,20 @@ public:
   // Shims for protected functions
   auto getMaxTimestepShim() const -> BoutReal { return max_dt; }
   auto getLocalNShim() -> int { return getLocalN(); }
+  auto loadVarsShim(BoutReal* udata) -> void { load_vars(udata); }
+  auto loadDerivsShim(BoutReal* udata) -> void { load_derivs(udata); }
+  auto saveVarsShim(BoutReal* udata) -> void { save_vars(udata); }
+  auto saveDerivsShim(BoutReal* dudata) -> void { save_derivs(dudata); }
+  auto setIdShim(BoutReal* udata) -> void { set_id(udata); }
   auto haveUserPreconShim() -> bool { return have_user_precon(); }
   auto runPreconShim(BoutReal t, BoutReal gamma, BoutReal delta) -> int {
     return run_precon(t, gamma, delta);
   }
   auto globalIndexShim(int local_start) -> Field3D { return globalIndex(local_start); }
+  auto jacobianStencilShim() -> JacobianStencil { return jacobianStencil(); }
+  auto jacobianPatternShim(const JacobianStencil& stencil) -> JacobianPattern {
+    return jacobianPattern(stencil);
+  }
   auto getMonitorsShim() const -> const std::list<Monitor*>& { return getMonitors(); }
   auto callMonitorsShim(BoutReal simtime, int iter, int NOUT) -> int {
     return call_monitors(simtime, iter, NOUT);
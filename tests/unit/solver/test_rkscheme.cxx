@@ -0,0 +1,83 @@
+#include "gtest/gtest.h"
+
+#include "test_extras.hxx"
+#include "bout/rkscheme.hxx"
+#include "../src/solver/impls/rkgeneric/rkschemefactory.hxx"
+
+#include <cmath>
+#include <memory>
+
+namespace {
+/// Integrate dy/dt = cos(t) - y, y(0) = 1 from t = 0 to 1 in \p nsteps
+/// fixed steps, driving the scheme the same way RKGenericSolver does,
+/// and return the absolute error at t = 1
+BoutReal integrationError(RKSchemeType type, int nsteps) {
+  WithQuietOutput quiet{output_info};
+
+  Options options;
+  std::unique_ptr<RKScheme> scheme{
+      RKSchemeFactory::getInstance()->createRKScheme(type, &options)};
+  scheme->init(1, 1, false, 1.e-12, 1.e-5, &options);
+
+  Array<BoutReal> start(1), result(1);
+  start[0] = 1.0;
+
+  const BoutReal dt = 1.0 / nsteps;
+  BoutReal time = 0.0;
+  for (int step = 0; step < nsteps; step++) {
+    for (int stage = 0; stage < scheme->getStageCount(); stage++) {
+      BoutReal stage_time = scheme->setCurTime(time, dt, stage);
+      scheme->setCurState(start, result, stage, dt);
+      scheme->getStageDerivs(stage)[0] = std::cos(stage_time) - result[0];
+      scheme->finishStage(result, stage, dt);
+    }
+    scheme->setOutputStates(start, dt, result);
+    swap(start, result);
+    time += dt;
+  }
+
+  const BoutReal exact = 0.5 * (std::cos(1.0) + std::sin(1.0) + std::exp(-1.0));
+  return std::abs(start[0] - exact);
+}
+
+BoutReal convergenceOrder(RKSchemeType type) {
+  return std::log2(integrationError(type, 10) / integrationError(type, 20));
+}
+} // namespace
+
+TEST(RKSchemeTest, RKF34Convergence) {
+  EXPECT_NEAR(convergenceOrder(RKSCHEME_RKF34), 3.0, 0.3);
+}
+
+TEST(RKSchemeTest, RK3LSConvergence) {
+  EXPECT_NEAR(convergenceOrder(RKSCHEME_RK3LS), 3.0, 0.3);
+}
+
+TEST(RKSchemeTest, RK4LSConvergence) {
+  EXPECT_NEAR(convergenceOrder(RKSCHEME_RK4LS), 4.0, 0.3);
+}
+
+TEST(RKSchemeTest, LowStorageRegisters) {
+  WithQuietOutput quiet{output_info};
+
+  Options options;
+  RKSchemeType type = RKSCHEME_RK4LS;
+  std::unique_ptr<RKScheme> scheme{
+      RKSchemeFactory::getInstance()->createRKScheme(type, &options)};
+
+  EXPECT_EQ(scheme->getStageCount(), 5);
+  EXPECT_EQ(scheme->getStorageCount(), 2);
+}
+
+TEST(RKSchemeTest, LowStorageStageTimes) {
+  WithQuietOutput quiet{output_info};
+
+  Options options;
+  RKSchemeType type = RKSCHEME_RK3LS;
+  std::unique_ptr<RKScheme> scheme{
+      RKSchemeFactory::getInstance()->createRKScheme(type, &options)};
+
+  EXPECT_DOUBLE_EQ(scheme->setCurTime(1.0, 1.0, 0), 1.0);
+  EXPECT_DOUBLE_EQ(scheme->setCurTime(1.0, 1.0, 1), 1.0 + 1.0 / 3.0);
+  EXPECT_DOUBLE_EQ(scheme->setCurTime(1.0, 1.0, 2), 1.0 + 3.0 / 4.0);
+}
@@ -9,6 +9,8 @@
 #include "bout/solverfactory.hxx"
 
 #include <algorithm>
+#include <array>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -38,6 +40,33 @@ private:
   BoutReal trigger_time{0.0};
 };
 
+/// Fields evolved by `jacobianRHS`
+Field2D* jacobian_g{nullptr};
+Field3D* jacobian_f{nullptr};
+
+/// A RHS with a known Jacobian stencil
+auto jacobianRHS(BoutReal) -> int {
+  auto& f = *jacobian_f;
+  auto& g = *jacobian_g;
+  const auto* mesh = f.getMesh();
+  const int nz = mesh->LocalNz;
+
+  ddt(f) = 0.0;
+  ddt(g) = 0.0;
+  for (int x = mesh->xstart; x <= mesh->xend; ++x) {
+    for (int y = mesh->ystart; y <= mesh->yend; ++y) {
+      for (int z = 0; z < nz; ++z) {
+        ddt(f)(x, y, z) = f(x - 1, y, z) * f(x, y, (z + 1) % nz) + g(x, y + 1);
+      }
+      ddt(g)(x, y) = g(x + 1, y);
+      for (int z = 0; z < nz; ++z) {
+        ddt(g)(x, y) += f(x, y - 1, z);
+      }
+    }
+  }
+  return 0;
+}
+
 } // namespace
 
 class SolverTest : public FakeMeshFixture {
@@ -574,6 +603,231 @@ TEST_F(SolverTest, GetLocalN) {
   EXPECT_EQ(solver.getLocalNShim(), expected_total);
 }
 
+TEST_F(SolverTest, SaveAndLoadVars) {
+  Options options;
+  FakeSolver solver{&options};
+  auto* mesh = bout::globals::mesh;
+
+  Options::root()["field"]["evolve_bndry"] = true;
+  Options::root()["input"]["transform_from_field_aligned"] = false;
+  static_cast<FakeMesh*>(mesh)->createBoundaryRegions();
+
+  Field2D field1{mesh};
+  Field3D field2{mesh}, field3{mesh}, field3_constraint{mesh};
+
+  solver.add(field1, "field");
+  solver.add(field2, "another_field");
+  solver.constraint(field3, field3_constraint, "constrained_field");
+
+  solver.init(0, 0);
+
+  field1 = makeField<Field2D>([](Ind2D& i) { return i.ind; }, mesh);
+  field2 = makeField<Field3D>([](Ind3D& i) { return 1000. + i.ind; }, mesh);
+  field3 = makeField<Field3D>([](Ind3D& i) { return -1000. - i.ind; }, mesh);
+
+  // Variables are interleaved, and only field1 evolves its boundaries
+  std::vector<BoutReal> expected{};
+  std::vector<BoutReal> expected_id{};
+  for (const auto& i : mesh->getRegion2D("RGN_BNDRY")) {
+    expected.push_back(field1[i]);
+    expected_id.push_back(1.);
+  }
+  for (const auto& i : mesh->getRegion2D("RGN_NOBNDRY")) {
+    expected.push_back(field1[i]);
+    expected_id.push_back(1.);
+    for (int jz = 0; jz < mesh->LocalNz; ++jz) {
+      expected.push_back(field2(i.x(), i.y(), jz));
+      expected.push_back(field3(i.x(), i.y(), jz));
+      expected_id.push_back(1.);
+      expected_id.push_back(0.);
+    }
+  }
+
+  std::vector<BoutReal> udata(expected.size());
+  solver.saveVarsShim(udata.data());
+  EXPECT_EQ(udata, expected);
+
+  solver.setIdShim(udata.data());
+  EXPECT_EQ(udata, expected_id);
+
+  // Loading puts the values back in the same places
+  std::transform(begin(expected), end(expected), begin(udata),
+                 [](BoutReal u) { return 2. * u; });
+  solver.loadVarsShim(udata.data());
+
+  for (const auto& i : mesh->getRegion2D("RGN_ALL")) {
+    EXPECT_EQ(field1[i], 2. * i.ind);
+  }
+  for (const auto& i : mesh->getRegion3D("RGN_NOBNDRY")) {
+    EXPECT_EQ(field2[i], 2. * (1000. + i.ind));
+    EXPECT_EQ(field3[i], 2. * (-1000. - i.ind));
+  }
+  for (const auto& i : mesh->getRegion3D("RGN_BNDRY")) {
+    EXPECT_EQ(field2[i], 1000. + i.ind);
+  }
+
+  // The derivatives go through the same ordering
+  solver.loadDerivsShim(expected.data());
+  solver.saveDerivsShim(udata.data());
+  EXPECT_EQ(udata, expected);
+}
+
+TEST_F(SolverTest, SaveAndLoadVarsFieldMajor) {
+  Options options;
+  options["field_major"] = true;
+  FakeSolver solver{&options};
+  auto* mesh = bout::globals::mesh;
+
+  Options::root()["field"]["evolve_bndry"] = true;
+  Options::root()["input"]["transform_from_field_aligned"] = false;
+  static_cast<FakeMesh*>(mesh)->createBoundaryRegions();
+
+  Field2D field1{mesh};
+  Field3D field2{mesh}, field3{mesh}, field3_constraint{mesh};
+
+  solver.add(field1, "field");
+  solver.add(field2, "another_field");
+  solver.constraint(field3, field3_constraint, "constrained_field");
+
+  solver.init(0, 0);
+
+  field1 = makeField<Field2D>([](Ind2D& i) { return i.ind; }, mesh);
+  field2 = makeField<Field3D>([](Ind3D& i) { return 1000. + i.ind; }, mesh);
+  field3 = makeField<Field3D>([](Ind3D& i) { return -1000. - i.ind; }, mesh);
+
+  // Each variable in turn, and only field1 evolves its boundaries
+  std::vector<BoutReal> expected{};
+  std::vector<BoutReal> expected_id{};
+  for (const auto& name : {"RGN_BNDRY", "RGN_NOBNDRY"}) {
+    for (const auto& i : mesh->getRegion2D(name)) {
+      expected.push_back(field1[i]);
+      expected_id.push_back(1.);
+    }
+  }
+  for (const auto* field : {&field2, &field3}) {
+    for (const auto& i : mesh->getRegion2D("RGN_NOBNDRY")) {
+      for (int jz = 0; jz < mesh->LocalNz; ++jz) {
+        expected.push_back((*field)(i.x(), i.y(), jz));
+        expected_id.push_back(field == &field2 ? 1. : 0.);
+      }
+    }
+  }
+
+  std::vector<BoutReal> udata(expected.size());
+  solver.saveVarsShim(udata.data());
+  EXPECT_EQ(udata, expected);
+
+  solver.setIdShim(udata.data());
+  EXPECT_EQ(udata, expected_id);
+
+  std::transform(begin(expected), end(expected), begin(udata),
+                 [](BoutReal u) { return 2. * u; });
+  solver.loadVarsShim(udata.data());
+
+  for (const auto& i : mesh->getRegion2D("RGN_ALL")) {
+    EXPECT_EQ(field1[i], 2. * i.ind);
+  }
+  for (const auto& i : mesh->getRegion3D("RGN_NOBNDRY")) {
+    EXPECT_EQ(field2[i], 2. * (1000. + i.ind));
+    EXPECT_EQ(field3[i], 2. * (-1000. - i.ind));
+  }
+
+  EXPECT_THROW(solver.globalIndexShim(0), BoutException);
+}
+
+TEST_F(SolverTest, JacobianStencil) {
+  // Needs room for perturbations three points apart
+  delete bout::globals::mesh;
+  bout::globals::mesh = new FakeMesh(9, 7, 4);
+  auto* mesh = static_cast<FakeMesh*>(bout::globals::mesh);
+  mesh->createDefaultRegions();
+  mesh->createBoundaryRegions();
+  mesh->setCoordinates(nullptr);
+  // globalIndex communicates, which needs a ParallelTransform
+  auto coords = std::make_shared<Coordinates>(
+      mesh, Field2D{1.0, mesh}, Field2D{1.0, mesh}, BoutReal{1.0}, Field2D{1.0, mesh},
+      Field2D{0.0, mesh}, Field2D{1.0, mesh}, Field2D{1.0, mesh}, Field2D{1.0, mesh},
+      Field2D{0.0, mesh}, Field2D{0.0, mesh}, Field2D{0.0, mesh}, Field2D{1.0, mesh},
+      Field2D{1.0, mesh}, Field2D{1.0, mesh}, Field2D{0.0, mesh}, Field2D{0.0, mesh},
+      Field2D{0.0, mesh}, Field2D{0.0, mesh}, Field2D{0.0, mesh}, false);
+  coords->setParallelTransform(bout::utils::make_unique<ParallelTransformIdentity>(*mesh));
+  mesh->setCoordinates(coords);
+
+  Options options;
+  // Only the probed offsets
+  options["jacobian_star"] = false;
+  FakeSolver solver{&options};
+  Options::root()["input"]["transform_from_field_aligned"] = false;
+
+  Field2D g{mesh};
+  Field3D f{mesh};
+  solver.add(g, "field");
+  solver.add(f, "another_field");
+  solver.setRHS(jacobianRHS);
+  jacobian_g = &g;
+  jacobian_f = &f;
+
+  solver.init(0, 0);
+
+  g = makeField<Field2D>([](Ind2D& i) { return 1. + i.ind; }, mesh);
+  f = makeField<Field3D>([](Ind3D& i) { return 2. + i.ind; }, mesh);
+  const Field2D g_copy = copy(g);
+  const Field3D f_copy = copy(f);
+
+  const auto stencil = solver.jacobianStencilShim();
+
+  using Offsets = std::set<std::array<int, 3>>;
+  ASSERT_EQ(stencil.size(), 2);
+  EXPECT_EQ(stencil[0][0], (Offsets{{1, 0, 0}}));
+  EXPECT_EQ(stencil[0][1], (Offsets{{0, -1, 0}}));
+  EXPECT_EQ(stencil[1][0], (Offsets{{0, 1, 0}}));
+  EXPECT_EQ(stencil[1][1], (Offsets{{-1, 0, 0}, {0, 0, 1}}));
+
+  // Variables are left unchanged
+  EXPECT_TRUE(IsFieldEqual(g, g_copy, "RGN_NOBNDRY"));
+  EXPECT_TRUE(IsFieldEqual(f, f_copy, "RGN_NOBNDRY"));
+
+  // The star pattern is added to every pair of variables, which
+  // covers couplings that are zero in the probed state
+  options["jacobian_star"] = true;
+  const auto with_star = solver.jacobianStencilShim();
+  const Offsets star2d{{0, 0, 0}, {-1, 0, 0}, {1, 0, 0}, {0, -1, 0}, {0, 1, 0}};
+  const Offsets star3d{{0, 0, 0}, {-1, 0, 0}, {1, 0, 0}, {0, -1, 0},
+                       {0, 1, 0}, {0, 0, 1},  {0, 0, 3}};
+  EXPECT_EQ(with_star[0][0], star2d);
+  EXPECT_EQ(with_star[0][1], star2d);
+  EXPECT_EQ(with_star[1][0], star2d);
+  EXPECT_EQ(with_star[1][1], star3d);
+
+  const auto pattern = solver.jacobianPatternShim(stencil);
+  const Field3D index = solver.globalIndexShim(0);
+  // The 2D field comes first at z = 0
+  const auto row_f = [&](int x, int y, int z) {
+    return static_cast<int>(index(x, y, z)) + (z == 0 ? 1 : 0);
+  };
+  const auto row_g = [&](int x, int y) { return static_cast<int>(index(x, y, 0)); };
+
+  EXPECT_EQ(pattern.first_row, 0);
+
+  auto expected =
+      std::vector<int>{row_f(4, 3, 1), row_f(3, 3, 1), row_f(4, 3, 2), row_g(4, 4)};
+  std::sort(begin(expected), end(expected));
+  EXPECT_EQ(pattern.columns[row_f(4, 3, 1)], expected);
+  EXPECT_EQ(pattern.d_nnz[row_f(4, 3, 1)], 4);
+  EXPECT_EQ(pattern.o_nnz[row_f(4, 3, 1)], 0);
+
+  // The 3D field in 2D equations contributes the whole z column
+  expected = std::vector<int>{row_g(4, 3), row_g(5, 3), row_f(4, 2, 0), row_f(4, 2, 1),
+                              row_f(4, 2, 2), row_f(4, 2, 3)};
+  std::sort(begin(expected), end(expected));
+  EXPECT_EQ(pattern.columns[row_g(4, 3)], expected);
+
+  // Boundary points aren't evolved, so aren't in the pattern
+  expected = std::vector<int>{row_f(1, 3, 1), row_f(1, 3, 2), row_g(1, 4)};
+  std::sort(begin(expected), end(expected));
+  EXPECT_EQ(pattern.columns[row_f(1, 3, 1)], expected);
+}
+
 TEST_F(SolverTest, HavePreconditioner) {
   PhysicsPrecon preconditioner = [](BoutReal time, BoutReal gamma,
                                     BoutReal delta) -> int {
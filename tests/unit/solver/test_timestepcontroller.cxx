@@ -0,0 +1,76 @@
+#include "gtest/gtest.h"
+
+#include "boutexception.hxx"
+#include "options.hxx"
+#include "test_extras.hxx"
+#include "bout/timestepcontroller.hxx"
+
+#include <cmath>
+
+TEST(TimestepControllerTest, IControllerRejected) {
+  WithQuietOutput quiet{output_info};
+
+  Options options;
+  TimestepController controller{&options, 4, 1.e-3, 0.9};
+
+  EXPECT_FALSE(controller.accept(2.e-3));
+  EXPECT_DOUBLE_EQ(controller.nextTimestep(1.0, 2.e-3), 0.9 * std::pow(0.25, 0.2));
+}
+
+TEST(TimestepControllerTest, IControllerDeadband) {
+  WithQuietOutput quiet{output_info};
+
+  Options options;
+  TimestepController controller{&options, 4, 1.e-3};
+
+  EXPECT_TRUE(controller.accept(5.e-4));
+  EXPECT_DOUBLE_EQ(controller.nextTimestep(1.0, 5.e-4), 1.0);
+  EXPECT_DOUBLE_EQ(controller.nextTimestep(1.0, 5.e-5), std::pow(10.0, 0.2));
+}
+
+TEST(TimestepControllerTest, PIControllerHistory) {
+  WithQuietOutput quiet{output_info};
+
+  Options options;
+  options["controller"] = "PI";
+  TimestepController controller{&options, 1, 1.e-3};
+
+  // No history, so only the current error counts
+  EXPECT_DOUBLE_EQ(controller.nextTimestep(1.0, 2.5e-4), std::pow(2.0, 0.8 * 0.5));
+  // The previous error reduces the increase
+  EXPECT_DOUBLE_EQ(controller.nextTimestep(1.0, 2.5e-4),
+                   std::pow(2.0, 0.8 * 0.5) * std::pow(2.0, -0.31 * 0.5));
+
+  controller.reset();
+  EXPECT_DOUBLE_EQ(controller.nextTimestep(1.0, 2.5e-4), std::pow(2.0, 0.8 * 0.5));
+}
+
+TEST(TimestepControllerTest, RejectedStepKeepsHistory) {
+  WithQuietOutput quiet{output_info};
+
+  Options options;
+  options["controller"] = "PID";
+  TimestepController controller{&options, 1, 1.e-3};
+
+  EXPECT_DOUBLE_EQ(controller.nextTimestep(1.0, 2.e-3), std::pow(0.25, 0.5));
+  EXPECT_DOUBLE_EQ(controller.nextTimestep(1.0, 2.5e-4), std::pow(2.0, 0.58 * 0.5));
+}
+
+TEST(TimestepControllerTest, CustomGains) {
+  WithQuietOutput quiet{output_info};
+
+  Options options;
+  options["controller"] = "PI";
+  options["controller_k1"] = 0.5;
+  TimestepController controller{&options, 1, 1.e-3};
+
+  EXPECT_DOUBLE_EQ(controller.nextTimestep(1.0, 2.5e-4), std::pow(2.0, 0.5 * 0.5));
+}
+
+TEST(TimestepControllerTest, UnknownController) {
+  WithQuietOutput quiet{output_info};
+
+  Options options;
+  options["controller"] = "not_a_controller";
+  EXPECT_THROW(TimestepController(&options, 4, 1.e-3), BoutException);
+}
@@ -368,6 +368,39 @@ TEST(BoutInitialiseFunctions, SetRunFinishInfo) {
   EXPECT_TRUE(options["run"].isSet("finished"));
 }
 
+TEST(BoutInitialiseFunctions, SetupArrayStore) {
+  WithQuietOutput quiet{output_info};
+
+  Options options;
+
+  bout::experimental::setupArrayStore(options);
+  EXPECT_FALSE(Array<BoutReal>::firstTouch());
+
+  options["memory"]["first_touch"] = true;
+  bout::experimental::setupArrayStore(options);
+  EXPECT_TRUE(Array<BoutReal>::firstTouch());
+  EXPECT_TRUE(Array<dcomplex>::firstTouch());
+
+  Array<BoutReal>::setFirstTouch(false);
+  Array<dcomplex>::setFirstTouch(false);
+
+  const auto limit = Array<BoutReal>::storeLimit();
+  options["memory"]["store_limit"] = 2;
+  bout::experimental::setupArrayStore(options);
+  EXPECT_EQ(Array<BoutReal>::storeLimit(), 2 * 1024 * 1024);
+  EXPECT_EQ(Array<dcomplex>::storeLimit(), 2 * 1024 * 1024);
+
+  Array<BoutReal>::setStoreLimit(limit);
+  Array<dcomplex>::setStoreLimit(limit);
+}
+
+TEST(BoutInitialiseFunctions, PrintArrayStoreStatistics) {
+  WithQuietOutput quiet{output_info};
+
+  Array<BoutReal> a(13);
+  EXPECT_NO_THROW(bout::experimental::printArrayStoreStatistics());
+}
+
 TEST(BoutInitialiseFunctions, CheckDataDirectoryIsAccessible) {
   using namespace bout::experimental;
   EXPECT_THROW(checkDataDirectoryIsAccessible("./bad/non/existent/directory"),
@@ -285,9 +285,9 @@ public:
   BoutReal GlobalY(int jy) const override { return jy; }
   BoutReal GlobalX(BoutReal jx) const override { return jx; }
   BoutReal GlobalY(BoutReal jy) const override { return jy; }
-  int getGlobalXIndex(int) const override { return 0; }
+  int getGlobalXIndex(int xlocal) const override { return xlocal; }
   int getGlobalXIndexNoBoundaries(int) const override { return 0; }
-  int getGlobalYIndex(int) const override { return 0; }
+  int getGlobalYIndex(int ylocal) const override { return ylocal; }
   int getGlobalYIndexNoBoundaries(int) const override { return 0; }
   int getGlobalZIndex(int) const override { return 0; }
   int getGlobalZIndexNoBoundaries(int) const override { return 0; }